@@ -49,6 +49,8 @@ bool AppConfig::loadFromFile(const QString &filePath)
     QJsonObject obj = doc.object();
     m_homePage = obj.value("home_page").toString();
     m_widgets = obj.value("widgets").toArray();
+    m_vehicle = obj.value("vehicle").toObject();
+    m_outputs = obj.value("outputs").toArray();
     
     m_loaded = true;
     emit configLoaded();
@@ -10,6 +10,8 @@ class AppConfig : public QObject {
     Q_OBJECT
     Q_PROPERTY(QString homePage READ homePage NOTIFY configLoaded)
     Q_PROPERTY(QJsonArray widgets READ widgets NOTIFY configLoaded)
+    Q_PROPERTY(QJsonObject vehicle READ vehicle NOTIFY configLoaded)
+    Q_PROPERTY(QJsonArray outputs READ outputs NOTIFY configLoaded)
     Q_PROPERTY(bool isLoaded READ isLoaded NOTIFY configLoaded)
 
 public:
@@ -18,6 +20,8 @@ public:
     bool loadFromFile(const QString &filePath);
     QString homePage() const { return m_homePage; }
     QJsonArray widgets() const { return m_widgets; }
+    QJsonObject vehicle() const { return m_vehicle; }
+    QJsonArray outputs() const { return m_outputs; }
     bool isLoaded() const { return m_loaded; }
 
 signals:
@@ -26,6 +30,8 @@ signals:
 private:
     QString m_homePage;
     QJsonArray m_widgets;
+    QJsonObject m_vehicle;
+    QJsonArray m_outputs;
     bool m_loaded;
 };
 
@@ -1,18 +1,29 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QCoreApplication>
 #include <QUrl>
 #include <QDir>
 #include <QDirIterator>
 #include <QDebug>
 #include <QStandardPaths>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <memory>
 
 #include "AppConfig.h"
+#include "src/dashboardqml.h"
 #include "src/waydroidmanager.h"
-#include "src/windowembeditem.h"
-#include "src/xdgshellhelper.h"
-// 注意：不再使用自定義的 waylandcompositor.h 和 surfaceitem.h
+#include "src/vehiclesignalhub.h"
+#include "src/caningestworker.h"
+#include "src/telemetryrecorder.h"
+#include "src/telemetryreplay.h"
+#include "src/sharedsignalsource.h"
+#include "src/datagramingestworker.h"
+#include "src/framestats.h"
+// 注意：不再使用自定義的 waylandcompositor.h
 // 直接使用 QtWayland.Compositor 的 QML WaylandCompositor
 
 static void dumpQmlResources()
@@ -90,6 +101,14 @@ int main(int argc, char *argv[])
         }
     }
     
+    // 無 GPU 的儀表硬體（SMART_DASHBOARD_SOFTWARE_CLUSTER=1）：software scene graph 只重畫並 flush
+    // 這一幀有變動的節點區域；每幀重畫面積統計見 FrameStats.repaint*
+    const bool softwareCluster = qEnvironmentVariableIntValue("SMART_DASHBOARD_SOFTWARE_CLUSTER") != 0;
+    if (softwareCluster) {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+        qDebug() << "Software cluster 模式：software scene graph，只重畫變動區域";
+    }
+
     QGuiApplication app(argc, argv);
 
     // 1) 載入設定（先從 qrc，再依序嘗試 bundle/當前目錄）
@@ -125,20 +144,72 @@ CONFIG_DONE:;
 
     // 2) 建立 QML engine 與 Context
     QQmlApplicationEngine engine;
-    engine.rootContext()->setContextProperty("AppConfig", &config);
 
     WaydroidManager waydroid;
-    engine.rootContext()->setContextProperty("Waydroid", &waydroid);
-    
-    // 暴露 compositor 模式狀態到 QML
-    engine.rootContext()->setContextProperty("CompositorModeEnabled", useCompositorMode);
-    
-    // 註冊 QML 類型
-    qmlRegisterType<WindowEmbedItem>("SmartDashboard", 1, 0, "WindowEmbedItem");
+
+    // 錄製器要比 hub 與擷取 / 重播 worker 晚解構：worker 結束前仍可能經由 hub 寫入
+    TelemetryRecorder recorder;
+
+    // 車輛訊號匯流中心：擷取執行緒寫入，GUI 執行緒每幀合併後更新儀表
+    VehicleSignalHub vehicleSignals;
+
+    // 幀計時：sync / render / frame 直方圖，kill -USR1 <pid> 輸出 JSON
+    FrameStats frameStats;
+    frameStats.installDumpSignalHandler();
+    // 第二個 output（中控螢幕）有自己的視窗與 render 執行緒，幀計時分開統計；視窗由 DashboardShell 建立後 attachWindow
+    FrameStats centerFrameStats;
+    centerFrameStats.setOutputName(QStringLiteral("center"));
+    QObject::connect(&frameStats, &FrameStats::dumpRequested, &centerFrameStats, [&centerFrameStats] {
+        centerFrameStats.dumpJson();
+    });
+
+    // 每個儀表的顯示政策：config.json widgets[].signal = {name, deadband, maxRateHz, quantum, truncate}
+    DashboardQml::applySignalPolicies(config, &vehicleSignals);
+
+    // CAN 擷取：DBC 預編譯解碼表 + SocketCAN 或 candump log（在 worker 執行緒上解碼）
+    std::unique_ptr<CanIngestWorker> canWorker(
+        CanIngestWorker::fromConfig(config.vehicle().value("can").toObject(), &vehicleSignals,
+                                    QCoreApplication::applicationDirPath()));
+
+    // 共享記憶體：同機 gateway 行程寫入 seqlock 區段，GUI 執行緒每幀直接讀取（無系統呼叫）
+    std::unique_ptr<SharedSignalSource> sharedSignals(
+        SharedSignalSource::fromConfig(config.vehicle().value("shm").toObject(), &vehicleSignals));
+
+    // 訊號 datagram：UDP / Unix socket，recvmmsg 批次接收；遺失 / 延遲統計以 "VehicleDatagrams" 暴露給 QML
+    std::unique_ptr<DatagramIngestWorker> datagramWorker(
+        DatagramIngestWorker::fromConfig(config.vehicle().value("datagram").toObject(), &vehicleSignals));
+
+    // 重播：SMART_DASHBOARD_REPLAY=<檔案>，SMART_DASHBOARD_REPLAY_SPEED=1|10|max
+    std::unique_ptr<TelemetryReplay> replay;
+    const QString replayPath = qEnvironmentVariable("SMART_DASHBOARD_REPLAY");
+    if (!replayPath.isEmpty()) {
+        replay = std::make_unique<TelemetryReplay>(&vehicleSignals);
+        if (replay->open(replayPath)) {
+            const QString speed = qEnvironmentVariable("SMART_DASHBOARD_REPLAY_SPEED", QStringLiteral("1"));
+            replay->setSpeed(speed.compare(QStringLiteral("max"), Qt::CaseInsensitive) == 0 ? 0.0 : speed.toDouble());
+            replay->seek(qint64(qEnvironmentVariable("SMART_DASHBOARD_REPLAY_START").toDouble() * 1e6));
+            replay->setLoop(qEnvironmentVariableIsSet("SMART_DASHBOARD_REPLAY_LOOP"));
+        } else {
+            replay.reset();
+        }
+    }
+
+    // 錄製：SMART_DASHBOARD_RECORD=<檔案>（訊號名稱在所有來源註冊完之後才寫進檔頭）
+    const QString recordPath = qEnvironmentVariable("SMART_DASHBOARD_RECORD");
+    if (!recordPath.isEmpty() && recorder.open(recordPath, vehicleSignals.signalNames()))
+        vehicleSignals.setRecorder(&recorder);
     
-    // 註冊 XdgShellHelper（啟用 XDG Shell 協議，讓 Waydroid 等 client 可以連線）
-    // 注意：不再註冊自定義的 WaylandCompositor，直接使用 QtWayland.Compositor 的
-    qmlRegisterType<XdgShellHelper>("SmartDashboard", 1, 0, "XdgShellHelper");
+    // context property 與 QML 型別（與 dashboard_bench 共用同一份清單）
+    DashboardQml::Context qmlContext;
+    qmlContext.config = &config;
+    qmlContext.waydroid = &waydroid;
+    qmlContext.vehicleSignals = &vehicleSignals;
+    qmlContext.frameStats = &frameStats;
+    qmlContext.centerFrameStats = &centerFrameStats;
+    qmlContext.datagrams = datagramWorker.get();
+    qmlContext.compositorMode = useCompositorMode;
+    DashboardQml::setContextProperties(engine.rootContext(), qmlContext);
+    DashboardQml::registerTypes();
     
     // 注意：如果啟用 compositor 模式，我們將在 QML 中使用 WaylandCompositor（QtWayland.Compositor）
     // 而不是在 C++ 中創建。這樣更簡單且更符合 Qt 的最佳實踐。
@@ -191,5 +262,20 @@ CONFIG_DONE:;
         return -1;
     }
 
+    // 讓訊號更新跟著主視窗的幀節奏走（每幀最多一次屬性通知）
+    if (auto *rootWindow = qobject_cast<QQuickWindow *>(engine.rootObjects().first())) {
+        vehicleSignals.attachWindow(rootWindow);
+        frameStats.attachWindow(rootWindow);
+    }
+
+    if (canWorker)
+        canWorker->start();
+    if (replay)
+        replay->start();
+    if (sharedSignals)
+        sharedSignals->start();
+    if (datagramWorker)
+        datagramWorker->start();
+
     return app.exec();
 }
@@ -0,0 +1,110 @@
+import QtQuick
+import QtQuick.Window
+import QtWayland.Compositor
+import SmartDashboard 1.0
+import "widgets"
+
+// 第二個 output（中控螢幕）：自己的 Window（threaded render loop 下有自己的 render 執行緒）與 WaylandOutput，
+// 只顯示 OutputPlacement 分配到這個 output 的 app surface；中控上的重 app 不會拖慢 cluster 的儀表
+Window {
+    id: centerWindow
+
+    property var compositor: null
+    property var shellHelper: null
+    property var frameStats: null
+    property string outputName: "center"
+    // config.json outputs 中這個 output 的設定（screen / width / height）
+    property var config: shellHelper ? shellHelper.placement.outputConfig(outputName) : ({})
+    property var currentSurface: null
+    property size embedSize: Qt.size(appArea.width, appArea.height)
+
+    visible: true
+    width: config.width || 1280
+    height: config.height || 720
+    title: "Smart Dashboard - " + outputName
+    color: "#000000"
+    // 不是 cluster 的子視窗，各自放在自己的螢幕上
+    transientParent: null
+
+    onEmbedSizeChanged: {
+        if (shellHelper)
+            shellHelper.setOutputEmbedSize(outputName, embedSize)
+    }
+
+    WaylandOutput {
+        id: centerOutput
+        compositor: centerWindow.compositor
+        sizeFollowsWindow: true
+        window: centerWindow
+        // frame callback 跟著這個視窗自己的 frameSwapped 送（cluster 的節流不管這裡的 surface）
+    }
+
+    Item {
+        id: appArea
+        anchors.fill: parent
+
+        Repeater {
+            model: shellHelper ? shellHelper.placement.surfacesFor(outputName) : null
+            delegate: SurfaceItem {
+                surface: model.surface
+                anchors.fill: parent
+                focusOnClick: true
+                z: model.surface === currentSurface ? 1 : 0
+                smooth: model.size.width !== width || model.size.height !== height
+            }
+        }
+    }
+
+    // 新分配到這個 output 的 app 疊到最上面
+    Connections {
+        target: shellHelper ? shellHelper.placement : null
+        function onSurfaceOutputChanged(surface, output) {
+            if (output === outputName)
+                currentSurface = surface
+            else if (currentSurface === surface)
+                currentSurface = null
+        }
+    }
+    Connections {
+        target: shellHelper ? shellHelper.packageMatcher : null
+        function onSurfaceMatched(packageName, surface, method) {
+            if (shellHelper.placement.outputOf(surface) === outputName)
+                currentSurface = surface
+        }
+    }
+    Connections {
+        target: shellHelper ? shellHelper.surfaces : null
+        function onSurfaceRemoved(surface) {
+            // 清掉之後依建立順序，最後一個在最上面
+            if (currentSurface === surface)
+                currentSurface = null
+        }
+    }
+
+    Loader {
+        active: frameStats !== null && frameStats.overlayEnabled
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 8
+        z: 1000
+        sourceComponent: FrameStatsOverlay {
+            stats: frameStats
+        }
+    }
+
+    Component.onCompleted: {
+        var screenName = config.screen || ""
+        for (var i = 0; i < Qt.application.screens.length; ++i) {
+            if (Qt.application.screens[i].name === screenName) {
+                centerWindow.screen = Qt.application.screens[i]
+                break
+            }
+        }
+        // 在第一次渲染前掛上，幀計時與 cluster 分開
+        if (frameStats)
+            frameStats.attachWindow(centerWindow)
+        if (shellHelper)
+            shellHelper.setOutputEmbedSize(outputName, embedSize)
+        console.log("CenterDisplay: output", outputName, "on screen", centerWindow.screen ? centerWindow.screen.name : "")
+    }
+}
@@ -22,6 +22,14 @@ ApplicationWindow {
     property bool appsAvailable: waydroidAvailable
                                  && Waydroid.appsModel.count > 0
     
+    // 車輛訊號是否可用（C++ VehicleSignalHub，每幀合併一次更新）
+    property bool vehicleSignalsAvailable: typeof VehicleSignals !== "undefined"
+                                           && VehicleSignals !== null
+
+    // 幀計時（C++ FrameStats）；overlay 由 SMART_DASHBOARD_FRAME_OVERLAY=1 開啟
+    property bool frameStatsAvailable: typeof FrameStats !== "undefined"
+                                       && FrameStats !== null
+
     // 當前嵌入的應用視窗嵌入器（視窗疊加模式）
     property var currentEmbedder: null
     
@@ -29,22 +37,85 @@ ApplicationWindow {
     // 從 C++ 獲取 compositor 模式狀態（因為 QML 中沒有 qEnvironmentVariableIsSet）
     property bool compositorMode: typeof CompositorModeEnabled !== "undefined" ? CompositorModeEnabled : false
     property var currentSurface: null
+    // 切到別的 surface 時，正在等的快照不再相關（liveSurface 還是 null 時由 snapshotView 的逾時收掉）
+    onCurrentSurfaceChanged: {
+        if (snapshotView.liveSurface && currentSurface !== snapshotView.liveSurface)
+            snapshotView.clear()
+    }
     
     // 調試：顯示當前模式狀態（可在 UI 中顯示）
     property string modeStatus: compositorMode ? 
-        ("Compositor 模式" + (compositorSurfaceModel.count > 0 ? " [有表面]" : " [無表面]")) : 
+        ("Compositor 模式" + (xdgShellHelper.surfaces.count > 0 ? " [有表面]" : " [無表面]")) : 
         "視窗疊加模式"
     
-    // 用 ListModel 來保存 compositor surface，讓 Repeater 能正確感知 model 變化
-    ListModel {
-        id: compositorSurfaceModel
-    }
-    
     // 啟用 XDG Shell 協議，讓 Waydroid 等 xdg-shell client 可以連線
     // 這是讓 Waydroid 能正確創建視窗的關鍵！
     XdgShellHelper {
         id: xdgShellHelper
         compositor: waylandCompositor
+        // 讓 client 直接以嵌入區域的大小畫（拖動時由 C++ 端合併）
+        embedSize: Qt.size(appArea.width, appArea.height)
+        // 多螢幕：哪些 app 顯示在 cluster / center
+        outputs: AppConfig.outputs
+    }
+
+    // cluster（這個視窗）上最上面的 surface；其他 output 的不算
+    function topClusterSurface() {
+        for (var row = xdgShellHelper.surfaces.count - 1; row >= 0; --row) {
+            var surface = xdgShellHelper.surfaces.surfaceAt(row)
+            if (xdgShellHelper.placement.outputOf(surface) === "cluster")
+                return surface
+        }
+        return null
+    }
+
+    // surface 清單由 C++（xdgShellHelper.surfaces）維護；這裡只追蹤目前的表面
+    Connections {
+        target: xdgShellHelper.surfaces
+        function onSurfaceAdded(surface) {
+            console.log("🔵 WaylandCompositor: New surface, count:", xdgShellHelper.surfaces.count)
+            // 新視窗疊在最上面（分配到其他 output 的由該 output 的視窗處理）
+            if (xdgShellHelper.placement.outputOf(surface) === "cluster")
+                currentSurface = surface
+        }
+        function onSurfaceRemoved(surface) {
+            console.log("🔴 WaylandCompositor: Surface destroyed, count:", xdgShellHelper.surfaces.count)
+            // 目前的表面被關掉時退回最上面的那個
+            if (currentSurface === surface)
+                currentSurface = topClusterSurface()
+        }
+    }
+
+    // app_id 送到後才知道 surface 屬於哪個 output
+    Connections {
+        target: xdgShellHelper.placement
+        function onSurfaceOutputChanged(surface, output) {
+            if (output !== "cluster" && currentSurface === surface)
+                currentSurface = topClusterSurface()
+        }
+    }
+
+    // 只有目前的表面（且 appArea 可見）全速收 frame callback，其他的降到背景頻率
+    Binding {
+        target: xdgShellHelper.frameThrottler
+        property: "foregroundSurface"
+        value: currentSurface
+    }
+    Binding {
+        target: xdgShellHelper.frameThrottler
+        property: "active"
+        value: appArea.visible
+    }
+
+    Connections {
+        target: xdgShellHelper.packageMatcher
+        function onSurfaceMatched(packageName, surface, method) {
+            console.log("DashboardShell: surface matched to", packageName)
+            if (packageName === snapshotView.packageName)
+                snapshotView.liveSurface = surface
+            if (xdgShellHelper.placement.outputOf(surface) === "cluster")
+                currentSurface = surface
+        }
     }
     
     // WaylandOutput - 連接到我們的 ApplicationWindow
@@ -69,56 +140,20 @@ ApplicationWindow {
     WaylandCompositor {
         id: waylandCompositor
         socketName: "wayland-smartdashboard-0"
-        
-        // 監聯表面創建
-        onSurfaceCreated: function(surface) {
-            console.log("🔵 WaylandCompositor: New surface created")
-            console.log("  Surface object:", surface)
-            console.log("  Current compositorSurfaceModel count:", compositorSurfaceModel.count)
-            
-            // 檢查是否已經存在（避免重複）
-            for (var i = 0; i < compositorSurfaceModel.count; i++) {
-                if (compositorSurfaceModel.get(i).surface === surface) {
-                    console.log("  Surface already exists, skipping")
-                    return
-                }
-            }
-            
-            compositorSurfaceModel.append({ surface: surface })
-            console.log("  After append, compositorSurfaceModel count:", compositorSurfaceModel.count)
-            
-            // 監聽 surface 銷毀事件
-            surface.surfaceDestroyed.connect(function() {
-                console.log("🔴 WaylandCompositor: Surface destroyed")
-                for (var i = 0; i < compositorSurfaceModel.count; i++) {
-                    if (compositorSurfaceModel.get(i).surface === surface) {
-                        compositorSurfaceModel.remove(i)
-                        console.log("  Removed from model, new count:", compositorSurfaceModel.count)
-                        break
-                    }
-                }
-                // 如果當前表面被銷毀，清除引用
-                if (currentSurface === surface) {
-                    currentSurface = null
-                }
-            })
-            
-            // 如果還沒有當前表面，設置第一個表面為當前表面
-            if (!currentSurface) {
-                currentSurface = surface
-                console.log("  Set as current surface")
-            }
-        }
     }
 
 
-    // 背景漸層
-    Rectangle {
+    // 背景漸層（快取成一張貼圖，只在視窗大小改變時重畫）
+    StaticLayer {
         anchors.fill: parent
-        gradient: Gradient {
-            GradientStop { position: 0.0; color: "#16181f" }
-            GradientStop { position: 0.5; color: "#0f1017" }
-            GradientStop { position: 1.0; color: "#070810" }
+
+        Rectangle {
+            anchors.fill: parent
+            gradient: Gradient {
+                GradientStop { position: 0.0; color: "#16181f" }
+                GradientStop { position: 0.5; color: "#0f1017" }
+                GradientStop { position: 1.0; color: "#070810" }
+            }
         }
     }
 
@@ -162,6 +197,7 @@ ApplicationWindow {
         anchors.bottomMargin: 0
         width: parent.width * 0.35
         height: parent.height * 0.17
+        km: vehicleSignalsAvailable ? VehicleSignals.odometer : 0
     }
 
     // ================== 中間速度表 ==================
@@ -175,6 +211,7 @@ ApplicationWindow {
 
         // 原本 0.5 太寬，改 0.8 留一點給左右條
         width: parent.width * 0.8
+        speedKmh: vehicleSignalsAvailable ? VehicleSignals.speed : 0
     }
 
     // ================== 左邊轉速，跟速度表同高 ==================
@@ -184,6 +221,7 @@ ApplicationWindow {
         anchors.verticalCenterOffset: speed.height * 0.026
         height: speed.height * 1.05
         width: Math.min(height * 0.38, window.width * 0.14)
+        rpm: vehicleSignalsAvailable ? VehicleSignals.rpm : 0
 
         anchors.right: speed.left
 
@@ -214,6 +252,7 @@ ApplicationWindow {
         height: speed.height
         width: Math.min(height * 0.38, window.width * 0.14)
         anchors.left: speed.right
+        level: vehicleSignalsAvailable ? VehicleSignals.fuelLevel : 0
 
         // 初始時略微向左插入速度區塊，畫面變寬時慢慢往右「拉開」一點距離
         property real baseOverlap: -width * 0.55                      // 基本向左重疊量（負值越大越往左）
@@ -238,7 +277,7 @@ ApplicationWindow {
             console.log("========================================")
             console.log("DashboardShell: App clicked, package:", packageName)
             console.log("DashboardShell: Compositor mode:", compositorMode)
-            console.log("DashboardShell: Current surface count:", compositorSurfaceModel.count)
+            console.log("DashboardShell: Current surface count:", xdgShellHelper.surfaces.count)
             
             if (compositorMode && waylandCompositor) {
                 // Compositor 模式：啟動應用並等待表面創建
@@ -247,6 +286,18 @@ ApplicationWindow {
                 // 啟動應用（應用會連接到我們的 compositor）
                 if (waydroidAvailable) {
                     console.log("DashboardShell: Launching app via Waydroid.launchApp...")
+                    // app 已經有視窗時直接切過去，否則等 packageMatcher.surfaceMatched
+                    var existing = xdgShellHelper.packageMatcher.expectLaunch(packageName)
+                    // 只有真的會建立新 surface 時才量啟動延遲（切回已在執行的 app 不會有新 surface，只會逾時）
+                    if (!existing)
+                        xdgShellHelper.launchTracker.launchRequested(packageName)
+                    // 目前的 app 先拍一張；要切過去的 app 有快照就先蓋上，直到它的 buffer 到了
+                    if (currentSurface)
+                        xdgShellHelper.snapshots.capture(currentSurface)
+                    if (xdgShellHelper.placement.outputForAppId(packageName) === "cluster")
+                        snapshotView.beginSwitch(packageName, existing)
+                    if (existing && xdgShellHelper.placement.outputOf(existing) === "cluster")
+                        currentSurface = existing
                     Waydroid.launchApp(packageName)
                     console.log("DashboardShell: launchApp called, waiting for surface...")
                     
@@ -293,17 +344,31 @@ ApplicationWindow {
         z: 10
 
         Repeater {
-            model: compositorSurfaceModel
-            delegate: WaylandQuickItem {
+            // 只放分配到 cluster 的 surface（其他的在 CenterDisplay）
+            model: xdgShellHelper.placement.surfacesFor("cluster")
+            // SurfaceItem：WaylandQuickItem 加上只上傳 damage 區域（見 docs/PERFORMANCE.md）
+            delegate: SurfaceItem {
                 surface: model.surface
                 anchors.fill: parent
                 focusOnClick: true
+                // 目前的 app 疊在其他視窗上面
+                z: model.surface === currentSurface ? 1 : 0
+                // buffer 已是嵌入大小時 1:1 貼圖，不需要線性縮放
+                smooth: model.size.width !== width || model.size.height !== height
 
                 Component.onCompleted: {
-                    console.log("WaylandQuickItem created for surface:", model.surface)
+                    console.log("SurfaceItem created for surface:", model.surface)
                 }
             }
         }
+
+        // 切換 app 時的快照（xdgShellHelper.snapshots），app 的 surface commit 新 buffer 或逾時後不畫
+        SurfaceSnapshotItem {
+            id: snapshotView
+            anchors.fill: parent
+            z: 2
+            snapshots: xdgShellHelper.snapshots
+        }
     }
     
     // 視窗疊加模式：當 compositor 模式未啟用時使用
@@ -321,6 +386,29 @@ ApplicationWindow {
         embedder: currentEmbedder
     }
 
+    // 中控螢幕（config.json outputs 的 "center"，或 SMART_DASHBOARD_OUTPUTS=cluster,center）：
+    // 第二個 WaylandOutput 與視窗，有自己的 render 執行緒與幀計時（CenterFrameStats）
+    Loader {
+        active: compositorMode && xdgShellHelper.placement.enabledOutputs.indexOf("center") >= 0
+        sourceComponent: CenterDisplay {
+            compositor: waylandCompositor
+            shellHelper: xdgShellHelper
+            frameStats: typeof CenterFrameStats !== "undefined" ? CenterFrameStats : null
+        }
+    }
+
+    // 幀計時除錯 overlay（關閉時不建立，不產生任何 binding 更新）
+    Loader {
+        active: frameStatsAvailable && FrameStats.overlayEnabled
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 8
+        z: 1000
+        sourceComponent: FrameStatsOverlay {
+            stats: FrameStats
+        }
+    }
+
     // 調試輸出（可以在 QML 控制台看到）
     Component.onCompleted: {
         console.log("========================================")
@@ -18,6 +18,12 @@ QtObject {
             case "fuel":
                 sourceUrl = "qrc:/qt/qml/SmartDashboard/qml/widgets/FuelWidget.qml"
                 break
+            case "tachometer":
+                sourceUrl = "qrc:/qt/qml/SmartDashboard/qml/widgets/TachometerWidget.qml"
+                break
+            case "odometer":
+                sourceUrl = "qrc:/qt/qml/SmartDashboard/qml/widgets/OdometerWidget.qml"
+                break
             case "android-slot":
                 sourceUrl = "qrc:/qt/qml/SmartDashboard/qml/widgets/AndroidSlot.qml"
                 break
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
+import SmartDashboard 1.0
 
 Item {
     id: dock
@@ -18,30 +19,35 @@ Item {
     }
 
     // 底部 Dock 底欄（類似早期 macOS Leopard 的半透明底座）
-    Rectangle {
+    // 底座與高光線快取成一張貼圖，只在寬度改變時重畫
+    StaticLayer {
         id: shelf
         anchors.left: parent.left
         anchors.right: parent.right
         anchors.bottom: parent.bottom
         height: 70
-        radius: 24
-        gradient: Gradient {
-            GradientStop { position: 0.0; color: "#252932" }
-            GradientStop { position: 0.5; color: "#181b23" }
-            GradientStop { position: 1.0; color: "#111219" }
+
+        Rectangle {
+            anchors.fill: parent
+            radius: 24
+            gradient: Gradient {
+                GradientStop { position: 0.0; color: "#252932" }
+                GradientStop { position: 0.5; color: "#181b23" }
+                GradientStop { position: 1.0; color: "#111219" }
+            }
+            border.color: "#3a3f4a"
+            border.width: 1
+            opacity: 0.94
         }
-        border.color: "#3a3f4a"
-        border.width: 1
-        opacity: 0.94
-    }
 
-    // 上緣高光線，讓底欄更有立體感
-    Rectangle {
-        anchors.left: shelf.left
-        anchors.right: shelf.right
-        anchors.top: shelf.top
-        height: 1
-        color: "#ffffff33"
+        // 上緣高光線，讓底欄更有立體感
+        Rectangle {
+            anchors.left: parent.left
+            anchors.right: parent.right
+            anchors.top: parent.top
+            height: 1
+            color: "#ffffff33"
+        }
     }
 
     // 狀態列：顯示 Waydroid 狀態 / App 數量 + 控制按鈕
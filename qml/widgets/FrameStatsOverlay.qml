@@ -0,0 +1,67 @@
+import QtQuick
+
+// 幀計時除錯 overlay（SMART_DASHBOARD_FRAME_OVERLAY=1 或 FrameStats.overlayEnabled = true）
+// 數值每 500 ms 更新一次，單位 ms
+Rectangle {
+    id: root
+    property var stats: null
+
+    implicitWidth: column.implicitWidth + 16
+    implicitHeight: column.implicitHeight + 12
+    color: "#b0000000"
+    radius: 4
+
+    function fmt(value) {
+        return value.toFixed(2)
+    }
+
+    Column {
+        id: column
+        anchors.centerIn: parent
+        spacing: 2
+
+        Text {
+            color: "#a0a0a8"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "        p50    p95    p99   (budget " + root.fmt(root.stats.budgetMs) + ")"
+        }
+        Text {
+            color: "white"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "sync   " + root.fmt(root.stats.syncP50) + "  " + root.fmt(root.stats.syncP95)
+                  + "  " + root.fmt(root.stats.syncP99)
+        }
+        Text {
+            color: "white"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "render " + root.fmt(root.stats.renderP50) + "  " + root.fmt(root.stats.renderP95)
+                  + "  " + root.fmt(root.stats.renderP99)
+        }
+        Text {
+            color: root.stats.frameP95 > root.stats.budgetMs ? "#ff6060" : "white"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "frame  " + root.fmt(root.stats.frameP50) + "  " + root.fmt(root.stats.frameP95)
+                  + "  " + root.fmt(root.stats.frameP99)
+        }
+        Text {
+            color: root.stats.droppedFrames > 0 ? "#ffb040" : "#a0a0a8"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "frames " + root.stats.frameCount + "  missed " + root.stats.missedDeadlines
+                  + "  dropped " + root.stats.droppedFrames
+        }
+        // software 後端才有：每幀重畫面積占視窗的比例
+        Text {
+            visible: root.stats.repaintTracking
+            color: root.stats.fullRepaints > 0 ? "#ffb040" : "#a0a0a8"
+            font.family: "monospace"
+            font.pixelSize: 11
+            text: "repaint avg " + root.stats.repaintAvgPercent.toFixed(1) + "%  max "
+                  + root.stats.repaintMaxPercent.toFixed(1) + "%  full " + root.stats.fullRepaints
+        }
+    }
+}
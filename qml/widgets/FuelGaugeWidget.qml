@@ -1,5 +1,5 @@
 import QtQuick
-import QtQuick.Shapes
+import SmartDashboard 1.0
 
 Item {
     id: root
@@ -19,106 +19,66 @@ Item {
 
     property real baseX0: width * 0.25
 
-    function barHeight(i) { return barH }
-    function barSkew(i)   { return skew }
-
-    function barTopY(i) {
-        var y = topMargin
-        for (var k = 0; k < i; k++)
-            y += barH + gap
-        return y
+    // 油量（0~100 %），由 DashboardShell 綁定到 VehicleSignals.fuelLevel
+    property real level: 0
+    // 由下往上點亮的段數（idx 5 = E，idx 0 = F）
+    property int litCount: Math.max(0, Math.min(6, Math.ceil(level / 100 * 6)))
+    property color unlitColor: "#3a3a36"
+
+    // 條本體：6 段在同一個 C++ scene graph 節點裡（一次 draw call），點亮狀態只改頂點顏色
+    SegmentedBarGauge {
+        id: bars
+        anchors.fill: parent
+        segmentCount: 6
+        bend: SegmentedBarGauge.BendRight
+        segmentWidth: root.barW
+        skewRatio: 0.7
+        gap: root.gap
+        originX: root.baseX0
+        topMargin: root.topMargin
+        bottomMargin: root.bottomMargin
+        litCount: root.litCount
+        litColor: Qt.rgba(1, 0.96, 0.75, 1)
+        unlitColor: root.unlitColor
     }
 
-    // 跟之前一樣：上半往右，下半往左，第 4 段直接接第 3 段
-    function barBaseX(i) {
-        if (i === 0) return baseX0
-
-        var prev = i - 1
-        var prevX = barBaseX(prev)
-        var prevS = barSkew(prev)
-        var prevBottomX = (prev < 3)
-                ? (prevX + prevS)
-                : (prevX - prevS)
+    // F / E 字與油槍圖示不會變：快取成一張貼圖
+    StaticLayer {
+        anchors.fill: parent
 
-        var slope = prevS / barH
-        var horizGap = slope * gap
+        // F / E 字
+        Repeater {
+            model: 6
+            delegate: Item {
+                width: 50; height: 20
 
-        if (i === 3)
-            return prevBottomX
-
-        return (prev < 3)
-               ? (prevBottomX + horizGap)
-               : (prevBottomX - horizGap)
-    }
+                property int idx: index
+                property var seg: bars.segmentGeometry[idx]
 
-    // 條本體
-    Repeater {
-        model: 6
-        delegate: Shape {
-            anchors.fill: parent
-            property int idx: index
-            property real topY: root.barTopY(idx)
-            property real baseX: root.barBaseX(idx)
-            property real s: root.barSkew(idx)
+                Text {
+                    visible: idx === 0 || idx === 5
+                    text: idx === 0 ? "-F" : "-E"
+                    color: "white"
+                    font.pixelSize: root.height * 0.045
 
-            ShapePath {
-                strokeWidth: 0
-                fillColor: Qt.rgba(1, 0.96, 0.75, 1)
+                    // skew 已帶方向（上半 +，下半 -）
+                    x: !seg ? 0 : seg.x + root.barW + seg.skew + root.textGap
 
-                startX: baseX; startY: topY
-                PathLine { x: baseX + root.barW; y: topY }
-                PathLine {
-                    x: (idx < 3)
-                        ? (baseX + root.barW + s)
-                        : (baseX + root.barW - s)
-                    y: topY + root.barH
+                    y: !seg ? 0 : (idx === 0)
+                       ? (seg.y - height * 0.5)
+                       : (seg.y + seg.height - height * 0.6)
                 }
-                PathLine {
-                    x: (idx < 3)
-                        ? (baseX + s)
-                        : (baseX - s)
-                    y: topY + root.barH
-                }
-                PathLine { x: baseX; y: topY }
             }
         }
-    }
-
-    // F / E 字
-    Repeater {
-        model: 6
-        delegate: Item {
-            width: 50; height: 20
 
-            property int idx: index
-            property real topY: root.barTopY(idx)
-            property real baseX: root.barBaseX(idx)
-            property real s: root.barSkew(idx)
-
-            Text {
-                visible: idx === 0 || idx === 5
-                text: idx === 0 ? "-F" : "-E"
-                color: "white"
-                font.pixelSize: root.height * 0.045
-
-                x: (idx === 0)
-                   ? (baseX + root.barW + s + root.textGap)
-                   : (baseX + root.barW - s + root.textGap)
-
-                y: (idx === 0)
-                   ? (topY - height * 0.5)
-                   : (topY + root.barH - height * 0.6)
-            }
+        // 油槍
+        Text {
+            text: "\u26FD"
+            color: "white"
+            font.pixelSize: root.height * 0.07
+            property var seg: bars.segmentGeometry[2]
+            x: !seg ? 0 : seg.x + root.barW + root.textGap * 9
+            y: !seg ? 0 : seg.y + seg.height + root.gap / 2 - height / 2
         }
     }
-
-    // 油槍
-    Text {
-        text: "\u26FD"
-        color: "white"
-        font.pixelSize: root.height * 0.07
-        property real y3: root.barTopY(2)
-        x: root.barBaseX(2) + root.barW + root.textGap * 9
-        y: y3 + root.barH + root.gap / 2 - height / 2
-    }
 }
@@ -1,4 +1,5 @@
 import QtQuick
+import SmartDashboard 1.0
 
 Item {
     id: root
@@ -6,6 +7,9 @@ Item {
     implicitWidth: 360
     implicitHeight: 120
 
+    // 里程（km），由 DashboardShell 綁定到 VehicleSignals.odometer
+    property real km: 0
+
     Column {
         anchors.horizontalCenter: parent.horizontalCenter
         anchors.top: parent.top
@@ -20,8 +24,11 @@ Item {
             anchors.horizontalCenter: parent.horizontalCenter
         }
 
-        Text {
-            text: "888888 km"
+        // 數字 atlas：里程無條件捨去到整數公里
+        NumericReadout {
+            value: root.km
+            truncate: true
+            suffix: " km"
             color: "white"
             font.pixelSize: root.height * 0.28   // 原本 34/120 ≈ 0.28
             font.bold: true
@@ -1,4 +1,5 @@
 import QtQuick
+import SmartDashboard 1.0
 
 Item {
     id: root
@@ -11,6 +12,9 @@ Item {
     property real sideMargin:   width  * 0.03
     property real slopeRatio: 0.7
 
+    // 車速（km/h），由 DashboardShell 綁定到 VehicleSignals.speed
+    property real speedKmh: 0
+
     property real midY: height / 2
     property real topY: topMargin
     property real bottomY: height - bottomMargin
@@ -19,34 +23,52 @@ Item {
     property real leftX:  sideMargin + diagInset
     property real rightX: width - sideMargin - diagInset
 
-    // 六邊形外框
-    Canvas {
+    // 靜態裝飾（六邊形外框、速限標誌）快取成一張貼圖；速度數字在後面宣告，疊在上面即時更新
+    StaticLayer {
         anchors.fill: parent
-        onPaint: {
-            var ctx = getContext("2d")
-            ctx.reset()
-            ctx.clearRect(0, 0, width, height)
-            ctx.lineWidth = Math.min(width, height) * 0.015
-            ctx.strokeStyle = "rgba(210,215,225,0.9)"
-            ctx.lineCap = "round"
-            ctx.beginPath()
-            ctx.moveTo(leftX, topY)
-            ctx.lineTo(rightX, topY)
-            ctx.lineTo(width - sideMargin, midY)
-            ctx.lineTo(rightX, bottomY)
-            ctx.lineTo(leftX, bottomY)
-            ctx.lineTo(sideMargin, midY)
-            ctx.closePath()
-            ctx.stroke()
+
+        // 六邊形外框（C++ scene graph 節點，只在大小或參數改變時重建頂點）
+        HexFrame {
+            anchors.fill: parent
+            topMargin: root.topMargin
+            bottomMargin: root.bottomMargin
+            sideMargin: root.sideMargin
+            slopeRatio: root.slopeRatio
+            lineWidth: Math.min(root.width, root.height) * 0.015
+            color: Qt.rgba(210 / 255, 215 / 255, 225 / 255, 0.9)
+        }
+
+        // 速限標誌：大小隨寬高縮放（保持圓形比例）
+        Item {
+            id: speedLimit
+            property real circleSize: Math.min(root.width, root.height) * 0.15
+            width: circleSize
+            height: circleSize
+            anchors.verticalCenter: parent.verticalCenter
+            x: sideMargin + circleSize * 0.5 + root.width * 0.01
+
+            Rectangle {
+                anchors.fill: parent
+                radius: width / 2
+                color: "white"
+                border.color: "#ff3a3a"
+                border.width: width * 0.12
+            }
+
+            Text {
+                anchors.centerIn: parent
+                text: "60"
+                color: "#1c1f26"
+                font.bold: true
+                font.pixelSize: parent.height * 0.42
+            }
         }
-        onWidthChanged: requestPaint()
-        onHeightChanged: requestPaint()
     }
 
-    // 主速度數字
-    Text {
+    // 主速度數字（數字 atlas：值改變時只換 UV，不重新排版）
+    NumericReadout {
         id: speedValue
-        text: "0"
+        value: root.speedKmh
         color: "white"
         font.bold: true
         // 數字更高一點
@@ -66,31 +88,5 @@ Item {
         anchors.top: speedValue.bottom
         anchors.topMargin: -root.height * 0.1  // 貼近數字上緣一點
     }
-
-    // 速限標誌：大小隨寬高縮放（保持圓形比例）
-    Item {
-        id: speedLimit
-        property real circleSize: Math.min(root.width, root.height) * 0.15
-        width: circleSize
-        height: circleSize
-        anchors.verticalCenter: parent.verticalCenter
-        x: sideMargin + circleSize * 0.5 + root.width * 0.01
-
-        Rectangle {
-            anchors.fill: parent
-            radius: width / 2
-            color: "white"
-            border.color: "#ff3a3a"
-            border.width: width * 0.12
-        }
-
-        Text {
-            anchors.centerIn: parent
-            text: "60"
-            color: "#1c1f26"
-            font.bold: true
-            font.pixelSize: parent.height * 0.42
-        }
-    }
 }
 
@@ -1,5 +1,5 @@
 import QtQuick
-import QtQuick.Shapes
+import SmartDashboard 1.0
 
 Item {
     id: root
@@ -21,9 +21,17 @@ Item {
                              - 5 * gap) / 5
 
     property real barW: width * 0.3
-    property real skew: baseBarH * 0.7
+    property real skewRatio: 0.7
+    property real skew: baseBarH * skewRatio
     property real textGap: width * 0.02
 
+    // 轉速（r/min），由 DashboardShell 綁定到 VehicleSignals.rpm
+    property real rpm: 0
+    property real maxRpm: 10000
+    // 由下往上點亮的段數（idx 5 = 0~2k，idx 0 = 紅區）
+    property int litCount: Math.max(0, Math.min(6, Math.ceil(rpm / maxRpm * 6)))
+    property color unlitColor: "#3a3a36"
+
     // 拿來量 "10-" 真的多寬
     Text {
         id: measureLabel
@@ -32,126 +40,68 @@ Item {
         visible: false
     }
 
-    function barHeight(i) { return (i === 2 || i === 3) ? baseBarH / 2 : baseBarH }
-    function barSkew(i)   { return (i === 2 || i === 3) ? skew / 2 : skew }
-
-    // 前兩段往左的量
-    property real s0: barSkew(0)
-    property real s1: barSkew(1)
-    property real gapProj0: (s0 / barHeight(0)) * gap
-    property real gapProj1: (s1 / barHeight(1)) * gap
-
     property real leftMargin: width * 0.01
 
-    // ✅ 這是你說的剛剛好那個版本
-    property real baseX0: measureLabel.width
-                          + s0 + gapProj0
-                          + s1 + gapProj1
-
-    // Y 疊上去
-    function barTopY(i) {
-        var y = topMargin
-        for (var k = 0; k < i; k++)
-            y += barHeight(k) + gap
-        return y
-    }
+    // ✅ 這是你說的剛剛好那個版本：前兩段（全高）往左的量 = 2 × (斜切 + gap 的水平投影)
+    property real baseX0: measureLabel.width + 2 * (skew + skewRatio * gap)
 
-    // X：前三段往左，第四段接，後面往右
-    function barBaseX(i) {
-        if (i === 0)
-            return baseX0
-
-        var prev = i - 1
-        var prevX = barBaseX(prev)
-        var prevH = barHeight(prev)
-        var prevS = barSkew(prev)
+    // ========= 條本體 =========
+    // 6 段在同一個 C++ scene graph 節點裡（一次 draw call），點亮狀態只改頂點顏色
+    SegmentedBarGauge {
+        id: bars
+        anchors.fill: parent
+        segmentCount: 6
+        halfHeightSegments: [2, 3]
+        bend: SegmentedBarGauge.BendLeft
+        segmentWidth: root.barW
+        skewRatio: root.skewRatio
+        gap: root.gap
+        originX: root.baseX0
+        topMargin: root.topMargin
+        bottomMargin: root.bottomTextSpace + root.bottomMargin
+        litCount: root.litCount
+        accentSegments: 1
+        litColor: "#fff5c0"
+        unlitColor: root.unlitColor
+        accentColor: "#ff4444"
+    }
 
-        var prevBottomX = (prev < 3)
-                ? (prevX - prevS)
-                : (prevX + prevS)
+    // 刻度與單位文字不會變：快取成一張貼圖（段落版面只隨大小改變，與快取重畫時機一致）
+    StaticLayer {
+        anchors.fill: parent
 
-        var slope = prevS / prevH
-        var horizGap = slope * gap
+        // ========= 左邊刻度 =========
+        Repeater {
+            model: ["10-", "8-", "6-", "4-", "2-", "0-"]
+            delegate: Text {
+                text: modelData
+                color: "white"
+                font.pixelSize: root.height * 0.06
 
-        if (i === 3)
-            return prevBottomX
+                property int idx: index
+                property var seg: bars.segmentGeometry[idx]
 
-        return (prev < 3)
-               ? (prevBottomX - horizGap)
-               : (prevBottomX + horizGap)
-    }
+                x: !seg ? 0 : (idx < 3)
+                   ? (seg.x - width - root.textGap)
+                   : (seg.x + seg.skew - width - root.textGap)
 
-    // ========= 條本體 =========
-    Repeater {
-        model: 6
-        delegate: Shape {
-            anchors.fill: parent
-            property int idx: index
-            property real topY: root.barTopY(idx)
-            property real h: root.barHeight(idx)
-            property real s: root.barSkew(idx)
-            property real baseX: root.barBaseX(idx)
-
-            ShapePath {
-                strokeWidth: 0
-                fillColor: idx === 0 ? "#ff4444" : "#fff5c0"
-
-                startX: baseX; startY: topY
-                PathLine { x: baseX + root.barW; y: topY }
-                PathLine {
-                    x: (idx < 3)
-                       ? (baseX + root.barW - s)
-                       : (baseX + root.barW + s)
-                    y: topY + h
-                }
-                PathLine {
-                    x: (idx < 3)
-                       ? (baseX - s)
-                       : (baseX + s)
-                    y: topY + h
-                }
-                PathLine { x: baseX; y: topY }
+                y: !seg ? 0 : (idx < 3)
+                   ? (seg.y - height / 2)
+                   : (seg.y + seg.height - height / 2)
             }
         }
-    }
 
-    // ========= 左邊刻度 =========
-    Repeater {
-        model: ["10-", "8-", "6-", "4-", "2-", "0-"]
-        delegate: Text {
-            text: modelData
+        // ========= 底部單位 =========
+        Text {
+            text: "x1000 r/min"
             color: "white"
-            font.pixelSize: root.height * 0.06
-
-            property int idx: index
-            property real topY: root.barTopY(idx)
-            property real h: root.barHeight(idx)
-            property real s: root.barSkew(idx)
-            property real baseX: root.barBaseX(idx)
+            font.pixelSize: root.height * 0.045
 
-            x: (idx < 3)
-               ? (baseX - width - root.textGap)
-               : (baseX + s - width - root.textGap)
+            // 直接用最下面那段的底 + 一點點 margin
+            property var last: bars.segmentGeometry[5]
 
-            y: (idx < 3)
-               ? (topY - height / 2)
-               : (topY + h - height / 2)
+            y: !last ? 0 : last.y + last.height + root.height * 0.008   // 這裡你要高一點就再加
+            x: !last ? 0 : last.x + last.skew - root.width * 0.08
         }
     }
-
-    // ========= 底部單位 =========
-    Text {
-        text: "x1000 r/min"
-        color: "white"
-        font.pixelSize: root.height * 0.045
-
-        // 直接用最下面那段的底 + 一點點 margin
-        property real lastTop: root.barTopY(5)
-        property real lastH: root.barHeight(5)
-        property real lastS: root.barSkew(5)
-        property real lastX: root.barBaseX(5)
-
-        y: lastTop + lastH + root.height * 0.008   // 這裡你要高一點就再加
-        x: lastX + lastS - root.width * 0.08
-    }
 }
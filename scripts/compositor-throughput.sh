@@ -0,0 +1,92 @@
+#!/bin/bash
+
+# Compositor 吞吐量量測腳本
+# 以 dashboard_bench --clients 逐步增加 stub surface 數（smartdashboard-wayland-stub），
+# 找出儀表（cluster）幀的 p95 開始超過門檻時的 surface 數。不需要 Waydroid，可在 CI 上執行。
+#
+# 用法：
+#   scripts/compositor-throughput.sh [--max-frame-p95 16.7] [--client-rate 60] [--client-size 1280x720]
+#                                    [--client-damage 100] [--frames 300] [--counts "1 2 4 8 16"]
+#
+# 結果 JSON 寫在 $OUT_DIR（預設 ./compositor-throughput）；exit code 2 表示第一個計數就超過門檻。
+
+set -e
+
+# 顏色定義
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # No Color
+
+MAX_P95="16.7"
+CLIENT_RATE="60"
+CLIENT_SIZE=""
+CLIENT_DAMAGE="100"
+FRAMES="300"
+COUNTS="1 2 4 8 16"
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --max-frame-p95) MAX_P95="$2"; shift 2 ;;
+        --client-rate) CLIENT_RATE="$2"; shift 2 ;;
+        --client-size) CLIENT_SIZE="$2"; shift 2 ;;
+        --client-damage) CLIENT_DAMAGE="$2"; shift 2 ;;
+        --frames) FRAMES="$2"; shift 2 ;;
+        --counts) COUNTS="$2"; shift 2 ;;
+        *)
+            echo -e "${RED}未知參數: $1${NC}"
+            exit 1
+            ;;
+    esac
+done
+
+# 獲取應用程序路徑
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+APP_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-$APP_DIR/build}"
+OUT_DIR="${OUT_DIR:-$PWD/compositor-throughput}"
+
+BENCH="$BUILD_DIR/dashboard_bench"
+STUB="$BUILD_DIR/smartdashboard-wayland-stub"
+for tool in "$BENCH" "$STUB"; do
+    if [ ! -x "$tool" ]; then
+        echo -e "${RED}錯誤: 找不到 $tool${NC}"
+        echo "請先構建（smartdashboard-wayland-stub 需要 wayland-client、wayland-protocols 與 wayland-scanner）"
+        exit 1
+    fi
+done
+
+mkdir -p "$OUT_DIR"
+
+echo -e "${GREEN}Compositor 吞吐量量測${NC}"
+echo "=========================================="
+echo "門檻: frame p95 <= ${MAX_P95} ms，stub ${CLIENT_RATE} Hz，damage ${CLIENT_DAMAGE}%"
+
+SIZE_ARGS=()
+if [ -n "$CLIENT_SIZE" ]; then
+    SIZE_ARGS=(--client-size "$CLIENT_SIZE")
+fi
+
+LAST_OK=0
+for count in $COUNTS; do
+    echo -e "${YELLOW}--- ${count} 個 surface ---${NC}"
+    status=0
+    "$BENCH" --frames "$FRAMES" --clients "$count" --client-bin "$STUB" \
+        --client-rate "$CLIENT_RATE" --client-damage "$CLIENT_DAMAGE" "${SIZE_ARGS[@]}" \
+        --json "$OUT_DIR/clients-$count.json" --max-frame-p95 "$MAX_P95" || status=$?
+    if [ "$status" -eq 2 ]; then
+        echo -e "${RED}${count} 個 surface 時 frame p95 超過 ${MAX_P95} ms${NC}"
+        break
+    elif [ "$status" -ne 0 ]; then
+        echo -e "${RED}dashboard_bench 失敗（exit $status）${NC}"
+        exit 1
+    fi
+    LAST_OK=$count
+done
+
+echo "=========================================="
+if [ "$LAST_OK" -eq 0 ]; then
+    echo -e "${RED}沒有任何 surface 數在門檻內${NC}"
+    exit 2
+fi
+echo -e "${GREEN}門檻內最多 ${LAST_OK} 個 surface（結果: $OUT_DIR）${NC}"
@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# 假的 waydroid 指令（沒有 Waydroid container 的機器 / CI 上測試 WaydroidManager 與 WaydroidSessionMonitor）
+#
+# 狀態放在 $FAKE_WAYDROID_DIR（預設 $XDG_RUNTIME_DIR/fake-waydroid）：
+#   session.cfg       session 執行中時存在（state = RUNNING），與 /var/lib/waydroid/session.cfg 相同的用法
+#   invocations.log   每次被呼叫的參數（可用來數 `status` 被 fork 了幾次）
+#
+# 用法：
+#   export FAKE_WAYDROID_DIR=/tmp/fake-waydroid
+#   SMART_DASHBOARD_WAYDROID_BIN=scripts/fake-waydroid.sh \
+#   SMART_DASHBOARD_WAYDROID_WATCH=$FAKE_WAYDROID_DIR:$FAKE_WAYDROID_DIR/session.cfg ./appSmartDashboard
+#   scripts/fake-waydroid.sh session start     # 儀表應在 debounce 後立刻看到 running
+#   scripts/fake-waydroid.sh session stop
+#   grep -c '^status' $FAKE_WAYDROID_DIR/invocations.log
+#
+# FAKE_WAYDROID_STUB 指向 smartdashboard-wayland-stub 時，`app launch <包名>` 會以 app_id waydroid.<包名>
+# 開一個假的 app 視窗（compositor 模式）。
+
+set -e
+
+FAKE_WAYDROID_DIR="${FAKE_WAYDROID_DIR:-${XDG_RUNTIME_DIR:-/tmp}/fake-waydroid}"
+SESSION_CFG="$FAKE_WAYDROID_DIR/session.cfg"
+
+mkdir -p "$FAKE_WAYDROID_DIR"
+echo "$*" >> "$FAKE_WAYDROID_DIR/invocations.log"
+
+session_running() {
+    [ -f "$SESSION_CFG" ] && grep -q "state = RUNNING" "$SESSION_CFG"
+}
+
+start_session() {
+    # 先寫暫存檔再 rename：監看端只看到一次完整的建立
+    printf '[session]\nstate = RUNNING\npid = %s\n' "$$" > "$SESSION_CFG.tmp"
+    mv "$SESSION_CFG.tmp" "$SESSION_CFG"
+}
+
+stop_session() {
+    rm -f "$SESSION_CFG"
+    if [ -f "$FAKE_WAYDROID_DIR/apps.pid" ]; then
+        xargs -r kill < "$FAKE_WAYDROID_DIR/apps.pid" 2> /dev/null || true
+        rm -f "$FAKE_WAYDROID_DIR/apps.pid"
+    fi
+}
+
+case "$1 $2" in
+    "status "*)
+        if session_running; then
+            printf 'Session:\tRUNNING\nContainer:\tRUNNING\nVendor type:\tMAINLINE\n'
+        else
+            printf 'Session:\tSTOPPED\nVendor type:\tMAINLINE\n'
+        fi
+        ;;
+    "session start" | "container start")
+        start_session
+        ;;
+    "session stop" | "container stop")
+        stop_session
+        ;;
+    "app list")
+        if ! session_running; then
+            echo "[waydroid] WayDroid session is stopped" >&2
+            exit 1
+        fi
+        printf 'Name: Maps\npackageName: com.google.android.apps.maps\ncategories:\n\tandroid.intent.category.LAUNCHER\n\n'
+        printf 'Name: Music\npackageName: com.example.music\ncategories:\n\tandroid.intent.category.LAUNCHER\n\n'
+        printf 'Name: Settings\npackageName: com.android.settings\ncategories:\n\tandroid.intent.category.LAUNCHER\n'
+        ;;
+    "app launch")
+        if [ -n "$FAKE_WAYDROID_STUB" ] && [ -n "$3" ]; then
+            "$FAKE_WAYDROID_STUB" --app-id "waydroid.$3" --duration 0 > /dev/null &
+            echo $! >> "$FAKE_WAYDROID_DIR/apps.pid"
+        fi
+        ;;
+    "show-full-ui "*)
+        ;;
+    *)
+        echo "fake-waydroid: unsupported command: $*" >&2
+        exit 2
+        ;;
+esac
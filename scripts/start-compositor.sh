@@ -43,6 +43,8 @@ export SMART_DASHBOARD_COMPOSITOR_SOCKET_NAME="$COMPOSITOR_SOCKET"
 
 # 1. 強制使用軟體渲染（禁用 GPU 加速，測試 hardware cursor 問題）
 # export QT_QUICK_BACKEND=software
+#    無 GPU 的儀表硬體請改用 software cluster 模式（只重畫變動區域，重畫面積見 FrameStats overlay）
+# export SMART_DASHBOARD_SOFTWARE_CLUSTER=1
 
 # 2. 禁用 VSync（測試刷新同步問題）
 # export QSG_RENDER_LOOP=basic
@@ -61,6 +63,33 @@ export SMART_DASHBOARD_COMPOSITOR_SOCKET_NAME="$COMPOSITOR_SOCKET"
 # 6. OpenGL 調試
 # export QSG_INFO=1
 
+# 7. 幀計時（FrameStats）：右上角顯示 sync / render / frame 的 p50/p95/p99
+# export SMART_DASHBOARD_FRAME_OVERLAY=1
+#    預設預算為螢幕刷新週期，可手動指定（ms）
+# export SMART_DASHBOARD_FRAME_BUDGET_MS=16.7
+#    執行中 kill -USR1 <pid> 會寫出 JSON（預設 $XDG_RUNTIME_DIR/smartdashboard-framestats-<pid>.json）
+# export SMART_DASHBOARD_FRAMESTATS=/tmp/framestats.json
+
+# 8. 被蓋住 / 不可見的 app 視窗每秒只收幾次 frame callback（預設 1；0 = 完全暫停）
+# export SMART_DASHBOARD_BACKGROUND_FPS=1
+#    停用節流，所有 surface 都跟著畫面全速收 frame callback
+# export SMART_DASHBOARD_FRAME_THROTTLE=0
+
+# 9. app 視窗每次 commit 都整張上傳（停用只上傳 damage 區域，比較用）
+# export SMART_DASHBOARD_PARTIAL_UPLOAD=0
+
+# 10. 開啟中控螢幕（第二個 output，app 分配見 config.json 的 outputs）
+# export SMART_DASHBOARD_OUTPUTS=cluster,center
+
+# 11. 切換 app 時的快照：記憶體上限（MB，預設 16；0 = 停用）與快照長邊像素（預設 640）
+# export SMART_DASHBOARD_SNAPSHOT_BUDGET_MB=16
+# export SMART_DASHBOARD_SNAPSHOT_EDGE=640
+
+# 12. Waydroid 狀態監看的路徑（以 ':' 分隔，預設 /var/lib/waydroid 下的狀態檔）與 waydroid 執行檔
+#     （沒有 Waydroid 時可用 scripts/fake-waydroid.sh，見 docs/PERFORMANCE.md）
+# export SMART_DASHBOARD_WAYDROID_WATCH=/var/lib/waydroid:/var/lib/waydroid/session.cfg
+# export SMART_DASHBOARD_WAYDROID_BIN=waydroid
+
 # 注意：不要設置 WAYLAND_DISPLAY，讓 Qt 應用使用默認的顯示服務器
 # 我們創建的 compositor 是嵌套的，會創建自己的 socket
 # 其他應用（如 Waydroid）需要連接到這個 socket
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+
+// Waydroid 的一個 launcher app（`waydroid app list` 的一筆）
+struct AppEntry {
+    QString label;
+    QString package;
+
+    bool operator==(const AppEntry &other) const { return label == other.label && package == other.package; }
+    bool operator!=(const AppEntry &other) const { return !(*this == other); }
+};
+
+class AppsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+public:
+    enum Roles { LabelRole = Qt::UserRole + 1, PackageRole };
+
+    explicit AppsModel(QObject *parent = nullptr)
+        : QAbstractListModel(parent) {}
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+        Q_UNUSED(parent);
+        return m_apps.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override {
+        if (!index.isValid() || index.row() < 0 || index.row() >= m_apps.size())
+            return {};
+        const auto &app = m_apps.at(index.row());
+        switch (role) {
+        case LabelRole:
+            return app.label;
+        case PackageRole:
+            return app.package;
+        default:
+            return {};
+        }
+    }
+
+    QHash<int, QByteArray> roleNames() const override {
+        return {{LabelRole, QByteArrayLiteral("label")},
+                {PackageRole, QByteArrayLiteral("package")}};
+    }
+
+    const QVector<AppEntry> &apps() const { return m_apps; }
+
+    // 與目前的列表比對，只發出必要的 remove / move / insert / dataChanged（以 package 為 key），
+    // 已存在的 AppIcon delegate 不會被重建
+    // 輸入中重複的 package 只留第一個
+    void setApps(QVector<AppEntry> apps) {
+        const int oldCount = m_apps.size();
+
+        // 0. 輸入去重：否則第二個同 package 的項目在步驟 2 找不到（只往後找）而被插入成重複的列
+        QSet<QString> packages;
+        apps.erase(std::remove_if(apps.begin(), apps.end(),
+                                  [&packages](const AppEntry &app) {
+                                      if (packages.contains(app.package))
+                                          return true;
+                                      packages.insert(app.package);
+                                      return false;
+                                  }),
+                   apps.end());
+
+        // 1. 移除新列表中沒有的（從後面往前，連續的合併成一段）
+        for (int row = m_apps.size() - 1; row >= 0;) {
+            if (packages.contains(m_apps.at(row).package)) {
+                --row;
+                continue;
+            }
+            int first = row;
+            while (first > 0 && !packages.contains(m_apps.at(first - 1).package))
+                --first;
+            beginRemoveRows(QModelIndex(), first, row);
+            m_apps.remove(first, row - first + 1);
+            endRemoveRows();
+            row = first - 1;
+        }
+
+        // 2. 依新列表的順序：相同就比 label，在後面就搬上來，沒有就插入
+        for (int row = 0; row < apps.size(); ++row) {
+            const AppEntry &app = apps.at(row);
+            int from = row;
+            while (from < m_apps.size() && m_apps.at(from).package != app.package)
+                ++from;
+            if (from == m_apps.size()) {
+                beginInsertRows(QModelIndex(), row, row);
+                m_apps.insert(row, app);
+                endInsertRows();
+                continue;
+            }
+            if (from != row) {
+                beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+                m_apps.move(from, row);
+                endMoveRows();
+            }
+            if (m_apps.at(row).label != app.label) {
+                m_apps[row].label = app.label;
+                const QModelIndex changed = index(row);
+                emit dataChanged(changed, changed, {LabelRole});
+            }
+        }
+
+        // 目前列表裡重複的 package 只會對應到一列，剩在最後面的刪掉
+        if (m_apps.size() > apps.size()) {
+            beginRemoveRows(QModelIndex(), apps.size(), m_apps.size() - 1);
+            m_apps.resize(apps.size());
+            endRemoveRows();
+        }
+
+        if (m_apps.size() != oldCount)
+            emit countChanged();
+    }
+
+signals:
+    void countChanged();
+
+private:
+    QVector<AppEntry> m_apps;
+};
@@ -0,0 +1,176 @@
+#include "candecoder.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QMap>
+#include <QRegularExpression>
+
+#include <algorithm>
+
+bool DbcDatabase::loadFromFile(const QString &filePath, QString *errorString)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString)
+            *errorString = QStringLiteral("Cannot open DBC file %1: %2").arg(filePath, file.errorString());
+        return false;
+    }
+    return parse(file.readAll(), errorString);
+}
+
+bool DbcDatabase::parse(const QByteArray &text, QString *errorString)
+{
+    // BO_ <id> <name>: <dlc> <sender>
+    static const QRegularExpression reMessage(
+        QStringLiteral(R"(^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+))"));
+    // SG_ <name> [M|mN] : <start>|<len>@<0|1><+|-> (<factor>,<offset>) [<min>|<max>] "<unit>" <receivers>
+    static const QRegularExpression reSignal(
+        QStringLiteral(R"(^SG_\s+(\w+)\s*(M|m\d+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*)"
+                       R"(\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\)\s*\[[^\]]*\]\s*"([^"]*)\")"));
+
+    m_signals.clear();
+    m_messageCount = 0;
+
+    bool inMessage = false;
+    quint32 messageId = 0;
+    QString messageName;
+
+    const QList<QByteArray> lines = text.split('\n');
+    for (int lineNo = 0; lineNo < lines.size(); ++lineNo) {
+        const QString line = QString::fromUtf8(lines.at(lineNo)).trimmed();
+        if (line.isEmpty()) {
+            inMessage = false;
+            continue;
+        }
+
+        if (line.startsWith(QStringLiteral("BO_ "))) {
+            const auto m = reMessage.match(line);
+            if (!m.hasMatch()) {
+                qWarning() << "DbcDatabase: malformed BO_ at line" << lineNo + 1 << ":" << line;
+                inMessage = false;
+                continue;
+            }
+            // DBC 以 bit 31 表示擴充幀，與 CanFrame::ExtendedFlag 一致
+            messageId = m.captured(1).toUInt();
+            messageName = m.captured(2);
+            inMessage = true;
+            ++m_messageCount;
+            continue;
+        }
+
+        if (!line.startsWith(QStringLiteral("SG_ ")))
+            continue;
+        if (!inMessage) {
+            qWarning() << "DbcDatabase: SG_ outside of BO_ at line" << lineNo + 1;
+            continue;
+        }
+
+        const auto m = reSignal.match(line);
+        if (!m.hasMatch()) {
+            qWarning() << "DbcDatabase: malformed SG_ at line" << lineNo + 1 << ":" << line;
+            continue;
+        }
+
+        SignalInfo info;
+        info.messageId = messageId;
+        info.messageName = messageName;
+        info.name = m.captured(1);
+        info.multiplexed = m.capturedLength(2) > 0;
+        info.startBit = m.captured(3).toInt();
+        info.length = m.captured(4).toInt();
+        info.bigEndian = m.captured(5) == QLatin1String("0");
+        info.isSigned = m.captured(6) == QLatin1String("-");
+        info.factor = m.captured(7).toDouble();
+        info.offset = m.captured(8).toDouble();
+        info.unit = m.captured(9);
+        m_signals.append(info);
+    }
+
+    if (m_signals.isEmpty()) {
+        if (errorString)
+            *errorString = QStringLiteral("DBC contains no signals");
+        return false;
+    }
+    return true;
+}
+
+bool CanSignalDecoder::compile(const DbcDatabase &db, const QHash<QString, int> &signalMap)
+{
+    m_extractors.clear();
+    m_messages.clear();
+    m_extendedIndex.clear();
+    m_standardIndex.fill(-1, kStandardIdCount);
+
+    // 先依訊息 ID 分組，讓同一訊息的 extractor 連續存放
+    QMap<quint32, QVector<Extractor>> grouped;
+    for (const auto &info : db.signalInfos()) {
+        const auto target = signalMap.constFind(info.name);
+        if (target == signalMap.constEnd() || target.value() < 0)
+            continue;
+
+        if (info.multiplexed) {
+            qWarning() << "CanSignalDecoder: multiplexed signal not supported, skipping" << info.name;
+            continue;
+        }
+        if (info.length <= 0 || info.length > 64) {
+            qWarning() << "CanSignalDecoder: invalid length for" << info.name << info.length;
+            continue;
+        }
+
+        Extractor x;
+        x.targetId = target.value();
+        x.bigEndian = info.bigEndian;
+        x.factor = info.factor;
+        x.offset = info.offset;
+        x.mask = info.length == 64 ? ~quint64(0) : ((quint64(1) << info.length) - 1);
+        x.signBit = info.isSigned ? (quint64(1) << (info.length - 1)) : 0;
+
+        int shift = 0;
+        int lastBit = 0; // 以 64-bit 字組計，訊號最後一個 bit 的位置（用來算最小幀長）
+        if (info.bigEndian) {
+            // Motorola：startBit 是 MSB，採 DBC 的「鋸齒」編號；
+            // 換算成 big-endian 64-bit 字組中從最高位數起的位置
+            const int msbFromTop = (info.startBit / 8) * 8 + (7 - info.startBit % 8);
+            shift = 64 - msbFromTop - info.length;
+            lastBit = msbFromTop + info.length;
+        } else {
+            shift = info.startBit;
+            lastBit = info.startBit + info.length;
+        }
+        if (shift < 0 || lastBit > 64) {
+            qWarning() << "CanSignalDecoder: signal exceeds 8-byte payload, skipping" << info.name;
+            continue;
+        }
+        x.shift = quint8(shift);
+        x.minLength = quint8((lastBit + 7) / 8);
+        grouped[info.messageId].append(x);
+    }
+
+    for (auto it = grouped.constBegin(); it != grouped.constEnd(); ++it) {
+        Message message;
+        message.id = it.key();
+        message.first = m_extractors.size();
+        message.count = it.value().size();
+        m_extractors += it.value();
+
+        const int index = m_messages.size();
+        m_messages.append(message);
+        if (!(message.id & CanFrame::ExtendedFlag) && message.id < kStandardIdCount)
+            m_standardIndex[message.id] = qint16(index);
+        else
+            m_extendedIndex.insert(message.id | CanFrame::ExtendedFlag, index);
+    }
+
+    qDebug() << "CanSignalDecoder: compiled" << m_extractors.size() << "signals in"
+             << m_messages.size() << "messages";
+    return !m_messages.isEmpty();
+}
+
+QVector<quint32> CanSignalDecoder::messageIds() const
+{
+    QVector<quint32> ids;
+    ids.reserve(m_messages.size());
+    for (const auto &message : m_messages)
+        ids.append(message.id);
+    return ids;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtEndian>
+
+#include <cstring>
+
+// 一個 classic CAN 幀（資料長度 <= 8，不足的位元組補 0）
+struct CanFrame {
+    quint32 id = 0;          // 11/29-bit ID；擴充幀帶 CanFrame::ExtendedFlag（與 SocketCAN 的 CAN_EFF_FLAG 相同）
+    quint8 length = 0;
+    quint8 data[8] = {};
+    qint64 timestampUs = 0;
+
+    static constexpr quint32 ExtendedFlag = 0x80000000u;
+};
+
+/**
+ * DbcDatabase
+ *
+ * DBC 檔案的最小解析器：只讀取 BO_（訊息）與 SG_（訊號）定義。
+ * 解析只在啟動時做一次，結果交給 CanSignalDecoder 編譯成解碼表。
+ */
+class DbcDatabase {
+public:
+    struct SignalInfo {
+        quint32 messageId = 0;   // 含 CanFrame::ExtendedFlag
+        QString messageName;
+        QString name;
+        int startBit = 0;
+        int length = 0;
+        bool bigEndian = false;  // @0 = Motorola
+        bool isSigned = false;
+        bool multiplexed = false;
+        double factor = 1.0;
+        double offset = 0.0;
+        QString unit;
+    };
+
+    bool loadFromFile(const QString &filePath, QString *errorString = nullptr);
+    bool parse(const QByteArray &text, QString *errorString = nullptr);
+
+    const QVector<SignalInfo> &signalInfos() const { return m_signals; }
+    int messageCount() const { return m_messageCount; }
+
+private:
+    QVector<SignalInfo> m_signals;
+    int m_messageCount = 0;
+};
+
+/**
+ * CanSignalDecoder
+ *
+ * 把 DBC 的訊號定義「預先編譯」成逐訊息 ID 的位元擷取表：
+ * 每個訊號只剩 (shift, mask, 符號位, factor, offset)，解碼一幀只要
+ * 一次 64-bit 載入（Intel 或 Motorola）加上每個訊號一次 shift/and/乘加，
+ * 不需要在熱路徑上逐 bit 解讀 DBC 定義。
+ *
+ * 只編譯有對應到 hub 訊號的 DBC 訊號，其他訊號完全不進解碼表。
+ */
+class CanSignalDecoder {
+public:
+    struct Extractor {
+        quint64 mask = 0;
+        quint64 signBit = 0;     // 0 = 無號
+        double factor = 1.0;
+        double offset = 0.0;
+        int targetId = -1;       // VehicleSignalHub 的訊號 id
+        quint8 shift = 0;
+        quint8 minLength = 0;    // 幀至少要有幾個位元組才能解這個訊號
+        bool bigEndian = false;
+    };
+
+    // signalMap：DBC 訊號名稱 → hub 訊號 id
+    bool compile(const DbcDatabase &db, const QHash<QString, int> &signalMap);
+
+    bool isEmpty() const { return m_messages.isEmpty(); }
+    int extractorCount() const { return m_extractors.size(); }
+    QVector<quint32> messageIds() const;
+
+    // 熱路徑：對每個解出的訊號呼叫 sink(targetId, value)，回傳解出的訊號數
+    template <typename Sink>
+    int decode(const CanFrame &frame, Sink &&sink) const
+    {
+        int index = -1;
+        if (!(frame.id & CanFrame::ExtendedFlag)) {
+            if (frame.id >= kStandardIdCount)
+                return 0;
+            index = m_standardIndex[frame.id];
+        } else {
+            const auto it = m_extendedIndex.constFind(frame.id);
+            if (it == m_extendedIndex.constEnd())
+                return 0;
+            index = it.value();
+        }
+        if (index < 0)
+            return 0;
+
+        const Message &message = m_messages.at(index);
+        const quint64 little = qFromLittleEndian<quint64>(frame.data);
+        const quint64 big = qFromBigEndian<quint64>(frame.data);
+        const Extractor *x = m_extractors.constData() + message.first;
+        const Extractor *end = x + message.count;
+        int decoded = 0;
+        for (; x != end; ++x) {
+            if (frame.length < x->minLength)
+                continue;
+            const quint64 raw = ((x->bigEndian ? big : little) >> x->shift) & x->mask;
+            // (raw ^ s) - s：把 length-bit 的二補數延伸成 64-bit
+            const double value = x->signBit
+                    ? double(qint64((raw ^ x->signBit) - x->signBit))
+                    : double(raw);
+            sink(x->targetId, value * x->factor + x->offset);
+            ++decoded;
+        }
+        return decoded;
+    }
+
+private:
+    struct Message {
+        quint32 id = 0;
+        int first = 0;
+        int count = 0;
+    };
+
+    static constexpr quint32 kStandardIdCount = 2048;
+
+    QVector<Extractor> m_extractors;         // 依訊息分段連續存放
+    QVector<Message> m_messages;
+    QVector<qint16> m_standardIndex;         // 11-bit ID 直接查表
+    QHash<quint32, int> m_extendedIndex;     // 29-bit ID 用 hash
+};
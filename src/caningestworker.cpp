@@ -0,0 +1,335 @@
+#include "caningestworker.h"
+#include "vehiclesignalhub.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+
+// candump log 的時間間隔可能很長：分段睡，stop() 才不會被卡住
+constexpr qint64 MaxSleepSliceUs = 50000;
+
+QString resolvePath(const QString &path, const QString &baseDir)
+{
+    if (path.isEmpty() || QFileInfo(path).isAbsolute())
+        return path;
+    const QString candidate = QDir(baseDir).absoluteFilePath(path);
+    return QFileInfo::exists(candidate) ? candidate : path;
+}
+
+inline int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+CanIngestWorker *CanIngestWorker::fromConfig(const QJsonObject &canConfig, VehicleSignalHub *hub,
+                                             const QString &baseDir, QObject *parent)
+{
+    QString dbcPath = qEnvironmentVariable("SMART_DASHBOARD_DBC", canConfig.value("dbc").toString());
+    QString interfaceName = qEnvironmentVariable("SMART_DASHBOARD_CAN_IF", canConfig.value("interface").toString());
+    QString logFile = qEnvironmentVariable("SMART_DASHBOARD_CAN_LOG", canConfig.value("log").toString());
+
+    if (dbcPath.isEmpty() || (interfaceName.isEmpty() && logFile.isEmpty())) {
+        qDebug() << "CanIngestWorker: no CAN source configured";
+        return nullptr;
+    }
+    dbcPath = resolvePath(dbcPath, baseDir);
+    logFile = resolvePath(logFile, baseDir);
+
+    DbcDatabase db;
+    QString error;
+    if (!db.loadFromFile(dbcPath, &error)) {
+        qWarning() << "CanIngestWorker:" << error;
+        return nullptr;
+    }
+
+    // DBC 訊號名 → hub 訊號 id；沒給對照表時，DBC 名稱與 hub 名稱相同者直接對應
+    QHash<QString, int> signalMap;
+    const QJsonObject mapping = canConfig.value("signals").toObject();
+    if (!mapping.isEmpty()) {
+        for (auto it = mapping.constBegin(); it != mapping.constEnd(); ++it)
+            signalMap.insert(it.key(), hub->registerSignal(it.value().toString()));
+    } else {
+        for (const auto &info : db.signalInfos()) {
+            const int id = hub->signalId(info.name);
+            if (id >= 0)
+                signalMap.insert(info.name, id);
+        }
+    }
+
+    CanSignalDecoder decoder;
+    if (!decoder.compile(db, signalMap)) {
+        qWarning() << "CanIngestWorker: none of the mapped signals exist in" << dbcPath;
+        return nullptr;
+    }
+
+    auto *worker = new CanIngestWorker(std::move(decoder), hub, parent);
+    worker->setInterfaceName(logFile.isEmpty() ? interfaceName : QString());
+    worker->setLogFile(logFile);
+    worker->setRealtime(canConfig.value("realtime").toBool(true));
+    worker->setLoop(canConfig.value("loop").toBool(false));
+    qDebug() << "CanIngestWorker: DBC" << dbcPath << "source"
+             << (logFile.isEmpty() ? interfaceName : logFile);
+    return worker;
+}
+
+CanIngestWorker::CanIngestWorker(CanSignalDecoder decoder, VehicleSignalHub *hub, QObject *parent)
+    : QThread(parent)
+    , m_decoder(std::move(decoder))
+    , m_hub(hub)
+{
+    setObjectName(QStringLiteral("CanIngestWorker"));
+}
+
+CanIngestWorker::~CanIngestWorker()
+{
+    stop();
+}
+
+void CanIngestWorker::stop()
+{
+    requestInterruption();
+    wait();
+}
+
+void CanIngestWorker::run()
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    if (!m_logFile.isEmpty())
+        runLogFile();
+    else
+        runSocketCan();
+
+    const double seconds = qMax<qint64>(1, elapsed.elapsed()) / 1000.0;
+    qDebug() << "CanIngestWorker: finished," << framesRead() << "frames,"
+             << signalsDecoded() << "signals," << qRound(framesRead() / seconds) << "frames/s";
+}
+
+void CanIngestWorker::processFrame(const CanFrame &frame)
+{
+    m_framesRead.fetch_add(1, std::memory_order_relaxed);
+    const int decoded = m_decoder.decode(frame, [this, &frame](int targetId, double value) {
+        m_hub->publish(targetId, value, frame.timestampUs);
+    });
+    if (decoded)
+        m_signalsDecoded.fetch_add(decoded, std::memory_order_relaxed);
+}
+
+// candump -l 格式："(1436509052.249713) can0 0C4#2A366C2BBA" / 擴充幀 8 位 ID
+bool CanIngestWorker::parseCandumpLine(const char *line, int length, CanFrame &frame, double &timestampSec)
+{
+    const char *p = line;
+    const char *end = line + length;
+
+    while (p < end && *p == ' ')
+        ++p;
+    if (p >= end || *p != '(')
+        return false;
+    char *tsEnd = nullptr;
+    timestampSec = std::strtod(p + 1, &tsEnd);
+    if (!tsEnd || tsEnd >= end || *tsEnd != ')')
+        return false;
+    p = tsEnd + 1;
+
+    // 介面名稱
+    while (p < end && *p == ' ')
+        ++p;
+    while (p < end && *p != ' ')
+        ++p;
+    while (p < end && *p == ' ')
+        ++p;
+
+    // ID
+    quint32 id = 0;
+    int idDigits = 0;
+    for (; p < end && *p != '#'; ++p, ++idDigits) {
+        const int v = hexValue(*p);
+        if (v < 0)
+            return false;
+        id = (id << 4) | quint32(v);
+    }
+    if (p >= end || idDigits == 0)
+        return false;
+    ++p; // '#'
+
+    // 遠端幀或 CAN FD（"##"）不處理
+    if (p < end && (*p == 'R' || *p == '#'))
+        return false;
+
+    frame = CanFrame();
+    frame.id = idDigits > 3 ? (id | CanFrame::ExtendedFlag) : id;
+    while (p + 1 < end && frame.length < 8) {
+        const int hi = hexValue(p[0]);
+        const int lo = hexValue(p[1]);
+        if (hi < 0 || lo < 0)
+            break;
+        frame.data[frame.length++] = quint8((hi << 4) | lo);
+        p += 2;
+    }
+    return true;
+}
+
+void CanIngestWorker::runLogFile()
+{
+    QFile file(m_logFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "CanIngestWorker: cannot open log" << m_logFile << file.errorString();
+        return;
+    }
+
+    char line[256];
+    do {
+        file.seek(0);
+        // 以 log 中第一幀的時間為起點，照原始間隔播放
+        double firstTs = -1.0;
+        const qint64 startUs = VehicleSignalHub::nowUs();
+        qint64 lines = 0;
+
+        while (!isInterruptionRequested()) {
+            const qint64 n = file.readLine(line, sizeof(line));
+            if (n <= 0)
+                break;
+
+            CanFrame frame;
+            double ts = 0.0;
+            if (!parseCandumpLine(line, int(n), frame, ts))
+                continue;
+
+            if (firstTs < 0)
+                firstTs = ts;
+            const qint64 offsetUs = qint64((ts - firstTs) * 1e6);
+            if (m_realtime) {
+                qint64 aheadUs = startUs + offsetUs - VehicleSignalHub::nowUs();
+                while (aheadUs > 1000 && !isInterruptionRequested()) {
+                    QThread::usleep(quint64(qMin(aheadUs, MaxSleepSliceUs)));
+                    aheadUs = startUs + offsetUs - VehicleSignalHub::nowUs();
+                }
+                if (isInterruptionRequested())
+                    break;
+            }
+            frame.timestampUs = startUs + offsetUs;
+            processFrame(frame);
+            ++lines;
+        }
+        if (lines == 0)
+            break;
+    } while (m_loop && !isInterruptionRequested());
+}
+
+void CanIngestWorker::runSocketCan()
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        qWarning() << "CanIngestWorker: socket(PF_CAN) failed:" << std::strerror(errno);
+        return;
+    }
+
+    ifreq ifr{};
+    const QByteArray name = m_interfaceName.toLocal8Bit();
+    std::strncpy(ifr.ifr_name, name.constData(), IFNAMSIZ - 1);
+    if (::ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        qWarning() << "CanIngestWorker: unknown CAN interface" << m_interfaceName;
+        ::close(fd);
+        return;
+    }
+
+    // 讓核心只把 DBC 有用到的 ID 交上來，其餘幀不會喚醒這個執行緒
+    const QVector<quint32> ids = m_decoder.messageIds();
+    QVector<can_filter> filters;
+    filters.reserve(ids.size());
+    for (const quint32 id : ids) {
+        can_filter f{};
+        if (id & CanFrame::ExtendedFlag) {
+            f.can_id = (id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+            f.can_mask = CAN_EFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG;
+        } else {
+            f.can_id = id;
+            f.can_mask = CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG;
+        }
+        filters.append(f);
+    }
+    ::setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters.constData(),
+                 socklen_t(filters.size() * sizeof(can_filter)));
+
+    // 收不到資料時每 200 ms 醒來一次檢查是否要結束
+    timeval timeout{0, 200 * 1000};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        qWarning() << "CanIngestWorker: bind failed:" << std::strerror(errno);
+        ::close(fd);
+        return;
+    }
+    qDebug() << "CanIngestWorker: listening on" << m_interfaceName << "with" << filters.size() << "filters";
+
+    // 一次系統呼叫收一批幀，4000 frames/s 時大幅減少 syscall 次數
+    constexpr int kBatch = 32;
+    can_frame raw[kBatch];
+    iovec iov[kBatch];
+    mmsghdr msgs[kBatch];
+    for (int i = 0; i < kBatch; ++i) {
+        iov[i] = {&raw[i], sizeof(can_frame)};
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (!isInterruptionRequested()) {
+        const int n = ::recvmmsg(fd, msgs, kBatch, MSG_WAITFORONE, nullptr);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                continue;
+            qWarning() << "CanIngestWorker: recvmmsg failed:" << std::strerror(errno);
+            break;
+        }
+        const qint64 now = VehicleSignalHub::nowUs();
+        for (int i = 0; i < n; ++i) {
+            const can_frame &in = raw[i];
+            if (in.can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG))
+                continue;
+            CanFrame frame;
+            frame.id = (in.can_id & CAN_EFF_FLAG) ? ((in.can_id & CAN_EFF_MASK) | CanFrame::ExtendedFlag)
+                                                  : (in.can_id & CAN_SFF_MASK);
+            frame.length = qMin<quint8>(in.can_dlc, 8);
+            std::memcpy(frame.data, in.data, frame.length);
+            frame.timestampUs = now;
+            processFrame(frame);
+        }
+    }
+    ::close(fd);
+#else
+    qWarning() << "CanIngestWorker: SocketCAN is only available on Linux, interface" << m_interfaceName << "ignored";
+#endif
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QThread>
+
+#include <atomic>
+
+#include "candecoder.h"
+
+class VehicleSignalHub;
+
+/**
+ * CanIngestWorker
+ *
+ * 在獨立執行緒上讀取 CAN 幀、用預編譯的 DBC 解碼表解出訊號，再丟進 VehicleSignalHub。
+ *
+ * 兩種來源：
+ * - SocketCAN 介面（例如 can0 / vcan0），只在 Linux 上可用；核心層會依 DBC 裡用到的 ID 過濾
+ * - candump 的 log 檔（candump -l 格式），不需要硬體即可測試；可照原始時間戳播放或全速播放
+ *
+ * config.json：
+ *   "vehicle": { "can": { "dbc": "...", "interface": "can0" 或 "log": "...",
+ *                         "realtime": true, "loop": false,
+ *                         "signals": { "<DBC 訊號名>": "<hub 訊號名>" } } }
+ * 環境變量 SMART_DASHBOARD_DBC / SMART_DASHBOARD_CAN_IF / SMART_DASHBOARD_CAN_LOG 可覆蓋設定。
+ */
+class CanIngestWorker : public QThread {
+    Q_OBJECT
+
+public:
+    // 依設定建立 worker；沒有設定來源或 DBC 無法使用時回傳 nullptr（必須在 GUI 執行緒呼叫）
+    static CanIngestWorker *fromConfig(const QJsonObject &canConfig, VehicleSignalHub *hub,
+                                       const QString &baseDir, QObject *parent = nullptr);
+
+    CanIngestWorker(CanSignalDecoder decoder, VehicleSignalHub *hub, QObject *parent = nullptr);
+    ~CanIngestWorker() override;
+
+    void setInterfaceName(const QString &name) { m_interfaceName = name; }
+    void setLogFile(const QString &path) { m_logFile = path; }
+    void setRealtime(bool realtime) { m_realtime = realtime; }
+    void setLoop(bool loop) { m_loop = loop; }
+
+    quint64 framesRead() const { return m_framesRead.load(std::memory_order_relaxed); }
+    quint64 signalsDecoded() const { return m_signalsDecoded.load(std::memory_order_relaxed); }
+
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    void runLogFile();
+    void runSocketCan();
+    void processFrame(const CanFrame &frame);
+
+    static bool parseCandumpLine(const char *line, int length, CanFrame &frame, double &timestampSec);
+
+    CanSignalDecoder m_decoder;
+    VehicleSignalHub *m_hub;
+    QString m_interfaceName;
+    QString m_logFile;
+    bool m_realtime = true;
+    bool m_loop = false;
+
+    std::atomic<quint64> m_framesRead{0};
+    std::atomic<quint64> m_signalsDecoded{0};
+};
@@ -0,0 +1,407 @@
+#include "clientframestats.h"
+
+#include "surfaceregistry.h"
+
+#include <QQuickWindow>
+
+#include <QtWaylandCompositor/QWaylandClient>
+#include <QtWaylandCompositor/QWaylandCompositor>
+#include <QtWaylandCompositor/QWaylandOutput>
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandView>
+#include <QtWaylandCompositor/QWaylandXdgToplevel>
+
+#include <chrono>
+
+#ifdef SMART_DASHBOARD_HAVE_PRESENTATION_TIME
+// wp_presentation 的 compositor 端實作只在私有標頭（Qt6::WaylandCompositorPrivate）
+#include <QtWaylandCompositor/private/qwaylandpresentationtime_p.h>
+#endif
+
+namespace {
+
+// Linux 上 steady_clock 就是 CLOCK_MONOTONIC，與 Qt 的 wp_presentation 宣告的 clock_id 相同
+qint64 nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+ClientFrameStats::ClientFrameStats(SurfaceRegistry *registry, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_registry(registry)
+{
+    m_refreshTimer.setInterval(RefreshMs);
+    m_refreshTimer.setTimerType(Qt::CoarseTimer);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &ClientFrameStats::refresh);
+    m_sinceRefresh.start();
+}
+
+ClientFrameStats::~ClientFrameStats()
+{
+    // render 執行緒的訊號是 DirectConnection，先斷開再讓成員失效
+    removeAllDisplays();
+    qDeleteAll(m_rows);
+}
+
+int ClientFrameStats::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant ClientFrameStats::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size())
+        return QVariant();
+
+    const Client *client = m_rows.at(index.row());
+    switch (role) {
+    case ClientPidRole:
+        return client->pid;
+    case AppIdRole:
+        return appIdFor(client);
+    case SurfaceCountRole:
+        return int(client->surfaces.size());
+    case CommitsRole:
+        return double(client->commits);
+    case CommitRateRole:
+        return client->commitRate;
+    case PresentedRole:
+        return double(client->presented);
+    case SupersededRole:
+        return double(client->superseded);
+    case LatencyAvgRole:
+        return client->latency.meanMs();
+    case LatencyP95Role:
+        return client->latency.percentileMs(0.95);
+    case LatencyMaxRole:
+        return client->latency.maxMs();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ClientFrameStats::roleNames() const
+{
+    return {
+        {ClientPidRole, "clientPid"},
+        {AppIdRole, "appId"},
+        {SurfaceCountRole, "surfaceCount"},
+        {CommitsRole, "commits"},
+        {CommitRateRole, "commitRate"},
+        {PresentedRole, "presented"},
+        {SupersededRole, "superseded"},
+        {LatencyAvgRole, "latencyAvgMs"},
+        {LatencyP95Role, "latencyP95Ms"},
+        {LatencyMaxRole, "latencyMaxMs"},
+    };
+}
+
+void ClientFrameStats::setCompositor(QWaylandCompositor *compositor)
+{
+    if (m_compositor == compositor)
+        return;
+    if (m_compositor)
+        disconnect(m_compositor, nullptr, this, nullptr);
+    if (m_presentationTime) {
+        m_presentationTime->deleteLater();
+        m_presentationTime.clear();
+    }
+    removeAllDisplays();
+    m_compositor = compositor;
+
+#ifdef SMART_DASHBOARD_HAVE_PRESENTATION_TIME
+    // 與 QWaylandXdgShell 相同，以 compositor 為容器建立擴充，compositor create() 時註冊 global
+    if (m_compositor)
+        m_presentationTime = new QWaylandPresentationTime(m_compositor);
+#endif
+    emit protocolEnabledChanged();
+
+    if (m_compositor)
+        m_refreshTimer.start();
+    else
+        m_refreshTimer.stop();
+}
+
+ClientFrameStats::Display *ClientFrameStats::displayFor(QWaylandSurface *surface)
+{
+    // 實際顯示這個 surface 的 output；還沒有 view（剛建立）時先算在 cluster（defaultOutput）
+    const QWaylandView *view = surface->primaryView();
+    QWaylandOutput *output = view ? view->output() : nullptr;
+    if (!output && m_compositor)
+        output = m_compositor->defaultOutput();
+    if (!output)
+        return nullptr;
+
+    if (Display *display = m_displays.value(output))
+        return display;
+
+    auto *display = new Display;
+    display->output = output;
+    m_displays.insert(output, display);
+    connect(output, &QWaylandOutput::windowChanged, this, [this, display] {
+        detachWindow(display);
+        attachWindow(display);
+    });
+    // 例如 center 的 Loader 停用
+    connect(output, &QObject::destroyed, this, [this, output] { removeDisplay(output); });
+    attachWindow(display);
+    return display;
+}
+
+void ClientFrameStats::attachWindow(Display *display)
+{
+    display->window = display->output ? qobject_cast<QQuickWindow *>(display->output->window()) : nullptr;
+    if (!display->window)
+        return;
+
+    // threaded render loop 時這兩個訊號在該視窗的 render 執行緒發出，必須 DirectConnection（同 FrameStats）
+    connect(display->window, &QQuickWindow::beforeSynchronizing, this,
+            [this, display] { onBeforeSynchronizing(display); }, Qt::DirectConnection);
+    connect(display->window, &QQuickWindow::frameSwapped, this,
+            [this, display] { onFrameSwapped(display); }, Qt::DirectConnection);
+}
+
+void ClientFrameStats::detachWindow(Display *display)
+{
+    if (display->window)
+        disconnect(display->window, nullptr, this, nullptr);
+    display->window.clear();
+}
+
+void ClientFrameStats::removeDisplay(QWaylandOutput *output)
+{
+    Display *display = m_displays.take(output);
+    if (!display)
+        return;
+    detachWindow(display);
+    if (display->output)
+        disconnect(display->output, nullptr, this, nullptr);
+    // 這個視窗已經不會再 swap，等它的 commit 不會有結果
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->display == display)
+            it = m_pending.erase(it);
+        else
+            ++it;
+    }
+    delete display;
+}
+
+void ClientFrameStats::removeAllDisplays()
+{
+    const QList<QWaylandOutput *> outputs = m_displays.keys();
+    for (QWaylandOutput *output : outputs)
+        removeDisplay(output);
+}
+
+void ClientFrameStats::addSurface(QWaylandSurface *surface)
+{
+    if (!surface || !surface->client())
+        return;
+    Client *client = clientFor(surface->client());
+    if (client->surfaces.contains(surface))
+        return;
+    client->surfaces.insert(surface);
+    client->dirty = true;
+
+    // redraw：每次 commit 都會發出（含不帶 buffer 的 commit，onCommit 內以 hasContent 過濾）
+    connect(surface, &QWaylandSurface::redraw, this, [this, surface] { onCommit(surface); });
+    connect(surface, &QWaylandSurface::surfaceDestroyed, this, [this, surface] { removeSurface(surface); });
+    connect(surface, &QObject::destroyed, this, [this, surface] { removeSurface(surface); });
+}
+
+ClientFrameStats::Client *ClientFrameStats::clientFor(QWaylandClient *waylandClient)
+{
+    if (Client *client = m_clients.value(waylandClient))
+        return client;
+
+    auto *client = new Client;
+    client->client = waylandClient;
+    client->pid = waylandClient->processId();
+    m_clients.insert(waylandClient, client);
+    connect(waylandClient, &QObject::destroyed, this, [this, waylandClient] { removeClient(waylandClient); });
+
+    const int row = m_rows.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.append(client);
+    endInsertRows();
+    emit countChanged();
+    return client;
+}
+
+void ClientFrameStats::removeClient(QWaylandClient *waylandClient)
+{
+    Client *client = m_clients.take(waylandClient);
+    if (!client)
+        return;
+
+    for (QWaylandSurface *surface : std::as_const(client->surfaces)) {
+        disconnect(surface, nullptr, this, nullptr);
+        m_pending.remove(surface);
+    }
+    const int row = m_rows.indexOf(client);
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.remove(row);
+    endRemoveRows();
+    delete client;
+    emit countChanged();
+}
+
+void ClientFrameStats::removeSurface(QWaylandSurface *surface)
+{
+    m_pending.remove(surface);
+    disconnect(surface, nullptr, this, nullptr);
+    for (Client *client : std::as_const(m_rows)) {
+        if (client->surfaces.remove(surface)) {
+            client->dirty = true;
+            break;
+        }
+    }
+}
+
+void ClientFrameStats::onCommit(QWaylandSurface *surface)
+{
+    // 不帶 buffer 的 commit（unmap）不算
+    if (!surface->hasContent())
+        return;
+    Client *client = m_clients.value(surface->client());
+    if (!client)
+        return;
+
+    ++client->commits;
+    client->dirty = true;
+
+    Display *display = displayFor(surface);
+    if (!display)
+        return;
+
+    // GUI 執行緒正在處理 commit，表示該視窗還沒進入下一次 sync；這個 buffer 最早出現在下一個序號的幀
+    const quint64 target = display->syncSequence.load(std::memory_order_acquire) + 1;
+    auto it = m_pending.find(surface);
+    if (it != m_pending.end()) {
+        // 上一個 buffer 還沒送上畫面就被換掉（surface 換了 output 時序號改用新視窗的）
+        ++client->superseded;
+        it->display = display;
+        it->commitUs = nowUs();
+        it->targetSequence = target;
+        return;
+    }
+    m_pending.insert(surface, PendingCommit{client, display, nowUs(), target});
+}
+
+void ClientFrameStats::onBeforeSynchronizing(Display *display)
+{
+    display->renderSequence = display->syncSequence.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void ClientFrameStats::onFrameSwapped(Display *display)
+{
+    // 沒有經過 sync 的 frameSwapped（例如視窗剛 expose）不計入
+    if (display->renderSequence == 0)
+        return;
+    const quint64 sequence = display->renderSequence;
+    const qint64 presentedUs = nowUs();
+    display->renderSequence = 0;
+    // 排回 GUI 執行緒時 Display 可能已被移除，以 output 重新查
+    QPointer<QWaylandOutput> output = display->output;
+    QMetaObject::invokeMethod(this, [this, output, sequence, presentedUs] {
+        if (output)
+            onPresented(output, sequence, presentedUs);
+    }, Qt::QueuedConnection);
+}
+
+void ClientFrameStats::onPresented(QWaylandOutput *output, quint64 sequence, qint64 presentedUs)
+{
+    Display *display = m_displays.value(output);
+    if (!display)
+        return;
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->display != display || it->targetSequence > sequence) {
+            ++it;
+            continue;
+        }
+        Client *client = it->client;
+        client->latency.record(presentedUs - it->commitUs);
+        ++client->presented;
+        client->dirty = true;
+        it = m_pending.erase(it);
+    }
+
+#ifdef SMART_DASHBOARD_HAVE_PRESENTATION_TIME
+    // wp_presentation_feedback.presented：顯示在這個視窗、這一幀之前 commit 的 surface 收到這個時間
+    if (m_presentationTime && display->window) {
+        static_cast<QWaylandPresentationTime *>(m_presentationTime.data())
+            ->sendFeedback(display->window, sequence, quint64(presentedUs / 1000000),
+                           quint32(presentedUs % 1000000) * 1000);
+    }
+#endif
+}
+
+void ClientFrameStats::refresh()
+{
+    const qint64 elapsedMs = m_sinceRefresh.restart();
+    for (int row = 0; row < m_rows.size(); ++row) {
+        Client *client = m_rows.at(row);
+        const double rate = elapsedMs > 0
+            ? double(client->commits - client->commitsAtRefresh) * 1000.0 / double(elapsedMs) : 0.0;
+        client->commitsAtRefresh = client->commits;
+        if (!client->dirty && qFuzzyCompare(client->commitRate + 1.0, rate + 1.0))
+            continue;
+        client->commitRate = rate;
+        client->dirty = false;
+        const QModelIndex modelIndex = index(row);
+        emit dataChanged(modelIndex, modelIndex);
+    }
+}
+
+void ClientFrameStats::reset()
+{
+    for (Client *client : std::as_const(m_rows)) {
+        client->commits = 0;
+        client->presented = 0;
+        client->superseded = 0;
+        client->commitsAtRefresh = 0;
+        client->commitRate = 0.0;
+        client->latency.reset();
+    }
+    m_pending.clear();
+    m_sinceRefresh.restart();
+    if (!m_rows.isEmpty())
+        emit dataChanged(index(0), index(m_rows.size() - 1));
+}
+
+QString ClientFrameStats::appIdFor(const Client *client) const
+{
+    // 同一個 client 的第一個有 app_id 的 toplevel
+    for (QWaylandSurface *surface : client->surfaces) {
+        QWaylandXdgToplevel *toplevel = m_registry->toplevelFor(surface);
+        if (toplevel && !toplevel->appId().isEmpty())
+            return toplevel->appId();
+    }
+    return QString();
+}
+
+QJsonObject ClientFrameStats::clientJson(const Client *client) const
+{
+    return QJsonObject{
+        {QStringLiteral("pid"), double(client->pid)},
+        {QStringLiteral("appId"), appIdFor(client)},
+        {QStringLiteral("surfaces"), int(client->surfaces.size())},
+        {QStringLiteral("commits"), double(client->commits)},
+        {QStringLiteral("commitRate"), client->commitRate},
+        {QStringLiteral("presented"), double(client->presented)},
+        {QStringLiteral("superseded"), double(client->superseded)},
+        {QStringLiteral("latency"), client->latency.toJson()},
+    };
+}
+
+QJsonArray ClientFrameStats::toJson() const
+{
+    QJsonArray clients;
+    for (const Client *client : m_rows)
+        clients.append(clientJson(client));
+    return clients;
+}
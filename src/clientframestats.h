@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+
+#include "framehistogram.h"
+
+class QQuickWindow;
+class QWaylandClient;
+class QWaylandCompositor;
+class QWaylandOutput;
+class QWaylandSurface;
+class SurfaceRegistry;
+
+/**
+ * ClientFrameStats
+ *
+ * compositor 端的逐 client 幀統計（QML 中以 xdgShellHelper.clientStats 取得，一個 client 一列），
+ * 用來分辨 app 卡頓是 app 自己畫得慢，還是儀表的 compositor 沒把畫面送上去：
+ *
+ * - commitRate：每秒帶內容的 commit 數（RefreshMs 更新一次）
+ * - superseded：還沒出現在畫面上就被下一次 commit 取代的 buffer（client 畫太快，或 compositor 沒跟上）
+ * - latency*：commit → 帶著這個 buffer 的場景 frameSwapped 的時間
+ *
+ * 判斷方式：commit 時記下「顯示這個 surface 的視窗的下一次 sync 序號」，render 執行緒在 beforeSynchronizing
+ * 遞增序號、frameSwapped 時把序號與時間排回 GUI 執行緒，序號已到的 commit 就算送上畫面。
+ * 每個 output（cluster、center ...）的視窗有自己的 render 執行緒與序號，surface 依它的 primary view
+ * 所在的 output 歸到該視窗（OutputPlacement 決定由哪個 output 的 Repeater 建立 view）；
+ * 第一次有 surface 在某個 output 上 commit 時才開始追蹤那個視窗。
+ *
+ * 編譯時有 Qt6::WaylandCompositorPrivate 時同時提供 wp_presentation（presentation-time 協定），
+ * 每個視窗 frameSwapped 時把時間（CLOCK_MONOTONIC）回報給該視窗上的 client；protocolEnabled 表示是否有這個協定。
+ */
+class ClientFrameStats : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(bool protocolEnabled READ protocolEnabled NOTIFY protocolEnabledChanged)
+
+public:
+    static constexpr int RefreshMs = 1000;
+
+    enum Roles {
+        ClientPidRole = Qt::UserRole + 1,
+        AppIdRole,
+        SurfaceCountRole,
+        CommitsRole,
+        CommitRateRole,
+        PresentedRole,
+        SupersededRole,
+        LatencyAvgRole,
+        LatencyP95Role,
+        LatencyMaxRole,
+    };
+    Q_ENUM(Roles)
+
+    explicit ClientFrameStats(SurfaceRegistry *registry, QObject *parent = nullptr);
+    ~ClientFrameStats() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_rows.size(); }
+    bool protocolEnabled() const { return !m_presentationTime.isNull(); }
+
+    // 由 XdgShellHelper 呼叫
+    void setCompositor(QWaylandCompositor *compositor);
+    void addSurface(QWaylandSurface *surface);
+
+    Q_INVOKABLE QJsonArray toJson() const;
+    Q_INVOKABLE void reset();
+
+signals:
+    void countChanged();
+    void protocolEnabledChanged();
+
+private:
+    struct Client {
+        QWaylandClient *client = nullptr;
+        qint64 pid = 0;
+        QSet<QWaylandSurface *> surfaces;
+        quint64 commits = 0;
+        quint64 presented = 0;
+        quint64 superseded = 0;
+        quint64 commitsAtRefresh = 0;
+        double commitRate = 0.0;
+        FrameHistogram latency;
+        bool dirty = false;
+    };
+
+    // 一個 output 一份：視窗與它的 sync 序號
+    struct Display {
+        QPointer<QWaylandOutput> output;
+        QPointer<QQuickWindow> window;
+        std::atomic<quint64> syncSequence{0};
+        quint64 renderSequence = 0;   // 只在該視窗的 render 執行緒上讀寫
+    };
+
+    struct PendingCommit {
+        Client *client = nullptr;
+        Display *display = nullptr;
+        qint64 commitUs = 0;
+        quint64 targetSequence = 0;
+    };
+
+    Display *displayFor(QWaylandSurface *surface);
+    void attachWindow(Display *display);
+    void detachWindow(Display *display);
+    void removeDisplay(QWaylandOutput *output);
+    void removeAllDisplays();
+    Client *clientFor(QWaylandClient *client);
+    void removeClient(QWaylandClient *client);
+    void removeSurface(QWaylandSurface *surface);
+    void onCommit(QWaylandSurface *surface);
+    void onPresented(QWaylandOutput *output, quint64 sequence, qint64 presentedUs);
+    void refresh();
+    QString appIdFor(const Client *client) const;
+    QJsonObject clientJson(const Client *client) const;
+
+    // 各視窗的 render 執行緒上
+    void onBeforeSynchronizing(Display *display);
+    void onFrameSwapped(Display *display);
+
+    SurfaceRegistry *m_registry;
+    QPointer<QWaylandCompositor> m_compositor;
+    QPointer<QObject> m_presentationTime;   // QWaylandPresentationTime（私有 API，只在 .cpp 中使用型別）
+
+    QHash<QWaylandClient *, Client *> m_clients;
+    QVector<Client *> m_rows;
+    QHash<QWaylandSurface *, PendingCommit> m_pending;
+    QHash<QWaylandOutput *, Display *> m_displays;
+
+    QTimer m_refreshTimer;
+    QElapsedTimer m_sinceRefresh;
+};
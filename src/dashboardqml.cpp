@@ -0,0 +1,83 @@
+#include "dashboardqml.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QQmlContext>
+#include <QtQml>
+
+#include "AppConfig.h"
+#include "datagramingestworker.h"
+#include "framestats.h"
+#include "hexframeitem.h"
+#include "numericreadout.h"
+#include "segmentedbargauge.h"
+#include "staticlayer.h"
+#include "surfaceitem.h"
+#include "surfacesnapshotitem.h"
+#include "vehiclesignalhub.h"
+#include "waydroidmanager.h"
+#include "windowembeditem.h"
+#include "xdgshellhelper.h"
+
+namespace DashboardQml {
+
+void registerTypes()
+{
+    qmlRegisterType<WindowEmbedItem>("SmartDashboard", 1, 0, "WindowEmbedItem");
+    qmlRegisterType<HexFrameItem>("SmartDashboard", 1, 0, "HexFrame");
+    qmlRegisterType<SegmentedBarGauge>("SmartDashboard", 1, 0, "SegmentedBarGauge");
+    qmlRegisterType<NumericReadout>("SmartDashboard", 1, 0, "NumericReadout");
+    qmlRegisterType<StaticLayer>("SmartDashboard", 1, 0, "StaticLayer");
+
+    // 註冊 XdgShellHelper（啟用 XDG Shell 協議，讓 Waydroid 等 client 可以連線）
+    // 注意：不再註冊自定義的 WaylandCompositor，直接使用 QtWayland.Compositor 的
+    qmlRegisterType<XdgShellHelper>("SmartDashboard", 1, 0, "XdgShellHelper");
+    qmlRegisterType<SurfaceItem>("SmartDashboard", 1, 0, "SurfaceItem");
+    qmlRegisterType<SurfaceSnapshotItem>("SmartDashboard", 1, 0, "SurfaceSnapshotItem");
+    qmlRegisterUncreatableType<SurfaceRegistry>("SmartDashboard", 1, 0, "SurfaceRegistry",
+                                                QStringLiteral("SurfaceRegistry 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<SurfaceLaunchTracker>("SmartDashboard", 1, 0, "SurfaceLaunchTracker",
+                                                     QStringLiteral("SurfaceLaunchTracker 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<PackageSurfaceMatcher>("SmartDashboard", 1, 0, "PackageSurfaceMatcher",
+                                                      QStringLiteral("PackageSurfaceMatcher 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<FrameCallbackThrottler>("SmartDashboard", 1, 0, "FrameCallbackThrottler",
+                                                       QStringLiteral("FrameCallbackThrottler 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<ToplevelConfigurator>("SmartDashboard", 1, 0, "ToplevelConfigurator",
+                                                     QStringLiteral("ToplevelConfigurator 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<ClientFrameStats>("SmartDashboard", 1, 0, "ClientFrameStats",
+                                                 QStringLiteral("ClientFrameStats 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<OutputPlacement>("SmartDashboard", 1, 0, "OutputPlacement",
+                                                QStringLiteral("OutputPlacement 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<SurfaceSnapshotCache>("SmartDashboard", 1, 0, "SurfaceSnapshotCache",
+                                                     QStringLiteral("SurfaceSnapshotCache 由 XdgShellHelper 提供"));
+    qmlRegisterUncreatableType<WaydroidSessionMonitor>("SmartDashboard", 1, 0, "WaydroidSessionMonitor",
+                                                       QStringLiteral("WaydroidSessionMonitor 由 WaydroidManager 提供"));
+}
+
+void setContextProperties(QQmlContext *context, const Context &properties)
+{
+    context->setContextProperty("AppConfig", properties.config);
+    context->setContextProperty("Waydroid", properties.waydroid);
+    context->setContextProperty("VehicleSignals", properties.vehicleSignals);
+    context->setContextProperty("FrameStats", properties.frameStats);
+    context->setContextProperty("CenterFrameStats", properties.centerFrameStats);
+    // 遺失 / 延遲統計；沒有設定 datagram 來源時為 null
+    context->setContextProperty("VehicleDatagrams", properties.datagrams);
+    // 暴露 compositor 模式狀態到 QML
+    context->setContextProperty("CompositorModeEnabled", properties.compositorMode);
+}
+
+void applySignalPolicies(const AppConfig &config, VehicleSignalHub *hub)
+{
+    for (const QJsonValue &widget : config.widgets()) {
+        const QJsonObject signalConfig = widget.toObject().value("signal").toObject();
+        const QString name = signalConfig.value("name").toString();
+        if (name.isEmpty())
+            continue;
+        const int id = hub->registerSignal(name);
+        if (id >= 0)
+            hub->setPolicy(id, SignalPolicy::fromJson(signalConfig));
+    }
+}
+
+} // namespace DashboardQml
@@ -0,0 +1,39 @@
+#pragma once
+
+class AppConfig;
+class DatagramIngestWorker;
+class FrameStats;
+class QQmlContext;
+class VehicleSignalHub;
+class WaydroidManager;
+
+/**
+ * DashboardQml
+ *
+ * appSmartDashboard（main.cpp）與 dashboard_bench 共用的 QML 環境設定：
+ * 型別註冊、context property、儀表的訊號顯示政策。兩邊各自抄一份時清單會漂移
+ * （bench 少了 WaydroidSessionMonitor 與部分 context property），所以集中在這裡。
+ */
+namespace DashboardQml {
+
+// DashboardShell.qml 用到的 context property；指標可以是 nullptr（QML 端以 null 判斷）
+struct Context {
+    AppConfig *config = nullptr;
+    WaydroidManager *waydroid = nullptr;
+    VehicleSignalHub *vehicleSignals = nullptr;
+    FrameStats *frameStats = nullptr;
+    FrameStats *centerFrameStats = nullptr;             // 第二個 output（中控螢幕）
+    DatagramIngestWorker *datagrams = nullptr;
+    bool compositorMode = false;
+};
+
+// 註冊 SmartDashboard 1.0 的所有 QML 型別（載入 QML 之前呼叫）
+void registerTypes();
+
+// 設定 context property
+void setContextProperties(QQmlContext *context, const Context &properties);
+
+// 每個儀表的顯示政策：config.json widgets[].signal = {name, deadband, maxRateHz, quantum, truncate}
+void applySignalPolicies(const AppConfig &config, VehicleSignalHub *hub);
+
+} // namespace DashboardQml
@@ -0,0 +1,315 @@
+#include "datagramingestworker.h"
+#include "vehiclesignalhub.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+
+// 落後 expected 這麼多以內視為亂序晚到，超過則視為送端重啟
+constexpr qint32 ReorderWindow = 1024;
+// 一次跳過這麼多以上也視為送端重啟（而不是一口氣記成大量遺失）
+constexpr qint32 RestartThreshold = 1 << 16;
+// 超過這個值的「延遲」代表兩端不是同一個單調時鐘，不納入統計
+constexpr qint64 MaxPlausibleLatencyUs = 10000000;
+
+} // namespace
+
+DatagramIngestWorker *DatagramIngestWorker::fromConfig(const QJsonObject &datagramConfig, VehicleSignalHub *hub,
+                                                       QObject *parent)
+{
+    const QString udp = qEnvironmentVariable("SMART_DASHBOARD_UDP", datagramConfig.value("udp").toString());
+    const QString unixPath = qEnvironmentVariable("SMART_DASHBOARD_UNIX_DGRAM", datagramConfig.value("unix").toString());
+    if (udp.isEmpty() && unixPath.isEmpty()) {
+        qDebug() << "DatagramIngestWorker: no datagram source configured";
+        return nullptr;
+    }
+
+    auto *worker = new DatagramIngestWorker(hub, parent);
+    worker->setUdpAddress(udp);
+    worker->setUnixPath(unixPath);
+
+    // 送端訊號編號 → hub 訊號名；沒給對照表時 0~3 對應內建訊號
+    const QJsonObject mapping = datagramConfig.value("signals").toObject();
+    if (!mapping.isEmpty()) {
+        for (auto it = mapping.constBegin(); it != mapping.constEnd(); ++it) {
+            bool ok = false;
+            const int senderId = it.key().toInt(&ok);
+            if (ok)
+                worker->mapSignal(senderId, hub->registerSignal(it.value().toString()));
+        }
+    } else {
+        for (int id = 0; id < VehicleSignalHub::BuiltinSignalCount; ++id)
+            worker->mapSignal(id, id);
+    }
+    return worker;
+}
+
+DatagramIngestWorker::DatagramIngestWorker(VehicleSignalHub *hub, QObject *parent)
+    : QThread(parent)
+    , m_hub(hub)
+{
+    setObjectName(QStringLiteral("DatagramIngestWorker"));
+    std::fill(std::begin(m_idMap), std::end(m_idMap), -1);
+
+    m_statsTimer.setInterval(500);
+    connect(&m_statsTimer, &QTimer::timeout, this, &DatagramIngestWorker::refreshStats);
+    connect(this, &QThread::started, &m_statsTimer, qOverload<>(&QTimer::start));
+    connect(this, &QThread::finished, &m_statsTimer, &QTimer::stop);
+}
+
+DatagramIngestWorker::~DatagramIngestWorker()
+{
+    stop();
+}
+
+void DatagramIngestWorker::mapSignal(int senderId, int hubId)
+{
+    if (senderId >= 0 && senderId < MaxSenderIds)
+        m_idMap[senderId] = hubId;
+}
+
+void DatagramIngestWorker::stop()
+{
+    requestInterruption();
+    wait();
+}
+
+double DatagramIngestWorker::lossRatio() const
+{
+    const quint64 expected = m_stats.packets + m_stats.lost;
+    return expected > 0 ? double(m_stats.lost) / double(expected) : 0.0;
+}
+
+void DatagramIngestWorker::refreshStats()
+{
+    m_stats.packets = m_packets.load(std::memory_order_relaxed);
+    m_stats.samples = m_samples.load(std::memory_order_relaxed);
+    m_stats.lost = m_lost.load(std::memory_order_relaxed);
+    m_stats.reordered = m_reordered.load(std::memory_order_relaxed);
+    m_stats.malformed = m_malformed.load(std::memory_order_relaxed);
+
+    // 延遲統計以更新週期為單位（平均值與峰值都只看這 500 ms 內的封包）
+    const qint64 sum = m_latencySumUs.exchange(0, std::memory_order_relaxed);
+    const quint64 count = m_latencyCount.exchange(0, std::memory_order_relaxed);
+    const qint64 peak = m_latencyPeakUs.exchange(0, std::memory_order_relaxed);
+    if (count > 0) {
+        m_latencyAvgUs = double(sum) / double(count);
+        m_latencyMaxUs = double(peak);
+    }
+    emit statsChanged();
+}
+
+DatagramIngestWorker::SequenceTracker::Result
+DatagramIngestWorker::SequenceTracker::track(quint32 sequence, quint32 *missing)
+{
+    if (!started) {
+        started = true;
+        expected = sequence + 1;
+        return First;
+    }
+    const qint32 diff = qint32(sequence - expected);
+    if (diff == 0) {
+        ++expected;
+        return InOrder;
+    }
+    if (diff > 0 && diff < RestartThreshold) {
+        *missing = quint32(diff);
+        expected = sequence + 1;
+        return Gap;
+    }
+    if (diff < 0 && diff >= -ReorderWindow)
+        return Late;
+
+    expected = sequence + 1;
+    return Restart;
+}
+
+void DatagramIngestWorker::processPacket(const char *data, int length, qint64 receivedUs)
+{
+    SignalDatagram::PacketHeader header;
+    const int count = SignalDatagram::validate(data, std::size_t(qMax(0, length)), &header);
+    if (count < 0) {
+        m_malformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_packets.fetch_add(1, std::memory_order_relaxed);
+
+    quint32 missing = 0;
+    switch (m_tracker.track(header.sequence, &missing)) {
+    case SequenceTracker::Gap:
+        m_lost.fetch_add(missing, std::memory_order_relaxed);
+        m_pendingLost += missing;
+        break;
+    case SequenceTracker::Late:
+        // 先前被記成遺失的封包晚到了：改記為亂序；hub 已經有更新的值，不再發佈
+        m_reordered.fetch_add(1, std::memory_order_relaxed);
+        if (m_pendingLost > 0) {
+            --m_pendingLost;
+            m_lost.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return;
+    case SequenceTracker::Restart:
+        qDebug() << "DatagramIngestWorker: sender restarted at sequence" << header.sequence;
+        m_pendingLost = 0;
+        break;
+    case SequenceTracker::InOrder:
+    case SequenceTracker::First:
+        break;
+    }
+
+    // 只有同一個單調時鐘（同機）才算延遲；否則樣本時間以收到的時間為準
+    qint64 baseUs = receivedUs;
+    const qint64 latencyUs = receivedUs - header.sendTimeUs;
+    if (header.sendTimeUs > 0 && latencyUs >= 0 && latencyUs < MaxPlausibleLatencyUs) {
+        baseUs = header.sendTimeUs;
+        m_latencySumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+        m_latencyCount.fetch_add(1, std::memory_order_relaxed);
+        qint64 peak = m_latencyPeakUs.load(std::memory_order_relaxed);
+        while (latencyUs > peak
+               && !m_latencyPeakUs.compare_exchange_weak(peak, latencyUs, std::memory_order_relaxed)) {
+        }
+    }
+
+    quint64 published = 0;
+    for (int i = 0; i < count; ++i) {
+        const SignalDatagram::Entry entry = SignalDatagram::entryAt(data, i);
+        const int targetId = entry.signalId < MaxSenderIds ? m_idMap[entry.signalId] : -1;
+        if (targetId < 0)
+            continue;
+        if (m_hub->publish(targetId, entry.value, baseUs + entry.timeOffsetUs))
+            ++published;
+    }
+    m_samples.fetch_add(published, std::memory_order_relaxed);
+}
+
+#ifdef Q_OS_LINUX
+
+int DatagramIngestWorker::openSocket()
+{
+    int fd = -1;
+    if (!m_unixPath.isEmpty()) {
+        const QByteArray path = m_unixPath.toLocal8Bit();
+        sockaddr_un addr {};
+        if (path.size() >= int(sizeof(addr.sun_path))) {
+            qWarning() << "DatagramIngestWorker: socket path too long" << m_unixPath;
+            return -1;
+        }
+        fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            qWarning() << "DatagramIngestWorker: socket() failed" << strerror(errno);
+            return -1;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.constData(), size_t(path.size()));
+        // 上次沒清掉的 socket 檔會讓 bind 失敗
+        ::unlink(path.constData());
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+            qWarning() << "DatagramIngestWorker: cannot bind" << m_unixPath << strerror(errno);
+            ::close(fd);
+            return -1;
+        }
+    } else {
+        const int colon = m_udpAddress.lastIndexOf(QLatin1Char(':'));
+        const QString host = colon >= 0 ? m_udpAddress.left(colon) : QString();
+        const int port = (colon >= 0 ? m_udpAddress.mid(colon + 1) : m_udpAddress).toInt();
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(quint16(port > 0 ? port : SignalDatagram::DefaultPort));
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (!host.isEmpty() && ::inet_pton(AF_INET, host.toLatin1().constData(), &addr.sin_addr) != 1) {
+            qWarning() << "DatagramIngestWorker: invalid address" << m_udpAddress;
+            return -1;
+        }
+        fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            qWarning() << "DatagramIngestWorker: socket() failed" << strerror(errno);
+            return -1;
+        }
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+            qWarning() << "DatagramIngestWorker: cannot bind" << m_udpAddress << strerror(errno);
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    // 突發流量時給核心多一點緩衝；逾時讓迴圈能檢查 isInterruptionRequested()
+    const int receiveBuffer = 4 * 1024 * 1024;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    timeval timeout {};
+    timeout.tv_usec = 200 * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+void DatagramIngestWorker::run()
+{
+    const int fd = openSocket();
+    if (fd < 0)
+        return;
+    qDebug() << "DatagramIngestWorker: listening on"
+             << (m_unixPath.isEmpty() ? QStringLiteral("udp ") + m_udpAddress : QStringLiteral("unix ") + m_unixPath);
+
+    // 一次系統呼叫最多取 BatchSize 個封包
+    static_assert(SignalDatagram::MaxPacketSize % 8 == 0, "packet buffers stay aligned");
+    QByteArray storage(int(BatchSize * SignalDatagram::MaxPacketSize), Qt::Uninitialized);
+    iovec iov[BatchSize];
+    mmsghdr messages[BatchSize];
+    std::memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < BatchSize; ++i) {
+        iov[i].iov_base = storage.data() + i * SignalDatagram::MaxPacketSize;
+        iov[i].iov_len = SignalDatagram::MaxPacketSize;
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (!isInterruptionRequested()) {
+        // MSG_WAITFORONE：等到第一個封包（最多 SO_RCVTIMEO），之後把已到的封包一次取完
+        const int received = ::recvmmsg(fd, messages, BatchSize, MSG_WAITFORONE, nullptr);
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                continue;
+            qWarning() << "DatagramIngestWorker: recvmmsg failed" << strerror(errno);
+            break;
+        }
+        const qint64 now = VehicleSignalHub::nowUs();
+        for (int i = 0; i < received; ++i) {
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                m_malformed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            processPacket(static_cast<const char *>(iov[i].iov_base), int(messages[i].msg_len), now);
+        }
+    }
+
+    ::close(fd);
+    if (!m_unixPath.isEmpty())
+        ::unlink(m_unixPath.toLocal8Bit().constData());
+}
+
+#else
+
+int DatagramIngestWorker::openSocket()
+{
+    return -1;
+}
+
+void DatagramIngestWorker::run()
+{
+    qWarning() << "DatagramIngestWorker: datagram ingestion requires Linux (recvmmsg)";
+}
+
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+
+#include "signaldatagram.h"
+
+class VehicleSignalHub;
+
+/**
+ * DatagramIngestWorker
+ *
+ * 在獨立執行緒上接收訊號 datagram（格式見 signaldatagram.h），以 recvmmsg 一次取多個封包，
+ * 解出的樣本直接丟進 VehicleSignalHub。
+ *
+ * - 來源：UDP（"host:port"）或 Unix datagram socket（路徑），只在 Linux 上可用
+ * - 依封包 sequence 統計遺失、亂序與送端重啟；晚到的舊封包只計數不發佈（hub 已經有更新的值）
+ * - 同機送端（loopback / Unix socket）可用 sendTimeUs 算出傳遞延遲
+ *
+ * 統計值以 Q_PROPERTY 暴露給 QML（context property "VehicleDatagrams"），每 500 ms 更新一次。
+ *
+ * config.json：
+ *   "vehicle": { "datagram": { "udp": "127.0.0.1:47800" 或 "unix": "/tmp/smart_dashboard.sock",
+ *                              "signals": { "<送端 id>": "<hub 訊號名>" } } }
+ * 環境變量 SMART_DASHBOARD_UDP / SMART_DASHBOARD_UNIX_DGRAM 可覆蓋設定。
+ */
+class DatagramIngestWorker : public QThread {
+    Q_OBJECT
+    Q_PROPERTY(quint64 packetsReceived READ packetsReceived NOTIFY statsChanged)
+    Q_PROPERTY(quint64 samplesReceived READ samplesReceived NOTIFY statsChanged)
+    Q_PROPERTY(quint64 packetsLost READ packetsLost NOTIFY statsChanged)
+    Q_PROPERTY(quint64 packetsReordered READ packetsReordered NOTIFY statsChanged)
+    Q_PROPERTY(quint64 malformedPackets READ malformedPackets NOTIFY statsChanged)
+    Q_PROPERTY(double lossRatio READ lossRatio NOTIFY statsChanged)
+    Q_PROPERTY(double latencyAvgUs READ latencyAvgUs NOTIFY statsChanged)
+    Q_PROPERTY(double latencyMaxUs READ latencyMaxUs NOTIFY statsChanged)
+
+public:
+    // 依設定建立 worker；沒有設定來源時回傳 nullptr（必須在 GUI 執行緒呼叫）
+    static DatagramIngestWorker *fromConfig(const QJsonObject &datagramConfig, VehicleSignalHub *hub,
+                                            QObject *parent = nullptr);
+
+    explicit DatagramIngestWorker(VehicleSignalHub *hub, QObject *parent = nullptr);
+    ~DatagramIngestWorker() override;
+
+    void setUdpAddress(const QString &hostAndPort) { m_udpAddress = hostAndPort; }
+    void setUnixPath(const QString &path) { m_unixPath = path; }
+    // 送端訊號編號 → hub 訊號 id（GUI 執行緒，start() 之前）
+    void mapSignal(int senderId, int hubId);
+
+    quint64 packetsReceived() const { return m_stats.packets; }
+    quint64 samplesReceived() const { return m_stats.samples; }
+    quint64 packetsLost() const { return m_stats.lost; }
+    quint64 packetsReordered() const { return m_stats.reordered; }
+    quint64 malformedPackets() const { return m_stats.malformed; }
+    double lossRatio() const;
+    double latencyAvgUs() const { return m_latencyAvgUs; }
+    double latencyMaxUs() const { return m_latencyMaxUs; }
+
+    void stop();
+
+signals:
+    void statsChanged();
+
+protected:
+    void run() override;
+
+private slots:
+    void refreshStats();
+
+private:
+    // 封包序號追蹤（只在 worker 執行緒上使用）
+    struct SequenceTracker {
+        enum Result { InOrder, Gap, Late, Restart, First };
+        Result track(quint32 sequence, quint32 *missing);
+
+        bool started = false;
+        quint32 expected = 0;
+    };
+
+    static constexpr int MaxSenderIds = 1024;
+    static constexpr int BatchSize = 32;
+
+    int openSocket();
+    void processPacket(const char *data, int length, qint64 receivedUs);
+
+    VehicleSignalHub *m_hub;
+    QString m_udpAddress;
+    QString m_unixPath;
+    int m_idMap[MaxSenderIds];
+
+    SequenceTracker m_tracker;
+    quint64 m_pendingLost = 0;   // 尚未被晚到封包抵銷的遺失數
+
+    // worker 寫、GUI 執行緒讀
+    std::atomic<quint64> m_packets{0};
+    std::atomic<quint64> m_samples{0};
+    std::atomic<quint64> m_lost{0};
+    std::atomic<quint64> m_reordered{0};
+    std::atomic<quint64> m_malformed{0};
+    std::atomic<qint64> m_latencySumUs{0};
+    std::atomic<quint64> m_latencyCount{0};
+    std::atomic<qint64> m_latencyPeakUs{0};
+
+    // GUI 執行緒上的快照
+    struct Stats {
+        quint64 packets = 0;
+        quint64 samples = 0;
+        quint64 lost = 0;
+        quint64 reordered = 0;
+        quint64 malformed = 0;
+    } m_stats;
+    double m_latencyAvgUs = 0.0;
+    double m_latencyMaxUs = 0.0;
+    QTimer m_statsTimer;
+};
@@ -0,0 +1,245 @@
+#include "framecallbackthrottler.h"
+
+#include "outputplacement.h"
+#include "surfaceregistry.h"
+#include "toplevelconfigurator.h"
+
+#include <QDebug>
+#include <QQuickWindow>
+
+#include <QtWaylandCompositor/QWaylandCompositor>
+#include <QtWaylandCompositor/QWaylandOutput>
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandView>
+
+#include <wayland-server-core.h>
+
+#include <cmath>
+
+FrameCallbackThrottler::FrameCallbackThrottler(SurfaceRegistry *registry, ToplevelConfigurator *configurator,
+                                               OutputPlacement *placement, QObject *parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_configurator(configurator)
+    , m_placement(placement)
+{
+    m_enabled = qEnvironmentVariable("SMART_DASHBOARD_FRAME_THROTTLE") != QLatin1String("0");
+    bool ok = false;
+    const double rate = qEnvironmentVariable("SMART_DASHBOARD_BACKGROUND_FPS").toDouble(&ok);
+    if (ok && rate >= 0.0)
+        m_backgroundRate = rate;
+
+    m_backgroundTimer.setTimerType(Qt::CoarseTimer);
+    connect(&m_backgroundTimer, &QTimer::timeout, this, &FrameCallbackThrottler::onBackgroundTick);
+
+    // 列的增減、toplevel 補上來時重新決定前景 / 背景
+    connect(m_registry, &QAbstractItemModel::rowsInserted, this, &FrameCallbackThrottler::updateStates);
+    connect(m_registry, &QAbstractItemModel::rowsRemoved, this, &FrameCallbackThrottler::updateStates);
+    connect(m_registry, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &, const QModelIndex &, const QList<int> &roles) {
+        if (roles.contains(SurfaceRegistry::ToplevelRole))
+            updateStates();
+    });
+    connect(m_registry, &SurfaceRegistry::surfaceRemoved, this, [this](QObject *surface) {
+        m_entered.remove(static_cast<QWaylandSurface *>(surface));
+    });
+    connect(m_placement, &OutputPlacement::surfaceOutputChanged, this, &FrameCallbackThrottler::updateStates);
+}
+
+void FrameCallbackThrottler::setCompositor(QWaylandCompositor *compositor)
+{
+    if (m_compositor == compositor)
+        return;
+    if (m_compositor)
+        disconnect(m_compositor, nullptr, this, nullptr);
+    m_compositor = compositor;
+    if (!m_enabled || !m_compositor)
+        return;
+
+    // WaylandOutput 在 QML 中宣告在後面，defaultOutput 可能稍後才出現
+    connect(m_compositor, &QWaylandCompositor::defaultOutputChanged, this, &FrameCallbackThrottler::attachOutput);
+    attachOutput();
+}
+
+QObject *FrameCallbackThrottler::foregroundSurface() const
+{
+    return m_foreground;
+}
+
+void FrameCallbackThrottler::setForegroundSurface(QObject *surface)
+{
+    auto *waylandSurface = qobject_cast<QWaylandSurface *>(surface);
+    if (m_foreground == waylandSurface)
+        return;
+    m_foreground = waylandSurface;
+    emit foregroundSurfaceChanged();
+    updateStates();
+}
+
+void FrameCallbackThrottler::setActive(bool active)
+{
+    if (m_active == active)
+        return;
+    m_active = active;
+    emit activeChanged();
+    updateStates();
+}
+
+void FrameCallbackThrottler::setBackgroundRate(double rate)
+{
+    rate = qMax(0.0, rate);
+    if (qFuzzyCompare(m_backgroundRate + 1.0, rate + 1.0))
+        return;
+    m_backgroundRate = rate;
+    emit backgroundRateChanged();
+    updateStates();
+}
+
+void FrameCallbackThrottler::attachOutput()
+{
+    QWaylandOutput *output = m_compositor ? m_compositor->defaultOutput() : nullptr;
+    if (output == m_output)
+        return;
+
+    if (m_output) {
+        disconnect(m_output, nullptr, this, nullptr);
+        m_output->setProperty("automaticFrameCallback", true);
+    }
+    if (m_window)
+        disconnect(m_window, nullptr, this, nullptr);
+    m_output = output;
+    m_window.clear();
+    m_entered.clear();
+    if (!m_output)
+        return;
+
+    // automaticFrameCallback 是 QML WaylandOutput（QWaylandQuickOutput）的屬性
+    if (!m_output->setProperty("automaticFrameCallback", false))
+        qWarning() << "FrameCallbackThrottler: output has no automaticFrameCallback, background surfaces are not throttled";
+
+    auto attachWindow = [this] {
+        if (m_window)
+            disconnect(m_window, nullptr, this, nullptr);
+        m_window = m_output ? qobject_cast<QQuickWindow *>(m_output->window()) : nullptr;
+        // frameSwapped 在 render 執行緒發出，AutoConnection 會排回 GUI 執行緒（與 QWaylandQuickOutput 相同）
+        if (m_window)
+            connect(m_window, &QQuickWindow::frameSwapped, this, &FrameCallbackThrottler::onFrameSwapped);
+    };
+    connect(m_output, &QWaylandOutput::windowChanged, this, attachWindow);
+    attachWindow();
+    updateStates();
+}
+
+QWaylandSurface *FrameCallbackThrottler::effectiveForeground() const
+{
+    if (m_foreground && m_registry->contains(m_foreground) && isManaged(m_foreground))
+        return m_foreground;
+    const QList<QWaylandSurface *> rows = m_registry->rowSurfaces();
+    for (auto it = rows.crbegin(); it != rows.crend(); ++it) {
+        if (isManaged(*it))
+            return *it;
+    }
+    return nullptr;
+}
+
+bool FrameCallbackThrottler::isManaged(QWaylandSurface *surface) const
+{
+    // 佔列的 toplevel 依 OutputPlacement
+    if (m_registry->contains(surface))
+        return m_placement->outputForSurface(surface) == OutputPlacement::clusterOutput();
+    // popup 跟著父 surface（巢狀 popup 一路往上到 toplevel）
+    if (QWaylandSurface *parent = m_registry->parentOf(surface))
+        return isManaged(parent);
+    // 子 surface / 游標：看實際顯示它的 view 在哪個 output（與 QWaylandOutput::sendFrameCallbacks 相同，
+    // 只送給 primary view 在這個 output 的）；還沒有 view 的不在任何螢幕上，不送
+    const QWaylandView *view = surface->primaryView();
+    return view && view->output() == m_output;
+}
+
+bool FrameCallbackThrottler::isBackground(QWaylandSurface *surface, QWaylandSurface *foreground) const
+{
+    // popup / 游標不佔列，跟著前景一起送
+    if (!m_registry->contains(surface))
+        return false;
+    return !m_active || surface != foreground;
+}
+
+void FrameCallbackThrottler::onFrameSwapped()
+{
+    if (!m_output)
+        return;
+    QWaylandSurface *foreground = effectiveForeground();
+    const QList<QWaylandSurface *> surfaces = m_registry->allSurfaces();
+    for (QWaylandSurface *surface : surfaces) {
+        if (isManaged(surface) && !isBackground(surface, foreground))
+            sendCallbacks(surface);
+    }
+    flushClients();
+}
+
+void FrameCallbackThrottler::onBackgroundTick()
+{
+    if (!m_output)
+        return;
+    QWaylandSurface *foreground = effectiveForeground();
+    const QList<QWaylandSurface *> rows = m_registry->rowSurfaces();
+    for (QWaylandSurface *surface : rows) {
+        if (isManaged(surface) && isBackground(surface, foreground))
+            sendCallbacks(surface);
+    }
+    flushClients();
+}
+
+void FrameCallbackThrottler::sendCallbacks(QWaylandSurface *surface)
+{
+    // 與 QWaylandOutput::sendFrameCallbacks 相同：沒有內容的 surface 不送，第一次送之前先 enter
+    if (!surface->hasContent())
+        return;
+    if (!m_entered.contains(surface)) {
+        m_output->surfaceEnter(surface);
+        m_entered.insert(surface);
+    }
+    surface->sendFrameCallbacks();
+}
+
+void FrameCallbackThrottler::flushClients()
+{
+    if (m_compositor && m_compositor->display())
+        wl_display_flush_clients(m_compositor->display());
+}
+
+void FrameCallbackThrottler::updateStates()
+{
+    if (!m_enabled)
+        return;
+
+    QWaylandSurface *foreground = effectiveForeground();
+    int backgroundCount = 0;
+    const QList<QWaylandSurface *> rows = m_registry->rowSurfaces();
+    for (QWaylandSurface *surface : rows) {
+        if (!isManaged(surface)) {
+            // 其他 output 上的 app 一直在自己的螢幕上顯示
+            m_configurator->setActivated(surface, true);
+            continue;
+        }
+        const bool background = isBackground(surface, foreground);
+        if (background)
+            ++backgroundCount;
+
+        // 只在 activated 真的要變時才會送 configure（大小沿用目前的嵌入大小）
+        m_configurator->setActivated(surface, !background);
+    }
+
+    if (m_backgroundCount != backgroundCount) {
+        m_backgroundCount = backgroundCount;
+        emit backgroundCountChanged();
+    }
+
+    if (backgroundCount > 0 && m_backgroundRate > 0.0 && m_output) {
+        const int interval = qMax(1, int(std::lround(1000.0 / m_backgroundRate)));
+        if (!m_backgroundTimer.isActive() || m_backgroundTimer.interval() != interval)
+            m_backgroundTimer.start(interval);
+    } else {
+        m_backgroundTimer.stop();
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+class QQuickWindow;
+class QWaylandCompositor;
+class QWaylandOutput;
+class OutputPlacement;
+class QWaylandSurface;
+class SurfaceRegistry;
+class ToplevelConfigurator;
+
+/**
+ * FrameCallbackThrottler
+ *
+ * appArea 裡每個 surface 都是填滿同一塊區域的 WaylandQuickItem，只有最上面那個看得到。
+ * 預設 WaylandOutput 每次 frameSwapped 會對所有 surface 送 frame callback，被蓋住的 Android app
+ * 也照樣全速畫。這個類別關掉 output 的 automaticFrameCallback，自己決定送給誰
+ * （QML 中以 xdgShellHelper.frameThrottler 取得）：
+ *
+ * - 前景：foregroundSurface（為 null 或已不在清單時取最上面一列），以及 popup / 游標等不佔列的 surface
+ *   → 每次 frameSwapped 都送
+ * - 背景：其他佔列的 toplevel，以及 active 為 false（appArea 不可見）時的所有列
+ *   → 只以 backgroundRate（Hz）送；0 表示完全不送
+ *
+ * 前景 / 背景改變時同時（經 ToplevelConfigurator）更新 xdg_toplevel 的 activated 狀態，client 可藉此降低自己的工作量。
+ *
+ * 只管 cluster（主視窗，compositor 的 defaultOutput）上的 surface；OutputPlacement 分配到其他 output
+ * 的 surface 由該 output 自己（automaticFrameCallback）依它的畫面節奏送。不佔列的 surface 也一樣：
+ * popup 看它的父 surface，子 surface / 游標看 primary view 所在的 output，不在 cluster 的不送，
+ * 否則會同時收到兩個螢幕的 callback。
+ *
+ * 環境變數：SMART_DASHBOARD_FRAME_THROTTLE=0 停用（恢復 output 自動送），
+ * SMART_DASHBOARD_BACKGROUND_FPS 設定 backgroundRate（預設 1）。
+ */
+class FrameCallbackThrottler : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QObject *foregroundSurface READ foregroundSurface WRITE setForegroundSurface NOTIFY foregroundSurfaceChanged)
+    Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(double backgroundRate READ backgroundRate WRITE setBackgroundRate NOTIFY backgroundRateChanged)
+    Q_PROPERTY(bool enabled READ isEnabled CONSTANT)
+    Q_PROPERTY(int backgroundCount READ backgroundCount NOTIFY backgroundCountChanged)
+
+public:
+    static constexpr double DefaultBackgroundRate = 1.0;
+
+    FrameCallbackThrottler(SurfaceRegistry *registry, ToplevelConfigurator *configurator, OutputPlacement *placement,
+                           QObject *parent = nullptr);
+
+    void setCompositor(QWaylandCompositor *compositor);
+
+    QObject *foregroundSurface() const;
+    void setForegroundSurface(QObject *surface);
+    bool isActive() const { return m_active; }
+    void setActive(bool active);
+    double backgroundRate() const { return m_backgroundRate; }
+    void setBackgroundRate(double rate);
+    bool isEnabled() const { return m_enabled; }
+    int backgroundCount() const { return m_backgroundCount; }
+
+signals:
+    void foregroundSurfaceChanged();
+    void activeChanged();
+    void backgroundRateChanged();
+    void backgroundCountChanged();
+
+private:
+    void attachOutput();
+    void onFrameSwapped();
+    void onBackgroundTick();
+    void updateStates();
+    QWaylandSurface *effectiveForeground() const;
+    bool isManaged(QWaylandSurface *surface) const;
+    bool isBackground(QWaylandSurface *surface, QWaylandSurface *foreground) const;
+    void sendCallbacks(QWaylandSurface *surface);
+    void flushClients();
+
+    SurfaceRegistry *m_registry = nullptr;
+    ToplevelConfigurator *m_configurator = nullptr;
+    OutputPlacement *m_placement = nullptr;
+    QPointer<QWaylandCompositor> m_compositor;
+    QPointer<QWaylandOutput> m_output;
+    QPointer<QQuickWindow> m_window;
+    QPointer<QWaylandSurface> m_foreground;
+    QSet<QWaylandSurface *> m_entered;   // 已送過 wl_surface.enter 的 surface
+    QTimer m_backgroundTimer;
+    double m_backgroundRate = DefaultBackgroundRate;
+    int m_backgroundCount = 0;
+    bool m_active = true;
+    bool m_enabled = true;
+};
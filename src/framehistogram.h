@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+
+/**
+ * FrameHistogram
+ *
+ * 固定桶寬的無鎖直方圖：render 執行緒每幀 record()（一次 relaxed fetch_add），
+ * GUI 執行緒定期讀取百分位數。0 ~ 100 ms 以 50 µs 為一桶，超過的全部落在最後一桶。
+ *
+ * 讀取時不做快照，同一次讀取期間可能混到正在寫入的幾筆，對統計值沒有實質影響。
+ */
+class FrameHistogram {
+public:
+    static constexpr qint64 BucketWidthUs = 50;
+    static constexpr int BucketCount = 2000;   // 2000 × 50 µs = 100 ms
+
+    void record(qint64 durationUs)
+    {
+        const qint64 bucket = durationUs <= 0 ? 0 : durationUs / BucketWidthUs;
+        m_buckets[std::size_t(qMin<qint64>(bucket, BucketCount))].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sumUs.fetch_add(quint64(qMax<qint64>(0, durationUs)), std::memory_order_relaxed);
+        quint64 peak = m_maxUs.load(std::memory_order_relaxed);
+        while (quint64(durationUs) > peak
+               && !m_maxUs.compare_exchange_weak(peak, quint64(durationUs), std::memory_order_relaxed)) {
+        }
+    }
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+
+    double meanMs() const
+    {
+        const quint64 n = count();
+        return n > 0 ? double(m_sumUs.load(std::memory_order_relaxed)) / double(n) / 1000.0 : 0.0;
+    }
+
+    double maxMs() const { return double(m_maxUs.load(std::memory_order_relaxed)) / 1000.0; }
+
+    // p 介於 0~1；回傳該百分位所在桶的上緣（ms）
+    double percentileMs(double p) const
+    {
+        quint64 total = 0;
+        for (const auto &bucket : m_buckets)
+            total += bucket.load(std::memory_order_relaxed);
+        if (total == 0)
+            return 0.0;
+
+        const quint64 target = qMax<quint64>(1, quint64(p * double(total) + 0.999999));
+        quint64 cumulative = 0;
+        for (int i = 0; i <= BucketCount; ++i) {
+            cumulative += m_buckets[std::size_t(i)].load(std::memory_order_relaxed);
+            if (cumulative >= target)
+                return i == BucketCount ? maxMs() : double((i + 1) * BucketWidthUs) / 1000.0;
+        }
+        return maxMs();
+    }
+
+    void reset()
+    {
+        for (auto &bucket : m_buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_sumUs.store(0, std::memory_order_relaxed);
+        m_maxUs.store(0, std::memory_order_relaxed);
+    }
+
+    // 摘要 + 非零桶：buckets = [[桶上緣 ms, 筆數], ...]（最後一桶上緣記為 maxMs）
+    QJsonObject toJson() const
+    {
+        QJsonArray buckets;
+        for (int i = 0; i <= BucketCount; ++i) {
+            const quint32 n = m_buckets[std::size_t(i)].load(std::memory_order_relaxed);
+            if (n == 0)
+                continue;
+            const double upperMs = i == BucketCount ? maxMs() : double((i + 1) * BucketWidthUs) / 1000.0;
+            buckets.append(QJsonArray{upperMs, double(n)});
+        }
+        return QJsonObject{
+            {QStringLiteral("count"), double(count())},
+            {QStringLiteral("meanMs"), meanMs()},
+            {QStringLiteral("p50Ms"), percentileMs(0.50)},
+            {QStringLiteral("p95Ms"), percentileMs(0.95)},
+            {QStringLiteral("p99Ms"), percentileMs(0.99)},
+            {QStringLiteral("maxMs"), maxMs()},
+            {QStringLiteral("buckets"), buckets},
+        };
+    }
+
+private:
+    std::array<std::atomic<quint32>, BucketCount + 1> m_buckets{};
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_sumUs{0};
+    std::atomic<quint64> m_maxUs{0};
+};
@@ -0,0 +1,368 @@
+#include "framestats.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QScreen>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+
+#include <chrono>
+
+#ifdef SMART_DASHBOARD_HAVE_QUICK_PRIVATE
+// 取 software renderer 每幀的 flush 區域（私有 API，Qt6::QuickPrivate 找得到時才啟用）
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgsoftwarerenderer_p.h>
+#endif
+
+#ifdef Q_OS_UNIX
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#endif
+
+namespace {
+
+qint64 nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef Q_OS_UNIX
+// self-pipe：signal handler 只能做 async-signal-safe 的事，寫一個 byte 讓 GUI 執行緒的 notifier 醒來
+int s_dumpFds[2] = {-1, -1};
+
+void dumpSignalHandler(int)
+{
+    const int savedErrno = errno;
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t written = ::write(s_dumpFds[0], &byte, 1);
+    errno = savedErrno;
+}
+#endif
+
+} // namespace
+
+FrameStats::FrameStats(QObject *parent)
+    : QObject(parent)
+{
+    const QByteArray budget = qgetenv("SMART_DASHBOARD_FRAME_BUDGET_MS");
+    if (!budget.isEmpty() && budget.toDouble() > 0.0) {
+        m_budgetUs.store(qint64(budget.toDouble() * 1000.0), std::memory_order_relaxed);
+        m_budgetOverridden = true;
+    }
+    m_overlayEnabled = qEnvironmentVariableIntValue("SMART_DASHBOARD_FRAME_OVERLAY") != 0;
+
+    m_statsTimer.setInterval(500);
+    connect(&m_statsTimer, &QTimer::timeout, this, &FrameStats::refreshStats);
+}
+
+FrameStats::~FrameStats()
+{
+    // render 執行緒的訊號是 DirectConnection，先斷開再讓成員失效
+    if (m_window)
+        disconnect(m_window, nullptr, this, nullptr);
+}
+
+void FrameStats::attachWindow(QQuickWindow *window)
+{
+    if (m_window == window)
+        return;
+    if (m_window)
+        disconnect(m_window, nullptr, this, nullptr);
+
+    m_window = window;
+    m_renderWindow = window;
+    if (!m_window) {
+        m_statsTimer.stop();
+        return;
+    }
+
+    // threaded render loop 時以下都在 render 執行緒發出；FrameStats 住在 GUI 執行緒，必須 DirectConnection
+    connect(m_window, &QQuickWindow::beforeSynchronizing, this, &FrameStats::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::afterSynchronizing, this, &FrameStats::onAfterSynchronizing, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::beforeRendering, this, &FrameStats::onBeforeRendering, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::afterRendering, this, &FrameStats::onAfterRendering, Qt::DirectConnection);
+    connect(m_window, &QQuickWindow::frameSwapped, this, &FrameStats::onFrameSwapped, Qt::DirectConnection);
+    connect(m_window, &QWindow::screenChanged, this, &FrameStats::updateBudget);
+    connect(m_window, &QWindow::widthChanged, this, &FrameStats::updateWindowArea);
+    connect(m_window, &QWindow::heightChanged, this, &FrameStats::updateWindowArea);
+
+    updateBudget();
+    updateWindowArea();
+    m_statsTimer.start();
+    qDebug() << "FrameStats: attached to window" << m_window << "budget" << budgetMs() << "ms";
+}
+
+void FrameStats::updateBudget()
+{
+    if (m_budgetOverridden)
+        return;
+    QScreen *screen = m_window ? m_window->screen() : nullptr;
+    if (!screen)
+        screen = QGuiApplication::primaryScreen();
+    const qreal refreshRate = screen ? screen->refreshRate() : 0.0;
+    const qint64 budgetUs = refreshRate > 1.0 ? qint64(1e6 / refreshRate) : 16667;
+    if (m_budgetUs.exchange(budgetUs, std::memory_order_relaxed) != budgetUs)
+        emit budgetChanged();
+}
+
+void FrameStats::updateWindowArea()
+{
+    if (m_window)
+        m_windowArea.store(quint64(qMax(0, m_window->width())) * quint64(qMax(0, m_window->height())),
+                           std::memory_order_relaxed);
+}
+
+void FrameStats::onBeforeSynchronizing()
+{
+    m_syncStartUs = nowUs();
+}
+
+void FrameStats::onAfterSynchronizing()
+{
+    m_sync.record(nowUs() - m_syncStartUs);
+}
+
+void FrameStats::onBeforeRendering()
+{
+    m_renderStartUs = nowUs();
+}
+
+void FrameStats::onAfterRendering()
+{
+    m_render.record(nowUs() - m_renderStartUs);
+    recordRepaintRegion();
+}
+
+void FrameStats::recordRepaintRegion()
+{
+#ifdef SMART_DASHBOARD_HAVE_QUICK_PRIVATE
+    // afterRendering 在 renderScene() 之後發出，此時 flushRegion() 就是這一幀要送到畫面的區域
+    auto *renderer = dynamic_cast<QSGSoftwareRenderer *>(QQuickWindowPrivate::get(m_renderWindow)->renderer);
+    if (!renderer)
+        return;
+
+    const QRegion region = renderer->flushRegion();
+    quint64 area = 0;
+    quint64 rects = 0;
+    for (const QRect &rect : region) {
+        area += quint64(rect.width()) * quint64(rect.height());
+        ++rects;
+    }
+    m_repaintFrames.fetch_add(1, std::memory_order_relaxed);
+    m_repaintArea.fetch_add(area, std::memory_order_relaxed);
+    m_repaintRects.fetch_add(rects, std::memory_order_relaxed);
+    quint64 peak = m_repaintMaxArea.load(std::memory_order_relaxed);
+    while (area > peak && !m_repaintMaxArea.compare_exchange_weak(peak, area, std::memory_order_relaxed)) {
+    }
+    const quint64 windowArea = m_windowArea.load(std::memory_order_relaxed);
+    if (windowArea > 0 && double(area) * 100.0 >= double(windowArea) * FullRepaintPercent)
+        m_fullRepaints.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+void FrameStats::onFrameSwapped()
+{
+    const qint64 now = nowUs();
+    const qint64 budgetUs = m_budgetUs.load(std::memory_order_relaxed);
+
+    // 沒有經過 sync 的 frameSwapped（例如視窗剛 expose）不計入
+    if (m_syncStartUs > 0) {
+        const qint64 frameUs = now - m_syncStartUs;
+        m_frame.record(frameUs);
+        if (frameUs > budgetUs)
+            m_missed.fetch_add(1, std::memory_order_relaxed);
+        m_syncStartUs = 0;
+    }
+
+    if (m_lastSwapUs > 0) {
+        const qint64 intervalUs = now - m_lastSwapUs;
+        if (intervalUs > budgetUs * 3 / 2 && intervalUs < IdleGapMs * 1000)
+            m_dropped.fetch_add(quint64((intervalUs + budgetUs / 2) / budgetUs - 1), std::memory_order_relaxed);
+    }
+    m_lastSwapUs = now;
+}
+
+void FrameStats::refreshStats()
+{
+    const quint64 frames = m_frame.count();
+    if (frames == m_snapshot.frames)
+        return;
+
+    m_snapshot.syncP50 = m_sync.percentileMs(0.50);
+    m_snapshot.syncP95 = m_sync.percentileMs(0.95);
+    m_snapshot.syncP99 = m_sync.percentileMs(0.99);
+    m_snapshot.renderP50 = m_render.percentileMs(0.50);
+    m_snapshot.renderP95 = m_render.percentileMs(0.95);
+    m_snapshot.renderP99 = m_render.percentileMs(0.99);
+    m_snapshot.frameP50 = m_frame.percentileMs(0.50);
+    m_snapshot.frameP95 = m_frame.percentileMs(0.95);
+    m_snapshot.frameP99 = m_frame.percentileMs(0.99);
+    m_snapshot.frames = frames;
+    m_snapshot.missed = m_missed.load(std::memory_order_relaxed);
+    m_snapshot.dropped = m_dropped.load(std::memory_order_relaxed);
+
+    const quint64 repaintFrames = m_repaintFrames.load(std::memory_order_relaxed);
+    const double windowArea = double(m_windowArea.load(std::memory_order_relaxed));
+    m_snapshot.repaintFrames = repaintFrames;
+    if (repaintFrames > 0 && windowArea > 0.0) {
+        m_snapshot.repaintAvgPercent =
+            double(m_repaintArea.load(std::memory_order_relaxed)) / double(repaintFrames) / windowArea * 100.0;
+        m_snapshot.repaintMaxPercent = double(m_repaintMaxArea.load(std::memory_order_relaxed)) / windowArea * 100.0;
+        m_snapshot.repaintRectsAvg = double(m_repaintRects.load(std::memory_order_relaxed)) / double(repaintFrames);
+        m_snapshot.fullRepaints = m_fullRepaints.load(std::memory_order_relaxed);
+    }
+    emit statsChanged();
+}
+
+void FrameStats::setOverlayEnabled(bool enabled)
+{
+    if (m_overlayEnabled == enabled)
+        return;
+    m_overlayEnabled = enabled;
+    emit overlayEnabledChanged();
+}
+
+void FrameStats::reset()
+{
+    // render 執行緒可能同時在寫；重設後的頭一兩筆混到舊值無妨
+    m_sync.reset();
+    m_render.reset();
+    m_frame.reset();
+    m_missed.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_repaintFrames.store(0, std::memory_order_relaxed);
+    m_repaintArea.store(0, std::memory_order_relaxed);
+    m_repaintRects.store(0, std::memory_order_relaxed);
+    m_repaintMaxArea.store(0, std::memory_order_relaxed);
+    m_fullRepaints.store(0, std::memory_order_relaxed);
+    m_snapshot = Snapshot();
+    emit statsChanged();
+}
+
+QJsonObject FrameStats::repaintJson() const
+{
+    const quint64 frames = m_repaintFrames.load(std::memory_order_relaxed);
+    const double windowArea = double(m_windowArea.load(std::memory_order_relaxed));
+    if (frames == 0 || windowArea <= 0.0)
+        return QJsonObject();
+    const double area = double(m_repaintArea.load(std::memory_order_relaxed));
+    return QJsonObject{
+        {QStringLiteral("frames"), double(frames)},
+        {QStringLiteral("windowArea"), windowArea},
+        {QStringLiteral("avgArea"), area / double(frames)},
+        {QStringLiteral("avgPercent"), area / double(frames) / windowArea * 100.0},
+        {QStringLiteral("maxPercent"), double(m_repaintMaxArea.load(std::memory_order_relaxed)) / windowArea * 100.0},
+        {QStringLiteral("avgRects"), double(m_repaintRects.load(std::memory_order_relaxed)) / double(frames)},
+        {QStringLiteral("fullRepaints"), double(m_fullRepaints.load(std::memory_order_relaxed))},
+    };
+}
+
+QJsonObject FrameStats::toJson() const
+{
+    QJsonObject json{
+        {QStringLiteral("pid"), double(QCoreApplication::applicationPid())},
+        {QStringLiteral("timestamp"), QDateTime::currentDateTime().toString(Qt::ISODateWithMs)},
+        {QStringLiteral("budgetMs"), budgetMs()},
+        {QStringLiteral("bucketWidthMs"), double(FrameHistogram::BucketWidthUs) / 1000.0},
+        {QStringLiteral("missedDeadlines"), double(m_missed.load(std::memory_order_relaxed))},
+        {QStringLiteral("droppedFrames"), double(m_dropped.load(std::memory_order_relaxed))},
+        {QStringLiteral("sync"), m_sync.toJson()},
+        {QStringLiteral("render"), m_render.toJson()},
+        {QStringLiteral("frame"), m_frame.toJson()},
+    };
+    if (!m_outputName.isEmpty())
+        json.insert(QStringLiteral("output"), m_outputName);
+    const QJsonObject repaint = repaintJson();
+    if (!repaint.isEmpty())
+        json.insert(QStringLiteral("repaint"), repaint);
+    return json;
+}
+
+QString FrameStats::dumpJson(const QString &path) const
+{
+    QString target = path;
+    if (target.isEmpty()) {
+        target = qEnvironmentVariable("SMART_DASHBOARD_FRAMESTATS");
+        // 多個 output 共用環境變數時以 <名稱>-<output>.json 區分
+        if (!target.isEmpty() && !m_outputName.isEmpty()) {
+            const QFileInfo info(target);
+            target = info.dir().absoluteFilePath(
+                QStringLiteral("%1-%2.%3").arg(info.completeBaseName(), m_outputName, info.suffix()));
+        }
+    }
+    if (target.isEmpty()) {
+        QString dir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+        if (dir.isEmpty())
+            dir = QDir::tempPath();
+        const QString name = m_outputName.isEmpty()
+            ? QStringLiteral("smartdashboard-framestats-%1.json").arg(QCoreApplication::applicationPid())
+            : QStringLiteral("smartdashboard-framestats-%1-%2.json").arg(m_outputName).arg(QCoreApplication::applicationPid());
+        target = QDir(dir).absoluteFilePath(name);
+    }
+
+    QSaveFile file(target);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented)) < 0
+        || !file.commit()) {
+        qWarning() << "FrameStats: cannot write" << target << file.errorString();
+        return QString();
+    }
+    qInfo() << "FrameStats: dumped frame timing to" << target;
+    return target;
+}
+
+bool FrameStats::installDumpSignalHandler()
+{
+#ifdef Q_OS_UNIX
+    if (m_dumpNotifier)
+        return true;
+    if (s_dumpFds[0] >= 0) {
+        qWarning() << "FrameStats: SIGUSR1 handler already installed by another instance";
+        return false;
+    }
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, s_dumpFds) != 0) {
+        qWarning() << "FrameStats: socketpair failed:" << strerror(errno);
+        return false;
+    }
+
+    m_dumpNotifier = new QSocketNotifier(s_dumpFds[1], QSocketNotifier::Read, this);
+    connect(m_dumpNotifier, &QSocketNotifier::activated, this, &FrameStats::handleDumpSignal);
+
+    struct sigaction action = {};
+    action.sa_handler = dumpSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (::sigaction(SIGUSR1, &action, nullptr) != 0) {
+        qWarning() << "FrameStats: sigaction(SIGUSR1) failed:" << strerror(errno);
+        return false;
+    }
+    qDebug() << "FrameStats: kill -USR1" << QCoreApplication::applicationPid() << "to dump frame timing";
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FrameStats::handleDumpSignal()
+{
+#ifdef Q_OS_UNIX
+    // 連續多次訊號合併成一次輸出
+    char buffer[64];
+    while (::read(s_dumpFds[1], buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+    refreshStats();
+    dumpJson();
+    emit dumpRequested();
+}
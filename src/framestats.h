@@ -0,0 +1,176 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+#include <atomic>
+
+#include "framehistogram.h"
+
+class QQuickWindow;
+class QSocketNotifier;
+
+/**
+ * FrameStats
+ *
+ * 主視窗的逐幀計時。掛在 QQuickWindow 的 render 流程訊號上（threaded render loop 時
+ * 這些訊號都在 render 執行緒發出，一律 DirectConnection），每幀記三個時間進直方圖：
+ *
+ * - sync：beforeSynchronizing → afterSynchronizing（GUI 執行緒被擋住的時間）
+ * - render：beforeRendering → afterRendering
+ * - frame：beforeSynchronizing → frameSwapped（含等 vsync 的 swap）
+ *
+ * 另外統計兩種掉幀：
+ * - missedDeadlines：frame 超過一個 refresh 週期（budgetMs）的幀數
+ * - droppedFrames：連續兩次 frameSwapped 間隔超過 1.5 個週期時，中間跳過的 vsync 數
+ *   （間隔超過 IdleGapMs 視為畫面閒置，不計）
+ *
+ * software 後端（且編譯時有 Qt6::QuickPrivate）時另外統計每幀實際重畫 / flush 的區域：
+ * repaintAvgPercent / repaintMaxPercent 為重畫面積占視窗的比例，fullRepaints 為幾乎整窗重畫（>= 95%）的幀數。
+ *
+ * 百分位數以 Q_PROPERTY 暴露給 QML（context property "FrameStats"），GUI 執行緒每 500 ms 更新一次；
+ * overlayEnabled 決定 DashboardShell 是否顯示除錯 overlay。
+ * Unix 上 installDumpSignalHandler() 之後，kill -USR1 <pid> 會把完整統計（含直方圖）寫成 JSON。
+ *
+ * 多螢幕時每個 output 視窗各一個實例（各自的 render 執行緒），以 outputName 區分輸出檔名；
+ * 沒有安裝 signal handler 的實例跟著安裝的那個的 dumpRequested 一起輸出。
+ */
+class FrameStats : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(double syncP50 READ syncP50 NOTIFY statsChanged)
+    Q_PROPERTY(double syncP95 READ syncP95 NOTIFY statsChanged)
+    Q_PROPERTY(double syncP99 READ syncP99 NOTIFY statsChanged)
+    Q_PROPERTY(double renderP50 READ renderP50 NOTIFY statsChanged)
+    Q_PROPERTY(double renderP95 READ renderP95 NOTIFY statsChanged)
+    Q_PROPERTY(double renderP99 READ renderP99 NOTIFY statsChanged)
+    Q_PROPERTY(double frameP50 READ frameP50 NOTIFY statsChanged)
+    Q_PROPERTY(double frameP95 READ frameP95 NOTIFY statsChanged)
+    Q_PROPERTY(double frameP99 READ frameP99 NOTIFY statsChanged)
+    Q_PROPERTY(quint64 frameCount READ frameCount NOTIFY statsChanged)
+    Q_PROPERTY(quint64 missedDeadlines READ missedDeadlines NOTIFY statsChanged)
+    Q_PROPERTY(quint64 droppedFrames READ droppedFrames NOTIFY statsChanged)
+    Q_PROPERTY(double budgetMs READ budgetMs NOTIFY budgetChanged)
+    Q_PROPERTY(bool repaintTracking READ repaintTracking NOTIFY statsChanged)
+    Q_PROPERTY(double repaintAvgPercent READ repaintAvgPercent NOTIFY statsChanged)
+    Q_PROPERTY(double repaintMaxPercent READ repaintMaxPercent NOTIFY statsChanged)
+    Q_PROPERTY(double repaintRectsAvg READ repaintRectsAvg NOTIFY statsChanged)
+    Q_PROPERTY(quint64 fullRepaints READ fullRepaints NOTIFY statsChanged)
+    Q_PROPERTY(bool overlayEnabled READ overlayEnabled WRITE setOverlayEnabled NOTIFY overlayEnabledChanged)
+
+public:
+    static constexpr qint64 IdleGapMs = 250;
+    static constexpr double FullRepaintPercent = 95.0;
+
+    explicit FrameStats(QObject *parent = nullptr);
+    ~FrameStats() override;
+
+    // 必須在 GUI 執行緒、視窗開始渲染前呼叫（QML 中可在 Window 的 Component.onCompleted 呼叫）
+    Q_INVOKABLE void attachWindow(QQuickWindow *window);
+
+    // 非空時寫進 JSON 的 "output"，預設輸出檔名也會帶上
+    QString outputName() const { return m_outputName; }
+    void setOutputName(const QString &name) { m_outputName = name; }
+
+    // SIGUSR1 → dumpJson()；整個行程只需要一個實例安裝（非 Unix 平台不做事）
+    bool installDumpSignalHandler();
+
+    double syncP50() const { return m_snapshot.syncP50; }
+    double syncP95() const { return m_snapshot.syncP95; }
+    double syncP99() const { return m_snapshot.syncP99; }
+    double renderP50() const { return m_snapshot.renderP50; }
+    double renderP95() const { return m_snapshot.renderP95; }
+    double renderP99() const { return m_snapshot.renderP99; }
+    double frameP50() const { return m_snapshot.frameP50; }
+    double frameP95() const { return m_snapshot.frameP95; }
+    double frameP99() const { return m_snapshot.frameP99; }
+    quint64 frameCount() const { return m_snapshot.frames; }
+    quint64 missedDeadlines() const { return m_snapshot.missed; }
+    quint64 droppedFrames() const { return m_snapshot.dropped; }
+    double budgetMs() const { return double(m_budgetUs.load(std::memory_order_relaxed)) / 1000.0; }
+
+    // 重畫區域統計：只有 software 後端 + Qt6::QuickPrivate 時才有資料
+    bool repaintTracking() const { return m_snapshot.repaintFrames > 0; }
+    double repaintAvgPercent() const { return m_snapshot.repaintAvgPercent; }
+    double repaintMaxPercent() const { return m_snapshot.repaintMaxPercent; }
+    double repaintRectsAvg() const { return m_snapshot.repaintRectsAvg; }
+    quint64 fullRepaints() const { return m_snapshot.fullRepaints; }
+
+    bool overlayEnabled() const { return m_overlayEnabled; }
+    void setOverlayEnabled(bool enabled);
+
+    QJsonObject toJson() const;
+    // path 為空時寫到 SMART_DASHBOARD_FRAMESTATS，否則 $XDG_RUNTIME_DIR/smartdashboard-framestats-<pid>.json
+    Q_INVOKABLE QString dumpJson(const QString &path = QString()) const;
+    Q_INVOKABLE void reset();
+
+signals:
+    void statsChanged();
+    void budgetChanged();
+    void overlayEnabledChanged();
+    // 收到 SIGUSR1、自己輸出完之後發出
+    void dumpRequested();
+
+private slots:
+    void refreshStats();
+    void handleDumpSignal();
+
+private:
+    void updateBudget();
+    void updateWindowArea();
+    QJsonObject repaintJson() const;
+
+    // render 執行緒上的各階段
+    void onBeforeSynchronizing();
+    void onAfterSynchronizing();
+    void onBeforeRendering();
+    void onAfterRendering();
+    void onFrameSwapped();
+    void recordRepaintRegion();
+
+    QPointer<QQuickWindow> m_window;
+    QQuickWindow *m_renderWindow = nullptr;   // render 執行緒用（attachWindow 之後不變）
+
+    FrameHistogram m_sync;
+    FrameHistogram m_render;
+    FrameHistogram m_frame;
+    std::atomic<quint64> m_missed{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<qint64> m_budgetUs{16667};
+
+    // 重畫區域（render 執行緒寫；面積為邏輯像素）
+    std::atomic<quint64> m_windowArea{0};
+    std::atomic<quint64> m_repaintFrames{0};
+    std::atomic<quint64> m_repaintArea{0};
+    std::atomic<quint64> m_repaintRects{0};
+    std::atomic<quint64> m_repaintMaxArea{0};
+    std::atomic<quint64> m_fullRepaints{0};
+
+    // 只在 render 執行緒上讀寫
+    qint64 m_syncStartUs = 0;
+    qint64 m_renderStartUs = 0;
+    qint64 m_lastSwapUs = 0;
+
+    // GUI 執行緒上的快照
+    struct Snapshot {
+        double syncP50 = 0.0, syncP95 = 0.0, syncP99 = 0.0;
+        double renderP50 = 0.0, renderP95 = 0.0, renderP99 = 0.0;
+        double frameP50 = 0.0, frameP95 = 0.0, frameP99 = 0.0;
+        quint64 frames = 0;
+        quint64 missed = 0;
+        quint64 dropped = 0;
+        quint64 repaintFrames = 0;
+        double repaintAvgPercent = 0.0;
+        double repaintMaxPercent = 0.0;
+        double repaintRectsAvg = 0.0;
+        quint64 fullRepaints = 0;
+    } m_snapshot;
+    QTimer m_statsTimer;
+    bool m_budgetOverridden = false;
+    bool m_overlayEnabled = false;
+    QString m_outputName;
+
+    QSocketNotifier *m_dumpNotifier = nullptr;
+};
@@ -0,0 +1,63 @@
+#include "hexframeitem.h"
+
+HexFrameItem::HexFrameItem(QQuickItem *parent)
+    : PolygonFrameItem(parent)
+{
+}
+
+void HexFrameItem::setTopMargin(qreal margin)
+{
+    if (qFuzzyCompare(m_topMargin, margin))
+        return;
+    m_topMargin = margin;
+    emit topMarginChanged();
+    invalidateOutline();
+}
+
+void HexFrameItem::setBottomMargin(qreal margin)
+{
+    if (qFuzzyCompare(m_bottomMargin, margin))
+        return;
+    m_bottomMargin = margin;
+    emit bottomMarginChanged();
+    invalidateOutline();
+}
+
+void HexFrameItem::setSideMargin(qreal margin)
+{
+    if (qFuzzyCompare(m_sideMargin, margin))
+        return;
+    m_sideMargin = margin;
+    emit sideMarginChanged();
+    invalidateOutline();
+}
+
+void HexFrameItem::setSlopeRatio(qreal ratio)
+{
+    if (qFuzzyCompare(m_slopeRatio, ratio))
+        return;
+    m_slopeRatio = ratio;
+    emit slopeRatioChanged();
+    invalidateOutline();
+}
+
+QPolygonF HexFrameItem::buildOutline() const
+{
+    const qreal w = width();
+    const qreal h = height();
+    const qreal midY = h / 2.0;
+    const qreal topY = m_topMargin;
+    const qreal bottomY = h - m_bottomMargin;
+    const qreal diagInset = (midY - topY) * m_slopeRatio;
+    const qreal leftX = m_sideMargin + diagInset;
+    const qreal rightX = w - m_sideMargin - diagInset;
+
+    return QPolygonF({
+        QPointF(leftX, topY),
+        QPointF(rightX, topY),
+        QPointF(w - m_sideMargin, midY),
+        QPointF(rightX, bottomY),
+        QPointF(leftX, bottomY),
+        QPointF(m_sideMargin, midY),
+    });
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "polygonframeitem.h"
+
+/**
+ * HexFrameItem
+ *
+ * 儀表用的橫向六角形外框（QML 中為 HexFrame），參數與原本 SpeedWidget 的 Canvas 相同：
+ *
+ *        leftX ─────────── rightX          ← topMargin
+ *       ╱                         ╲
+ *   sideMargin                 width - sideMargin   （垂直置中）
+ *       ╲                         ╱
+ *        leftX ─────────── rightX          ← height - bottomMargin
+ *
+ * 斜邊內縮量 = (height / 2 - topMargin) × slopeRatio。
+ */
+class HexFrameItem : public PolygonFrameItem {
+    Q_OBJECT
+    Q_PROPERTY(qreal topMargin READ topMargin WRITE setTopMargin NOTIFY topMarginChanged)
+    Q_PROPERTY(qreal bottomMargin READ bottomMargin WRITE setBottomMargin NOTIFY bottomMarginChanged)
+    Q_PROPERTY(qreal sideMargin READ sideMargin WRITE setSideMargin NOTIFY sideMarginChanged)
+    Q_PROPERTY(qreal slopeRatio READ slopeRatio WRITE setSlopeRatio NOTIFY slopeRatioChanged)
+
+public:
+    explicit HexFrameItem(QQuickItem *parent = nullptr);
+
+    qreal topMargin() const { return m_topMargin; }
+    void setTopMargin(qreal margin);
+    qreal bottomMargin() const { return m_bottomMargin; }
+    void setBottomMargin(qreal margin);
+    qreal sideMargin() const { return m_sideMargin; }
+    void setSideMargin(qreal margin);
+    qreal slopeRatio() const { return m_slopeRatio; }
+    void setSlopeRatio(qreal ratio);
+
+signals:
+    void topMarginChanged();
+    void bottomMarginChanged();
+    void sideMarginChanged();
+    void slopeRatioChanged();
+
+protected:
+    QPolygonF buildOutline() const override;
+
+private:
+    qreal m_topMargin = 0.0;
+    qreal m_bottomMargin = 0.0;
+    qreal m_sideMargin = 0.0;
+    qreal m_slopeRatio = 0.7;
+};
@@ -0,0 +1,446 @@
+#include "numericreadout.h"
+
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGRenderNode>
+#include <QSGRendererInterface>
+#include <QSGTexture>
+#include <QSGTextureMaterial>
+#include <QtMath>
+
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace {
+
+// 補位用的空白：寬度等於一個數字（U+2007 FIGURE SPACE），不畫任何東西
+constexpr QChar PaddingBlank(0x2007);
+constexpr int VerticesPerGlyph = 4;
+constexpr int IndicesPerGlyph = 6;
+// 每個字元在 atlas 中四周留的空間（邏輯像素），避免線性取樣時吃到隔壁的字
+constexpr qreal GlyphPadding = 1.0;
+
+class ReadoutNode : public QSGGeometryNode {
+public:
+    ReadoutNode()
+        : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0, 0, QSGGeometry::UnsignedShortType)
+    {
+        m_geometry.setDrawingMode(QSGGeometry::DrawTriangles);
+        setGeometry(&m_geometry);
+        m_material.setFiltering(QSGTexture::Linear);
+        setMaterial(&m_material);
+    }
+
+    void setTexture(QSGTexture *texture)
+    {
+        m_texture.reset(texture);
+        m_material.setTexture(texture);
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    QSGTexture *texture() const { return m_texture.get(); }
+    QSGGeometry *readoutGeometry() { return &m_geometry; }
+
+private:
+    QSGGeometry m_geometry;
+    QSGTextureMaterial m_material;
+    std::unique_ptr<QSGTexture> m_texture;
+};
+
+// software 後端不支援自訂幾何節點：直接用 QPainter 從 atlas 貼字
+class SoftwareReadoutNode : public QSGRenderNode {
+public:
+    explicit SoftwareReadoutNode(QQuickWindow *window) : m_window(window) {}
+
+    void setAtlas(const QImage &atlas) { m_atlas = atlas; }
+
+    void setGlyphs(const QVector<NumericReadout::PlacedGlyph> &glyphs)
+    {
+        m_glyphs = glyphs;
+        m_bounds = QRectF();
+        for (const auto &glyph : glyphs)
+            m_bounds |= glyph.target;
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    void render(const RenderState *state) override
+    {
+        auto *painter = static_cast<QPainter *>(
+            m_window->rendererInterface()->getResource(m_window, QSGRendererInterface::PainterResource));
+        if (!painter)
+            return;
+        painter->save();
+        painter->setTransform(matrix()->toTransform());
+        painter->setOpacity(inheritedOpacity());
+        if (state->clipRegion() && !state->clipRegion()->isEmpty())
+            painter->setClipRegion(*state->clipRegion(), Qt::ReplaceClip);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+        for (const auto &glyph : std::as_const(m_glyphs))
+            painter->drawImage(glyph.target, m_atlas, glyph.source);
+        painter->restore();
+    }
+
+    RenderingFlags flags() const override { return BoundedRectRendering | DepthAwareRendering; }
+    QRectF rect() const override { return m_bounds; }
+
+private:
+    QQuickWindow *m_window;
+    QImage m_atlas;
+    QVector<NumericReadout::PlacedGlyph> m_glyphs;
+    QRectF m_bounds;
+};
+
+} // namespace
+
+NumericReadout::NumericReadout(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void NumericReadout::setValue(double value)
+{
+    if (m_value == value)
+        return;
+    m_value = value;
+    emit valueChanged();
+    invalidateText();
+}
+
+void NumericReadout::setDigits(int digits)
+{
+    digits = qBound(1, digits, 12);
+    if (m_digits == digits)
+        return;
+    m_digits = digits;
+    emit formatChanged();
+    invalidateText();
+}
+
+void NumericReadout::setDecimals(int decimals)
+{
+    decimals = qBound(0, decimals, 6);
+    if (m_decimals == decimals)
+        return;
+    m_decimals = decimals;
+    emit formatChanged();
+    invalidateText();
+}
+
+void NumericReadout::setLeadingBlank(bool blank)
+{
+    if (m_leadingBlank == blank)
+        return;
+    m_leadingBlank = blank;
+    emit formatChanged();
+    invalidateText();
+}
+
+void NumericReadout::setFixedWidth(bool fixed)
+{
+    if (m_fixedWidth == fixed)
+        return;
+    m_fixedWidth = fixed;
+    emit formatChanged();
+    invalidateText();
+}
+
+void NumericReadout::setTruncate(bool truncate)
+{
+    if (m_truncate == truncate)
+        return;
+    m_truncate = truncate;
+    emit formatChanged();
+    invalidateText();
+}
+
+void NumericReadout::setSuffix(const QString &suffix)
+{
+    if (m_suffix == suffix)
+        return;
+    m_suffix = suffix;
+    emit formatChanged();
+    // suffix 的字元也要在 atlas 裡
+    invalidateAtlas();
+}
+
+void NumericReadout::setFont(const QFont &font)
+{
+    if (m_font == font)
+        return;
+    m_font = font;
+    emit fontChanged();
+    invalidateAtlas();
+}
+
+void NumericReadout::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+    invalidateAtlas();
+}
+
+void NumericReadout::invalidateAtlas()
+{
+    m_atlasDirty = true;
+    m_textDirty = true;
+    polish();
+}
+
+void NumericReadout::invalidateText()
+{
+    m_textDirty = true;
+    polish();
+}
+
+void NumericReadout::itemChange(ItemChange change, const ItemChangeData &data)
+{
+    QQuickItem::itemChange(change, data);
+    if (change == ItemDevicePixelRatioHasChanged || (change == ItemSceneChange && data.window))
+        invalidateAtlas();
+}
+
+QString NumericReadout::formatValue() const
+{
+    if (!qIsFinite(m_value))
+        return QStringLiteral("-") + m_suffix;
+
+    const double scale = std::pow(10.0, m_decimals);
+    const double rounded = m_truncate ? std::trunc(m_value * scale) / scale : m_value;
+    QString number = QString::number(std::abs(rounded), 'f', m_decimals);
+    // 四捨五入後為 0 時不顯示 "-0"
+    bool negative = false;
+    if (rounded < 0.0) {
+        for (const QChar c : std::as_const(number)) {
+            if (c >= QLatin1Char('1') && c <= QLatin1Char('9')) {
+                negative = true;
+                break;
+            }
+        }
+    }
+
+    const int pointIndex = number.indexOf(QLatin1Char('.'));
+    const int integerDigits = pointIndex >= 0 ? pointIndex : number.size();
+    if (integerDigits < m_digits) {
+        const QChar pad = m_leadingBlank ? PaddingBlank : QLatin1Char('0');
+        number.prepend(QString(m_digits - integerDigits, pad));
+    }
+    if (negative) {
+        // 補 0 時負號在最前面；補空白時負號緊貼數字
+        int insertAt = 0;
+        while (insertAt < number.size() && number.at(insertAt) == PaddingBlank)
+            ++insertAt;
+        if (insertAt > 0)
+            number[insertAt - 1] = QLatin1Char('-');
+        else
+            number.prepend(QLatin1Char('-'));
+    }
+    return number + m_suffix;
+}
+
+void NumericReadout::bakeAtlas()
+{
+    m_atlasDirty = false;
+    m_textureDirty = true;
+    m_atlasGlyphs.clear();
+
+    const QFontMetricsF metrics(m_font);
+    m_ascent = metrics.ascent();
+    m_lineHeight = metrics.height();
+    m_atlasScale = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+
+    // 數字一律等寬
+    qreal digitAdvance = 0.0;
+    for (char c = '0'; c <= '9'; ++c)
+        digitAdvance = qMax(digitAdvance, metrics.horizontalAdvance(QLatin1Char(c)));
+
+    QString charset = QStringLiteral("0123456789.-");
+    for (const QChar c : std::as_const(m_suffix)) {
+        if (!charset.contains(c))
+            charset.append(c);
+    }
+
+    // 不畫的字元：只需要寬度
+    m_atlasGlyphs.insert(PaddingBlank, AtlasGlyph{QRectF(), digitAdvance});
+
+    // 單列排列；每格 = 字寬 + 兩側 padding，以裝置像素對齊
+    struct Cell {
+        QChar c;
+        qreal advance;
+        qreal inkOffset;
+        int x;
+        int width;
+    };
+    QVector<Cell> cells;
+    const int cellHeight = qCeil((m_lineHeight + 2 * GlyphPadding) * m_atlasScale);
+    int atlasWidth = 0;
+    for (const QChar c : std::as_const(charset)) {
+        const bool digit = c.isDigit();
+        const qreal naturalAdvance = metrics.horizontalAdvance(c);
+        const qreal advance = digit ? digitAdvance : naturalAdvance;
+        if (c.isSpace()) {
+            m_atlasGlyphs.insert(c, AtlasGlyph{QRectF(), advance});
+            continue;
+        }
+        const int width = qCeil((advance + 2 * GlyphPadding) * m_atlasScale);
+        cells.append(Cell{c, advance, digit ? (digitAdvance - naturalAdvance) / 2 : 0.0, atlasWidth, width});
+        atlasWidth += width;
+    }
+
+    m_atlas = QImage(qMax(1, atlasWidth), qMax(1, cellHeight), QImage::Format_ARGB32_Premultiplied);
+    m_atlas.fill(Qt::transparent);
+    QPainter painter(&m_atlas);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.scale(m_atlasScale, m_atlasScale);
+    painter.setFont(m_font);
+    painter.setPen(m_color);
+    for (const Cell &cell : std::as_const(cells)) {
+        const qreal x = cell.x / m_atlasScale + GlyphPadding + cell.inkOffset;
+        painter.drawText(QPointF(x, GlyphPadding + m_ascent), QString(cell.c));
+        m_atlasGlyphs.insert(cell.c, AtlasGlyph{QRectF(cell.x, 0, cell.width, cellHeight), cell.advance});
+    }
+}
+
+void NumericReadout::layoutText()
+{
+    m_textDirty = false;
+
+    QString text = formatValue();
+    const bool changed = text != m_text;
+    m_text = text;
+    if (!m_fixedWidth) {
+        // 不固定寬度時，補位空白不佔空間
+        int blanks = 0;
+        while (blanks < text.size() && text.at(blanks) == PaddingBlank)
+            ++blanks;
+        text.remove(0, blanks);
+    }
+
+    QVector<PlacedGlyph> glyphs;
+    glyphs.reserve(text.size());
+    qreal x = 0.0;
+    for (const QChar c : std::as_const(text)) {
+        const auto it = m_atlasGlyphs.constFind(c);
+        if (it == m_atlasGlyphs.constEnd())
+            continue;
+        if (!it->source.isEmpty()) {
+            const QRectF target(x - GlyphPadding, -GlyphPadding, it->source.width() / m_atlasScale,
+                                it->source.height() / m_atlasScale);
+            glyphs.append(PlacedGlyph{target, it->source});
+        }
+        x += it->advance;
+    }
+
+    // 判斷這次只需要換 UV，還是連位置都要重寫
+    bool samePositions = glyphs.size() == m_glyphs.size();
+    bool sameSources = samePositions;
+    for (int i = 0; samePositions && i < glyphs.size(); ++i) {
+        samePositions = glyphs.at(i).target == m_glyphs.at(i).target;
+        sameSources = sameSources && glyphs.at(i).source == m_glyphs.at(i).source;
+    }
+    if (!samePositions)
+        m_positionsDirty = true;
+    else if (!sameSources)
+        m_uvDirty = true;
+    m_glyphs = glyphs;
+
+    setImplicitSize(x, m_lineHeight);
+    if (changed)
+        emit textChanged();
+    if (m_positionsDirty || m_uvDirty || m_textureDirty)
+        update();
+}
+
+void NumericReadout::updatePolish()
+{
+    if (m_atlasDirty)
+        bakeAtlas();
+    if (m_textDirty)
+        layoutText();
+}
+
+QSGNode *NumericReadout::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    if (m_glyphs.isEmpty() || m_atlas.isNull()) {
+        delete oldNode;
+        m_textureDirty = m_positionsDirty = true;
+        return nullptr;
+    }
+
+    if (window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) {
+        auto *node = static_cast<SoftwareReadoutNode *>(oldNode);
+        if (!node) {
+            node = new SoftwareReadoutNode(window());
+            m_textureDirty = true;
+        }
+        if (m_textureDirty)
+            node->setAtlas(m_atlas);
+        if (m_textureDirty || m_positionsDirty || m_uvDirty)
+            node->setGlyphs(m_glyphs);
+        m_textureDirty = m_positionsDirty = m_uvDirty = false;
+        return node;
+    }
+
+    auto *node = static_cast<ReadoutNode *>(oldNode);
+    if (!node) {
+        node = new ReadoutNode;
+        m_textureDirty = m_positionsDirty = true;
+    }
+    if (m_textureDirty) {
+        node->setTexture(window()->createTextureFromImage(m_atlas));
+        m_positionsDirty = true;
+    }
+
+    QSGGeometry *geometry = node->readoutGeometry();
+    const int count = m_glyphs.size();
+    if (geometry->vertexCount() != count * VerticesPerGlyph) {
+        geometry->allocate(count * VerticesPerGlyph, count * IndicesPerGlyph);
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int i = 0; i < count; ++i) {
+            const quint16 base = quint16(i * VerticesPerGlyph);
+            indices[i * IndicesPerGlyph + 0] = base;
+            indices[i * IndicesPerGlyph + 1] = quint16(base + 1);
+            indices[i * IndicesPerGlyph + 2] = quint16(base + 2);
+            indices[i * IndicesPerGlyph + 3] = quint16(base + 2);
+            indices[i * IndicesPerGlyph + 4] = quint16(base + 1);
+            indices[i * IndicesPerGlyph + 5] = quint16(base + 3);
+        }
+        m_positionsDirty = true;
+    }
+
+    if (m_positionsDirty || m_uvDirty) {
+        const qreal atlasWidth = m_atlas.width();
+        const qreal atlasHeight = m_atlas.height();
+        QSGGeometry::TexturedPoint2D *vertices = geometry->vertexDataAsTexturedPoint2D();
+        for (int i = 0; i < count; ++i) {
+            const PlacedGlyph &glyph = m_glyphs.at(i);
+            const float u0 = float(glyph.source.left() / atlasWidth);
+            const float u1 = float(glyph.source.right() / atlasWidth);
+            const float v0 = float(glyph.source.top() / atlasHeight);
+            const float v1 = float(glyph.source.bottom() / atlasHeight);
+            QSGGeometry::TexturedPoint2D *v = vertices + i * VerticesPerGlyph;
+            if (m_positionsDirty) {
+                const QRectF &r = glyph.target;
+                v[0].set(float(r.left()), float(r.top()), u0, v0);
+                v[1].set(float(r.right()), float(r.top()), u1, v0);
+                v[2].set(float(r.left()), float(r.bottom()), u0, v1);
+                v[3].set(float(r.right()), float(r.bottom()), u1, v1);
+            } else {
+                // 常見情況：只有數字變了，位置不動
+                v[0].tx = u0; v[0].ty = v0;
+                v[1].tx = u1; v[1].ty = v0;
+                v[2].tx = u0; v[2].ty = v1;
+                v[3].tx = u1; v[3].ty = v1;
+            }
+        }
+        node->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    m_textureDirty = m_positionsDirty = m_uvDirty = false;
+    return node;
+}
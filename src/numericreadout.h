@@ -0,0 +1,121 @@
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QQuickItem>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+/**
+ * NumericReadout
+ *
+ * 高更新率數字顯示（車速、里程）。QML Text 每次值改變都要重新排版並重建 glyph 節點；
+ * 這裡在字型 / 大小 / 顏色改變時，把 0~9、小數點、負號與 suffix 用到的字元預先畫進一張 atlas 貼圖，
+ * 之後每次更新只改寫幾個四邊形的 UV（字數或位置不變時連頂點位置都不動）。
+ *
+ * - 數字一律等寬（取 0~9 中最寬的字寬），數字變化時不會左右跳動
+ * - 格式：digits = 整數部分最少位數，不足補 0，leadingBlank 時改補空白；
+ *   decimals = 小數位數；truncate 時無條件捨去（里程），否則四捨五入
+ * - fixedWidth：寬度以 digits 位數固定（補的空白也佔位）；否則只依實際內容
+ * - 同一幀內多次設定 value 只會在 updatePolish() 排版一次
+ */
+class NumericReadout : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(double value READ value WRITE setValue NOTIFY valueChanged)
+    Q_PROPERTY(int digits READ digits WRITE setDigits NOTIFY formatChanged)
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY formatChanged)
+    Q_PROPERTY(bool leadingBlank READ leadingBlank WRITE setLeadingBlank NOTIFY formatChanged)
+    Q_PROPERTY(bool fixedWidth READ fixedWidth WRITE setFixedWidth NOTIFY formatChanged)
+    Q_PROPERTY(bool truncate READ truncate WRITE setTruncate NOTIFY formatChanged)
+    Q_PROPERTY(QString suffix READ suffix WRITE setSuffix NOTIFY formatChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QString text READ text NOTIFY textChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
+
+public:
+    explicit NumericReadout(QQuickItem *parent = nullptr);
+
+    double value() const { return m_value; }
+    void setValue(double value);
+
+    int digits() const { return m_digits; }
+    void setDigits(int digits);
+    int decimals() const { return m_decimals; }
+    void setDecimals(int decimals);
+    bool leadingBlank() const { return m_leadingBlank; }
+    void setLeadingBlank(bool blank);
+    bool fixedWidth() const { return m_fixedWidth; }
+    void setFixedWidth(bool fixed);
+    bool truncate() const { return m_truncate; }
+    void setTruncate(bool truncate);
+    QString suffix() const { return m_suffix; }
+    void setSuffix(const QString &suffix);
+
+    QFont font() const { return m_font; }
+    void setFont(const QFont &font);
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+
+    // 目前顯示的字串（除錯 / 測試用）
+    QString text() const { return m_text; }
+
+    // 在 atlas 中的一個字元（座標為 atlas 像素）
+    struct AtlasGlyph {
+        QRectF source;
+        qreal advance = 0.0;
+    };
+
+    // 在 item 中的一個字元
+    struct PlacedGlyph {
+        QRectF target;
+        QRectF source;
+    };
+
+signals:
+    void valueChanged();
+    void formatChanged();
+    void fontChanged();
+    void colorChanged();
+    void textChanged();
+
+protected:
+    void updatePolish() override;
+    void itemChange(ItemChange change, const ItemChangeData &data) override;
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+    void invalidateAtlas();
+    void invalidateText();
+    QString formatValue() const;
+    void bakeAtlas();
+    void layoutText();
+
+    double m_value = 0.0;
+    int m_digits = 1;
+    int m_decimals = 0;
+    bool m_leadingBlank = false;
+    bool m_fixedWidth = false;
+    bool m_truncate = false;
+    QString m_suffix;
+    QFont m_font;
+    QColor m_color = Qt::white;
+    QString m_text;
+
+    // atlas（GUI 執行緒在 updatePolish() 建立；updatePaintNode 時 GUI 執行緒被擋住，可直接讀）
+    QImage m_atlas;
+    QHash<QChar, AtlasGlyph> m_atlasGlyphs;
+    qreal m_atlasScale = 1.0;
+    qreal m_ascent = 0.0;
+    qreal m_lineHeight = 0.0;
+
+    QVector<PlacedGlyph> m_glyphs;
+    bool m_atlasDirty = true;
+    bool m_textDirty = true;
+    bool m_textureDirty = true;     // atlas 換了：要重新上傳貼圖
+    bool m_positionsDirty = true;   // 字數或位置變了：要重寫頂點位置
+    bool m_uvDirty = true;          // 只換了字：只重寫 UV
+};
@@ -0,0 +1,203 @@
+#include "outputplacement.h"
+
+#include "packagesurfacematcher.h"
+#include "surfaceregistry.h"
+
+#include <QDebug>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSortFilterProxyModel>
+
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandXdgToplevel>
+
+namespace {
+
+bool matchesPattern(const QString &pattern, const QString &package)
+{
+    if (!pattern.contains(QLatin1Char('*')))
+        return pattern.compare(package, Qt::CaseInsensitive) == 0;
+    const QRegularExpression re(QRegularExpression::wildcardToRegularExpression(pattern),
+                                QRegularExpression::CaseInsensitiveOption);
+    return re.match(package).hasMatch();
+}
+
+// 只留下分配到某個 output 的列。source 的 dataChanged 只帶 AppIdRole，proxy 不會因此重新過濾
+// （filterRole 不在其中），所以 output 改變時由 OutputPlacement::updateSurfaces 呼叫 refilter()
+class OutputSurfaceModel : public QSortFilterProxyModel {
+public:
+    OutputSurfaceModel(OutputPlacement *placement, SurfaceRegistry *registry, const QString &output)
+        : QSortFilterProxyModel(placement), m_placement(placement), m_registry(registry), m_output(output)
+    {
+        setSourceModel(registry);
+    }
+
+    void refilter() { invalidateRowsFilter(); }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override
+    {
+        Q_UNUSED(sourceParent);
+        auto *surface = static_cast<QWaylandSurface *>(m_registry->surfaceAt(sourceRow));
+        return surface && m_placement->outputForSurface(surface) == m_output;
+    }
+
+private:
+    OutputPlacement *m_placement;
+    SurfaceRegistry *m_registry;
+    QString m_output;
+};
+
+} // namespace
+
+OutputPlacement::OutputPlacement(SurfaceRegistry *registry, QObject *parent)
+    : QObject(parent)
+    , m_registry(registry)
+{
+    const QString override = qEnvironmentVariable("SMART_DASHBOARD_OUTPUTS");
+    for (const QString &name : override.split(QLatin1Char(','), Qt::SkipEmptyParts))
+        m_enabledOverride.append(name.trimmed());
+
+    connect(m_registry, &QAbstractItemModel::rowsInserted, this, &OutputPlacement::updateSurfaces);
+    connect(m_registry, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &, const QModelIndex &, const QList<int> &roles) {
+        if (roles.contains(SurfaceRegistry::AppIdRole))
+            updateSurfaces();
+    });
+    connect(m_registry, &SurfaceRegistry::surfaceRemoved, this, [this](QObject *surface) {
+        m_lastOutput.remove(static_cast<QWaylandSurface *>(surface));
+    });
+}
+
+void OutputPlacement::setOutputs(const QJsonArray &outputs)
+{
+    if (m_outputs == outputs)
+        return;
+    m_outputs = outputs;
+    qInfo() << "OutputPlacement: enabled outputs" << enabledOutputs();
+    emit outputsChanged();
+
+    for (const QPointer<QSortFilterProxyModel> &model : std::as_const(m_models)) {
+        if (model)
+            model->invalidate();
+    }
+    updateSurfaces();
+}
+
+bool OutputPlacement::isOutputEnabled(const QString &name) const
+{
+    if (!m_enabledOverride.isEmpty())
+        return m_enabledOverride.contains(name);
+    // cluster 就是主視窗，永遠存在
+    if (name == clusterOutput())
+        return true;
+    const QJsonObject config = outputConfig(name);
+    return !config.isEmpty() && config.value(QStringLiteral("enabled")).toBool(true);
+}
+
+QStringList OutputPlacement::enabledOutputs() const
+{
+    QStringList names{clusterOutput()};
+    for (const QJsonValue &value : m_outputs) {
+        const QString name = value.toObject().value(QStringLiteral("name")).toString();
+        if (!name.isEmpty() && !names.contains(name) && isOutputEnabled(name))
+            names.append(name);
+    }
+    return names;
+}
+
+QJsonObject OutputPlacement::outputConfig(const QString &name) const
+{
+    for (const QJsonValue &value : m_outputs) {
+        const QJsonObject output = value.toObject();
+        if (output.value(QStringLiteral("name")).toString() == name)
+            return output;
+    }
+    return QJsonObject();
+}
+
+QString OutputPlacement::outputForAppId(const QString &appId) const
+{
+    const QString package = PackageSurfaceMatcher::packageFromAppId(appId);
+    QString fallback;
+    if (!package.isEmpty()) {
+        for (const QJsonValue &value : m_outputs) {
+            const QJsonObject output = value.toObject();
+            const QString name = output.value(QStringLiteral("name")).toString();
+            if (name.isEmpty() || !isOutputEnabled(name))
+                continue;
+            const QJsonArray apps = output.value(QStringLiteral("apps")).toArray();
+            for (const QJsonValue &app : apps) {
+                const QString pattern = app.toString().trimmed();
+                if (pattern == QLatin1String("*")) {
+                    if (fallback.isEmpty())
+                        fallback = name;
+                } else if (!pattern.isEmpty() && matchesPattern(pattern, package)) {
+                    return name;
+                }
+            }
+        }
+    } else {
+        // app_id 還沒到：先放在寫了 "*" 的 output
+        for (const QJsonValue &value : m_outputs) {
+            const QJsonObject output = value.toObject();
+            const QString name = output.value(QStringLiteral("name")).toString();
+            if (!name.isEmpty() && isOutputEnabled(name)
+                && output.value(QStringLiteral("apps")).toArray().contains(QStringLiteral("*"))) {
+                fallback = name;
+                break;
+            }
+        }
+    }
+    return fallback.isEmpty() ? clusterOutput() : fallback;
+}
+
+QString OutputPlacement::outputForSurface(QWaylandSurface *surface) const
+{
+    QWaylandXdgToplevel *toplevel = m_registry->toplevelFor(surface);
+    return outputForAppId(toplevel ? toplevel->appId() : QString());
+}
+
+QString OutputPlacement::outputOf(QObject *surface) const
+{
+    auto *waylandSurface = qobject_cast<QWaylandSurface *>(surface);
+    return waylandSurface ? outputForSurface(waylandSurface) : QString();
+}
+
+QAbstractItemModel *OutputPlacement::surfacesFor(const QString &name)
+{
+    QPointer<QSortFilterProxyModel> &model = m_models[name];
+    if (!model)
+        model = new OutputSurfaceModel(this, m_registry, name);
+    return model;
+}
+
+void OutputPlacement::updateSurfaces()
+{
+    QList<QPair<QWaylandSurface *, QString>> changed;
+    QSet<QString> affected;   // 有列要移出 / 移入的 output
+    const QList<QWaylandSurface *> surfaces = m_registry->rowSurfaces();
+    for (QWaylandSurface *surface : surfaces) {
+        const QString output = outputForSurface(surface);
+        auto it = m_lastOutput.find(surface);
+        if (it == m_lastOutput.end()) {
+            // 新的列：proxy 在 rowsInserted 時已經用目前的 output 過濾過
+            m_lastOutput.insert(surface, output);
+            if (output != clusterOutput())
+                changed.append({surface, output});
+        } else if (*it != output) {
+            affected.insert(*it);
+            affected.insert(output);
+            *it = output;
+            changed.append({surface, output});
+        }
+    }
+
+    // 先更新 model 再發訊號，QML 收到時各 output 的 Repeater 已經是新的內容
+    for (const QString &name : std::as_const(affected)) {
+        if (auto *model = static_cast<OutputSurfaceModel *>(m_models.value(name).data()))
+            model->refilter();
+    }
+    for (const auto &change : std::as_const(changed))
+        emit surfaceOutputChanged(change.first, change.second);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+
+class QSortFilterProxyModel;
+class QWaylandSurface;
+class SurfaceRegistry;
+
+/**
+ * OutputPlacement
+ *
+ * 多螢幕（儀表 cluster + 中控 center）時，每個 app surface 要顯示在哪一個 output
+ * （QML 中以 xdgShellHelper.placement 取得）。規則來自 config.json 的 outputs：
+ *
+ *     "outputs": [
+ *       {"name": "cluster", "apps": ["*"]},
+ *       {"name": "center", "enabled": true, "screen": "HDMI-A-1", "width": 1280, "height": 720,
+ *        "apps": ["com.google.android.apps.maps", "com.spotify.*"]}
+ *     ]
+ *
+ * - apps 以包名（app_id 去掉 "waydroid."）比對，可用 * 萬用字元；先比對所有 output 的具體規則，
+ *   都不符合時才給寫了 "*" 的 output，再沒有就是 cluster
+ * - 停用的 output 不分配 surface；SMART_DASHBOARD_OUTPUTS=cluster,center 可覆寫 config 的 enabled
+ * - app_id 還沒送到的 surface 先放在預設 output，app_id 到了之後才移過去（發出 surfaceOutputChanged）
+ *
+ * surfacesFor(name) 回傳 SurfaceRegistry 的過濾 model，給各 output 視窗的 Repeater 用。
+ */
+class OutputPlacement : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QJsonArray outputs READ outputs WRITE setOutputs NOTIFY outputsChanged)
+    Q_PROPERTY(QStringList enabledOutputs READ enabledOutputs NOTIFY outputsChanged)
+
+public:
+    static QString clusterOutput() { return QStringLiteral("cluster"); }
+
+    explicit OutputPlacement(SurfaceRegistry *registry, QObject *parent = nullptr);
+
+    QJsonArray outputs() const { return m_outputs; }
+    void setOutputs(const QJsonArray &outputs);
+    QStringList enabledOutputs() const;
+
+    // appId 可以是 xdg app_id 或包名
+    Q_INVOKABLE QString outputForAppId(const QString &appId) const;
+    QString outputForSurface(QWaylandSurface *surface) const;
+
+    Q_INVOKABLE QString outputOf(QObject *surface) const;
+    Q_INVOKABLE bool isOutputEnabled(const QString &name) const;
+    // config.json 中該 output 的設定（screen / width / height ...）；沒有時為空物件
+    Q_INVOKABLE QJsonObject outputConfig(const QString &name) const;
+    // 分配到該 output 的 surface（SurfaceRegistry 的過濾 model，role 相同）
+    Q_INVOKABLE QAbstractItemModel *surfacesFor(const QString &name);
+
+signals:
+    void outputsChanged();
+    void surfaceOutputChanged(QWaylandSurface *surface, const QString &output);
+
+private:
+    void updateSurfaces();
+
+    SurfaceRegistry *m_registry;
+    QJsonArray m_outputs;
+    QStringList m_enabledOverride;   // SMART_DASHBOARD_OUTPUTS；空表示依 config
+    QHash<QWaylandSurface *, QString> m_lastOutput;
+    QHash<QString, QPointer<QSortFilterProxyModel>> m_models;
+};
@@ -0,0 +1,158 @@
+#include "packagesurfacematcher.h"
+
+#include <QDebug>
+
+#include <QtWaylandCompositor/QWaylandSurface>
+
+namespace {
+
+const QLatin1String WaydroidAppIdPrefix("waydroid.");
+
+} // namespace
+
+PackageSurfaceMatcher::PackageSurfaceMatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QString PackageSurfaceMatcher::packageFromAppId(const QString &appId)
+{
+    QString key = appId.trimmed().toLower();
+    if (key.startsWith(WaydroidAppIdPrefix))
+        key.remove(0, WaydroidAppIdPrefix.size());
+    return key;
+}
+
+QObject *PackageSurfaceMatcher::expectLaunch(const QString &packageName, int deadlineMs, qint64 clientPid)
+{
+    purgeExpired();
+    const QString key = packageName.trimmed().toLower();
+    if (key.isEmpty())
+        return nullptr;
+
+    if (QWaylandSurface *surface = m_surfaceByPackage.value(key))
+        return surface;
+
+    Pending pending;
+    pending.packageName = packageName;
+    pending.titleKey = key.section(QLatin1Char('.'), -1);
+    pending.clientPid = clientPid;
+    pending.deadline = QDeadlineTimer(deadlineMs);
+
+    // 同一個包名重複點擊只更新期限
+    const auto previous = m_pending.constFind(key);
+    if (previous != m_pending.cend() && previous->clientPid)
+        m_pendingByPid.remove(previous->clientPid);
+    const bool added = previous == m_pending.cend();
+    m_pending.insert(key, pending);
+    if (clientPid)
+        m_pendingByPid.insert(clientPid, key);
+    if (added)
+        emit pendingCountChanged();
+    return nullptr;
+}
+
+QObject *PackageSurfaceMatcher::surfaceForPackage(const QString &packageName) const
+{
+    return m_surfaceByPackage.value(packageName.trimmed().toLower());
+}
+
+QString PackageSurfaceMatcher::packageForSurface(QObject *surface) const
+{
+    return m_packageBySurface.value(static_cast<QWaylandSurface *>(surface));
+}
+
+void PackageSurfaceMatcher::offerSurface(QWaylandSurface *surface, const QString &appId,
+                                         const QString &title, qint64 clientPid)
+{
+    if (!surface)
+        return;
+    purgeExpired();
+
+    // 1. app_id：權威來源，沒有等待中的啟動也記下來
+    const QString key = packageFromAppId(appId);
+    if (!key.isEmpty()) {
+        if (m_packageBySurface.value(surface) != key || m_pending.contains(key))
+            bind(key, surface, AppId);
+        return;
+    }
+
+    // 已經對應過的 surface 不再用 PID / 標題猜
+    if (m_packageBySurface.contains(surface))
+        return;
+
+    // 2. client PID
+    if (clientPid) {
+        const QString pidKey = m_pendingByPid.value(clientPid);
+        if (!pidKey.isEmpty()) {
+            bind(pidKey, surface, ClientPid);
+            return;
+        }
+    }
+
+    // 3. 標題：只掃等待中的啟動（通常只有一兩筆），鍵都是預先算好的小寫字串
+    if (title.isEmpty() || m_pending.isEmpty())
+        return;
+    const QString lowerTitle = title.toLower();
+    for (auto it = m_pending.cbegin(); it != m_pending.cend(); ++it) {
+        if (lowerTitle.contains(it.key()) || lowerTitle.contains(it->titleKey)) {
+            bind(it.key(), surface, Title);
+            return;
+        }
+    }
+}
+
+void PackageSurfaceMatcher::registerSurface(const QString &packageName, QWaylandSurface *surface)
+{
+    const QString key = packageName.trimmed().toLower();
+    if (surface && !key.isEmpty())
+        bind(key, surface, AppId);
+}
+
+void PackageSurfaceMatcher::removeSurface(QWaylandSurface *surface)
+{
+    const QString key = m_packageBySurface.take(surface);
+    if (!key.isEmpty() && m_surfaceByPackage.value(key) == surface)
+        m_surfaceByPackage.remove(key);
+}
+
+void PackageSurfaceMatcher::bind(const QString &key, QWaylandSurface *surface, MatchMethod method)
+{
+    // surface 改對應到別的包名（例如標題猜錯後 app_id 才送來）
+    const QString oldKey = m_packageBySurface.value(surface);
+    if (!oldKey.isEmpty() && oldKey != key && m_surfaceByPackage.value(oldKey) == surface)
+        m_surfaceByPackage.remove(oldKey);
+
+    m_surfaceByPackage.insert(key, surface);
+    m_packageBySurface.insert(surface, key);
+
+    const auto it = m_pending.constFind(key);
+    if (it == m_pending.cend())
+        return;
+
+    const Pending pending = *it;
+    m_pending.erase(it);
+    if (pending.clientPid)
+        m_pendingByPid.remove(pending.clientPid);
+    qInfo() << "PackageSurfaceMatcher: matched" << pending.packageName << "by" << method;
+    emit pendingCountChanged();
+    emit surfaceMatched(pending.packageName, surface, method);
+}
+
+void PackageSurfaceMatcher::purgeExpired()
+{
+    bool removed = false;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->deadline.hasExpired()) {
+            qInfo() << "PackageSurfaceMatcher: launch expired without a surface:" << it->packageName;
+            if (it->clientPid)
+                m_pendingByPid.remove(it->clientPid);
+            it = m_pending.erase(it);
+            removed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (removed)
+        emit pendingCountChanged();
+}
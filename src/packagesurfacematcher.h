@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class QWaylandSurface;
+
+/**
+ * PackageSurfaceMatcher
+ *
+ * Android 包名 ↔ Wayland surface 的對應（QML 中以 xdgShellHelper.packageMatcher 取得）。
+ * Waydroid 多視窗模式下每個 app 的 xdg_toplevel app_id 是 "waydroid.<包名>"，所以以 app_id 為主鍵：
+ *
+ * 1. app_id：去掉 "waydroid." 前綴、轉小寫後直接查 hash（就算沒有等待中的啟動也記下來，
+ *    之後再點同一個 app 時 expectLaunch() 立刻回傳既有的 surface）
+ * 2. client PID：expectLaunch() 帶了 PID（非 Waydroid 的原生 client）時以 PID 查 hash
+ * 3. 標題：只有 app_id 為空時才退回，用預先算好的小寫包名 / 最後一段比對等待中的啟動
+ *
+ * 每個等待中的啟動帶一個期限，過期的在下一次 expectLaunch / offerSurface 時清掉。
+ */
+class PackageSurfaceMatcher : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY pendingCountChanged)
+
+public:
+    enum MatchMethod {
+        AppId,
+        ClientPid,
+        Title
+    };
+    Q_ENUM(MatchMethod)
+
+    static constexpr int DefaultDeadlineMs = 30000;
+
+    explicit PackageSurfaceMatcher(QObject *parent = nullptr);
+
+    // 登記一次啟動；該包名已有 surface 時直接回傳（不進等待清單）
+    Q_INVOKABLE QObject *expectLaunch(const QString &packageName, int deadlineMs = DefaultDeadlineMs,
+                                      qint64 clientPid = 0);
+    Q_INVOKABLE QObject *surfaceForPackage(const QString &packageName) const;
+    Q_INVOKABLE QString packageForSurface(QObject *surface) const;
+
+    // toplevel 建立、app_id 或標題改變時呼叫
+    void offerSurface(QWaylandSurface *surface, const QString &appId, const QString &title, qint64 clientPid);
+    // 手動指定對應（例如由外部得知包名時）
+    void registerSurface(const QString &packageName, QWaylandSurface *surface);
+    void removeSurface(QWaylandSurface *surface);
+
+    int pendingCount() const { return m_pending.size(); }
+
+    // "waydroid.com.example.app" → "com.example.app"（小寫）
+    static QString packageFromAppId(const QString &appId);
+
+signals:
+    void surfaceMatched(const QString &packageName, QObject *surface, PackageSurfaceMatcher::MatchMethod method);
+    void pendingCountChanged();
+
+private:
+    struct Pending {
+        QString packageName;   // 原始大小寫，signal 用
+        QString titleKey;      // 包名最後一段（小寫），標題比對用
+        qint64 clientPid = 0;
+        QDeadlineTimer deadline;
+    };
+
+    void bind(const QString &key, QWaylandSurface *surface, MatchMethod method);
+    void purgeExpired();
+
+    QHash<QString, Pending> m_pending;                           // key：小寫包名
+    QHash<qint64, QString> m_pendingByPid;                       // client PID → key
+    QHash<QString, QPointer<QWaylandSurface>> m_surfaceByPackage; // key → surface
+    QHash<QWaylandSurface *, QString> m_packageBySurface;
+};
@@ -0,0 +1,222 @@
+#include "polygonframeitem.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGRenderNode>
+#include <QSGRendererInterface>
+#include <QSGVertexColorMaterial>
+
+#include <array>
+#include <cmath>
+
+namespace {
+
+// 由外而內四圈頂點：外側漸層、外緣、內緣、內側漸層
+constexpr int RingCount = 4;
+// 尖角處的斜接長度上限（相對於半線寬），避免很尖的角拉出長刺
+constexpr qreal MiterLimit = 4.0;
+
+QPointF normalized(const QPointF &v)
+{
+    const qreal length = std::hypot(v.x(), v.y());
+    return length > 0.0 ? v / length : QPointF();
+}
+
+// 去掉重合的相鄰頂點（例如 slopeRatio = 0 時），否則法向量無法計算
+QPolygonF withoutDuplicates(const QPolygonF &outline)
+{
+    QPolygonF result;
+    result.reserve(outline.size());
+    for (const QPointF &p : outline) {
+        if (result.isEmpty() || std::hypot(p.x() - result.last().x(), p.y() - result.last().y()) > 1e-4)
+            result.append(p);
+    }
+    while (result.size() > 1
+           && std::hypot(result.first().x() - result.last().x(), result.first().y() - result.last().y()) <= 1e-4)
+        result.removeLast();
+    return result;
+}
+
+// software 後端不支援自訂幾何節點：改用 QPainter 直接畫同一組頂點
+class SoftwareOutlineNode : public QSGRenderNode {
+public:
+    explicit SoftwareOutlineNode(QQuickWindow *window) : m_window(window) {}
+
+    void setOutline(const QPolygonF &outline, qreal lineWidth, const QColor &color)
+    {
+        m_outline = outline;
+        m_pen = QPen(color, lineWidth, Qt::SolidLine, Qt::FlatCap, Qt::MiterJoin);
+        m_bounds = outline.boundingRect().adjusted(-lineWidth * MiterLimit, -lineWidth * MiterLimit,
+                                                   lineWidth * MiterLimit, lineWidth * MiterLimit);
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    void render(const RenderState *state) override
+    {
+        auto *painter = static_cast<QPainter *>(
+            m_window->rendererInterface()->getResource(m_window, QSGRendererInterface::PainterResource));
+        if (!painter)
+            return;
+        painter->save();
+        painter->setTransform(matrix()->toTransform());
+        painter->setOpacity(inheritedOpacity());
+        if (state->clipRegion() && !state->clipRegion()->isEmpty())
+            painter->setClipRegion(*state->clipRegion(), Qt::ReplaceClip);
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(m_pen);
+        painter->setBrush(Qt::NoBrush);
+        painter->drawPolygon(m_outline);
+        painter->restore();
+    }
+
+    RenderingFlags flags() const override { return BoundedRectRendering | DepthAwareRendering; }
+    QRectF rect() const override { return m_bounds; }
+
+private:
+    QQuickWindow *m_window;
+    QPolygonF m_outline;
+    QPen m_pen;
+    QRectF m_bounds;
+};
+
+} // namespace
+
+PolygonFrameItem::PolygonFrameItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void PolygonFrameItem::setLineWidth(qreal width)
+{
+    if (qFuzzyCompare(m_lineWidth, width))
+        return;
+    m_lineWidth = width;
+    emit lineWidthChanged();
+    invalidateOutline();
+}
+
+void PolygonFrameItem::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+    invalidateOutline();
+}
+
+void PolygonFrameItem::invalidateOutline()
+{
+    m_outlineDirty = true;
+    update();
+}
+
+void PolygonFrameItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    // 只有大小影響外框；單純移動位置由 transform node 處理，不需要重建頂點
+    if (newGeometry.size() != oldGeometry.size())
+        invalidateOutline();
+}
+
+QSGNode *PolygonFrameItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    if (oldNode && !m_outlineDirty)
+        return oldNode;
+    m_outlineDirty = false;
+
+    const QPolygonF outline = withoutDuplicates(buildOutline());
+    if (outline.size() < 3 || m_lineWidth <= 0.0 || !m_color.isValid()) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    if (window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) {
+        auto *softwareNode = static_cast<SoftwareOutlineNode *>(oldNode);
+        if (!softwareNode)
+            softwareNode = new SoftwareOutlineNode(window());
+        softwareNode->setOutline(outline, m_lineWidth, m_color);
+        return softwareNode;
+    }
+
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0,
+                                         QSGGeometry::UnsignedShortType);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    const int count = outline.size();
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(count * RingCount, count * (RingCount - 1) * 6);
+
+    // 漸層寬度為一個裝置像素
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    const qreal feather = 1.0 / dpr;
+    // 實心部分左右各 core，外加一圈 feather 漸層，整體視覺寬度約等於 lineWidth
+    const qreal core = qMax<qreal>(0.0, (m_lineWidth - feather) / 2.0);
+    const qreal offsets[RingCount] = {core + feather, core, -core, -core - feather};
+    // 線寬不到一個像素時以透明度代替寬度
+    const qreal coreAlpha = qMin<qreal>(1.0, m_lineWidth / feather);
+
+    // 頂點色為 premultiplied alpha
+    const QColor rgb = m_color.toRgb();
+    const auto vertexColor = [&](qreal alpha) {
+        const qreal a = rgb.alphaF() * alpha;
+        return std::array<uchar, 4>{uchar(qRound(rgb.redF() * a * 255)), uchar(qRound(rgb.greenF() * a * 255)),
+                                    uchar(qRound(rgb.blueF() * a * 255)), uchar(qRound(a * 255))};
+    };
+    const std::array<uchar, 4> ringColors[RingCount] = {vertexColor(0.0), vertexColor(coreAlpha),
+                                                        vertexColor(coreAlpha), vertexColor(0.0)};
+
+    QSGGeometry::ColoredPoint2D *vertices = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < count; ++i) {
+        const QPointF &p = outline.at(i);
+        const QPointF &prev = outline.at((i + count - 1) % count);
+        const QPointF &next = outline.at((i + 1) % count);
+        const QPointF e0 = normalized(p - prev);
+        const QPointF e1 = normalized(next - p);
+        const QPointF n0(-e0.y(), e0.x());
+        const QPointF n1(-e1.y(), e1.x());
+
+        // 斜接方向；兩條邊幾乎反向時退回前一條邊的法向量
+        QPointF miter = normalized(n0 + n1);
+        qreal cosine = QPointF::dotProduct(miter, n0);
+        if (cosine < 1e-3) {
+            miter = n0;
+            cosine = 1.0;
+        }
+        const qreal scale = qMin(1.0 / cosine, MiterLimit);
+
+        for (int ring = 0; ring < RingCount; ++ring) {
+            const QPointF v = p + miter * (offsets[ring] * scale);
+            const std::array<uchar, 4> &c = ringColors[ring];
+            vertices[ring * count + i].set(float(v.x()), float(v.y()), c[0], c[1], c[2], c[3]);
+        }
+    }
+
+    // 相鄰兩圈之間、每條邊兩個三角形
+    quint16 *indices = geometry->indexDataAsUShort();
+    for (int ring = 0; ring < RingCount - 1; ++ring) {
+        const int outer = ring * count;
+        const int inner = (ring + 1) * count;
+        for (int i = 0; i < count; ++i) {
+            const int j = (i + 1) % count;
+            *indices++ = quint16(outer + i);
+            *indices++ = quint16(outer + j);
+            *indices++ = quint16(inner + i);
+            *indices++ = quint16(inner + i);
+            *indices++ = quint16(outer + j);
+            *indices++ = quint16(inner + j);
+        }
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QColor>
+#include <QPolygonF>
+#include <QQuickItem>
+
+/**
+ * PolygonFrameItem
+ *
+ * 以 scene graph 原生節點畫出封閉多邊形外框（取代 QML Canvas）。
+ * Canvas 在 CPU 上光柵化、每次寬高改變都要重跑 JS onPaint；這裡外框是一個 QSGGeometryNode，
+ * 頂點只在輸入（大小、線寬、顏色、子類的形狀參數）改變時重建，其他幀直接沿用。
+ *
+ * 子類只需要實作 buildOutline() 回傳頂點，形狀參數改變時呼叫 invalidateOutline()。
+ * 邊緣有一個像素寬的漸層，在沒有 MSAA 的視窗（以及 software 後端）上也不會有鋸齒。
+ */
+class PolygonFrameItem : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
+
+public:
+    explicit PolygonFrameItem(QQuickItem *parent = nullptr);
+
+    qreal lineWidth() const { return m_lineWidth; }
+    void setLineWidth(qreal width);
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+
+signals:
+    void lineWidthChanged();
+    void colorChanged();
+
+protected:
+    // 外框中心線的頂點（item 座標，依序、不需重複第一點）
+    virtual QPolygonF buildOutline() const = 0;
+    void invalidateOutline();
+
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+    qreal m_lineWidth = 2.0;
+    QColor m_color = Qt::white;
+    bool m_outlineDirty = true;
+};
@@ -0,0 +1,353 @@
+#include "segmentedbargauge.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGRenderNode>
+#include <QSGRendererInterface>
+#include <QSGVertexColorMaterial>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+constexpr int VerticesPerSegment = 4;
+constexpr int IndicesPerSegment = 6;
+
+template <typename T>
+bool assign(T &member, const T &value)
+{
+    if (member == value)
+        return false;
+    member = value;
+    return true;
+}
+
+// software 後端不支援自訂幾何節點：以 QPainter 畫同一組段落
+class SoftwareSegmentsNode : public QSGRenderNode {
+public:
+    explicit SoftwareSegmentsNode(QQuickWindow *window) : m_window(window) {}
+
+    void setSegments(const QVector<QPolygonF> &segments)
+    {
+        m_segments = segments;
+        m_colors.resize(segments.size());
+        m_bounds = QRectF();
+        for (const QPolygonF &segment : segments)
+            m_bounds |= segment.boundingRect();
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    void setColor(int index, const QColor &color)
+    {
+        m_colors[index] = color;
+        markDirty(QSGNode::DirtyMaterial);
+    }
+
+    void render(const RenderState *state) override
+    {
+        auto *painter = static_cast<QPainter *>(
+            m_window->rendererInterface()->getResource(m_window, QSGRendererInterface::PainterResource));
+        if (!painter)
+            return;
+        painter->save();
+        painter->setTransform(matrix()->toTransform());
+        painter->setOpacity(inheritedOpacity());
+        if (state->clipRegion() && !state->clipRegion()->isEmpty())
+            painter->setClipRegion(*state->clipRegion(), Qt::ReplaceClip);
+        painter->setPen(Qt::NoPen);
+        for (int i = 0; i < m_segments.size(); ++i) {
+            painter->setBrush(m_colors.at(i));
+            painter->drawPolygon(m_segments.at(i));
+        }
+        painter->restore();
+    }
+
+    RenderingFlags flags() const override { return BoundedRectRendering | DepthAwareRendering; }
+    QRectF rect() const override { return m_bounds; }
+
+private:
+    QQuickWindow *m_window;
+    QVector<QPolygonF> m_segments;
+    QVector<QColor> m_colors;
+    QRectF m_bounds;
+};
+
+} // namespace
+
+SegmentedBarGauge::SegmentedBarGauge(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void SegmentedBarGauge::setBend(Bend value)
+{
+    if (assign(m_bend, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setSegmentWidth(qreal value)
+{
+    if (assign(m_segmentWidth, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setSkewRatio(qreal value)
+{
+    if (assign(m_skewRatio, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setGap(qreal value)
+{
+    if (assign(m_gap, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setOriginX(qreal value)
+{
+    if (assign(m_originX, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setTopMargin(qreal value)
+{
+    if (assign(m_topMargin, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setBottomMargin(qreal value)
+{
+    if (assign(m_bottomMargin, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setHalfHeightSegments(const QList<int> &value)
+{
+    if (assign(m_halfHeightSegments, value))
+        invalidateLayout();
+}
+
+void SegmentedBarGauge::setAccentSegments(int value)
+{
+    if (assign(m_accentSegments, value))
+        invalidateColors();
+}
+
+void SegmentedBarGauge::setLitColor(const QColor &value)
+{
+    if (assign(m_litColor, value))
+        invalidateColors();
+}
+
+void SegmentedBarGauge::setUnlitColor(const QColor &value)
+{
+    if (assign(m_unlitColor, value))
+        invalidateColors();
+}
+
+void SegmentedBarGauge::setAccentColor(const QColor &value)
+{
+    if (assign(m_accentColor, value))
+        invalidateColors();
+}
+
+void SegmentedBarGauge::setSegmentCount(int count)
+{
+    count = qBound(0, count, 64);
+    if (m_segmentCount == count)
+        return;
+    m_segmentCount = count;
+    invalidateLayout();
+}
+
+void SegmentedBarGauge::setLitCount(int count)
+{
+    count = qBound(0, count, m_segmentCount);
+    if (m_litCount == count)
+        return;
+    m_litCount = count;
+    invalidateColors();
+}
+
+void SegmentedBarGauge::invalidateLayout()
+{
+    emit layoutInputsChanged();
+    // 元件建立期間屬性會一個個設定進來，等 componentComplete() 再一次算
+    if (isComponentComplete())
+        updateLayout();
+}
+
+void SegmentedBarGauge::invalidateColors()
+{
+    emit colorsChanged();
+    m_colorsDirty = true;
+    update();
+}
+
+void SegmentedBarGauge::componentComplete()
+{
+    QQuickItem::componentComplete();
+    updateLayout();
+}
+
+void SegmentedBarGauge::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size() && isComponentComplete())
+        updateLayout();
+}
+
+void SegmentedBarGauge::updateLayout()
+{
+    const int count = m_segmentCount;
+    const int pivot = count / 2;
+    const qreal direction = m_bend == BendLeft ? -1.0 : 1.0;
+
+    int halfCount = 0;
+    for (int index : std::as_const(m_halfHeightSegments)) {
+        if (index >= 0 && index < count)
+            ++halfCount;
+    }
+    const qreal units = (count - halfCount) + halfCount * 0.5;
+    const qreal available = height() - m_topMargin - m_bottomMargin - qMax(0, count - 1) * m_gap;
+    m_segmentHeight = units > 0.0 ? qMax<qreal>(0.0, available / units) : 0.0;
+
+    m_segments.resize(count);
+    m_segmentGeometry.clear();
+    m_segmentGeometry.reserve(count);
+
+    // 由上往下一段段接：每段的上緣接在上一段底邊的延長線上（隔一個 gap）
+    qreal y = m_topMargin;
+    qreal baseX = m_originX;
+    qreal prevBottomX = 0.0;
+    qreal prevSlope = 0.0;
+    qreal prevDirection = 0.0;
+    for (int i = 0; i < count; ++i) {
+        const bool half = m_halfHeightSegments.contains(i);
+        const qreal h = half ? m_segmentHeight / 2.0 : m_segmentHeight;
+        const qreal s = h * m_skewRatio;
+        const qreal dir = i < pivot ? direction : -direction;
+
+        if (i > 0) {
+            baseX = i == pivot ? prevBottomX : prevBottomX + prevDirection * prevSlope * m_gap;
+        }
+
+        m_segments[i] = QPolygonF({
+            QPointF(baseX, y),
+            QPointF(baseX + m_segmentWidth, y),
+            QPointF(baseX + m_segmentWidth + dir * s, y + h),
+            QPointF(baseX + dir * s, y + h),
+        });
+        m_segmentGeometry.append(QVariantMap{
+            {QStringLiteral("x"), baseX},
+            {QStringLiteral("y"), y},
+            {QStringLiteral("height"), h},
+            {QStringLiteral("skew"), dir * s},
+        });
+
+        prevBottomX = baseX + dir * s;
+        prevSlope = h > 0.0 ? s / h : 0.0;
+        prevDirection = dir;
+        y += h + m_gap;
+    }
+
+    m_geometryDirty = true;
+    m_colorsDirty = true;
+    update();
+    emit layoutChanged();
+}
+
+QColor SegmentedBarGauge::segmentColor(int index) const
+{
+    if (index < m_segmentCount - m_litCount)
+        return m_unlitColor;
+    return index < m_accentSegments ? m_accentColor : m_litColor;
+}
+
+QSGNode *SegmentedBarGauge::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    const int count = m_segments.size();
+    if (count == 0 || m_segmentHeight <= 0.0) {
+        delete oldNode;
+        return nullptr;
+    }
+    if (oldNode && !m_geometryDirty && !m_colorsDirty)
+        return oldNode;
+
+    if (window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) {
+        auto *node = static_cast<SoftwareSegmentsNode *>(oldNode);
+        if (!node) {
+            node = new SoftwareSegmentsNode(window());
+            m_geometryDirty = true;
+        }
+        if (m_geometryDirty)
+            node->setSegments(m_segments);
+        for (int i = 0; i < count; ++i)
+            node->setColor(i, segmentColor(i));
+        m_geometryDirty = false;
+        m_colorsDirty = false;
+        return node;
+    }
+
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0,
+                                         QSGGeometry::UnsignedShortType);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        m_geometryDirty = true;
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    if (geometry->vertexCount() != count * VerticesPerSegment) {
+        geometry->allocate(count * VerticesPerSegment, count * IndicesPerSegment);
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int i = 0; i < count; ++i) {
+            const quint16 base = quint16(i * VerticesPerSegment);
+            const quint16 quad[IndicesPerSegment] = {base, quint16(base + 1), quint16(base + 2),
+                                                     base, quint16(base + 2), quint16(base + 3)};
+            std::copy(std::begin(quad), std::end(quad), indices + i * IndicesPerSegment);
+        }
+        m_geometryDirty = true;
+    }
+
+    QSGGeometry::ColoredPoint2D *vertices = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < count; ++i) {
+        // 頂點色為 premultiplied alpha
+        const QColor color = segmentColor(i).toRgb();
+        const qreal a = color.alphaF();
+        const uchar r = uchar(qRound(color.redF() * a * 255));
+        const uchar g = uchar(qRound(color.greenF() * a * 255));
+        const uchar b = uchar(qRound(color.blueF() * a * 255));
+        const uchar alpha = uchar(qRound(a * 255));
+
+        QSGGeometry::ColoredPoint2D *v = vertices + i * VerticesPerSegment;
+        if (m_geometryDirty) {
+            const QPolygonF &quad = m_segments.at(i);
+            for (int k = 0; k < VerticesPerSegment; ++k)
+                v[k].set(float(quad.at(k).x()), float(quad.at(k).y()), r, g, b, alpha);
+        } else {
+            // 只換顏色：位置維持不變
+            for (int k = 0; k < VerticesPerSegment; ++k) {
+                v[k].r = r;
+                v[k].g = g;
+                v[k].b = b;
+                v[k].a = alpha;
+            }
+        }
+    }
+
+    m_geometryDirty = false;
+    m_colorsDirty = false;
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QColor>
+#include <QList>
+#include <QPolygonF>
+#include <QQuickItem>
+#include <QVariantList>
+#include <QVector>
+
+/**
+ * SegmentedBarGauge
+ *
+ * 由上往下堆疊的斜切段條（轉速表、油量表），所有段落放在同一個頂點緩衝區、一次 draw call。
+ *
+ * - 段落位置只在大小或版面參數改變時重算；點亮狀態改變時只改頂點顏色，不重算幾何
+ * - 上半部（index < pivot）往 bend 方向斜，下半部往反方向斜，第 pivot 段直接接在上一段底邊
+ * - halfHeightSegments 中的段落高度（與斜切量）為一半
+ * - 點亮順序由下往上：index >= segmentCount - litCount 為點亮；最上面 accentSegments 段點亮時用 accentColor
+ *
+ * 刻度文字等 QML 元素可用 segmentGeometry[i] = {x, y, height, skew} 對齊段落（x 為上緣左端點），
+ * skew 的正負號即為該段斜的方向。
+ */
+class SegmentedBarGauge : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(int segmentCount READ segmentCount WRITE setSegmentCount NOTIFY layoutInputsChanged)
+    Q_PROPERTY(QList<int> halfHeightSegments READ halfHeightSegments WRITE setHalfHeightSegments NOTIFY layoutInputsChanged)
+    Q_PROPERTY(Bend bend READ bend WRITE setBend NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal segmentWidth READ segmentWidth WRITE setSegmentWidth NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal skewRatio READ skewRatio WRITE setSkewRatio NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal gap READ gap WRITE setGap NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal originX READ originX WRITE setOriginX NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal topMargin READ topMargin WRITE setTopMargin NOTIFY layoutInputsChanged)
+    Q_PROPERTY(qreal bottomMargin READ bottomMargin WRITE setBottomMargin NOTIFY layoutInputsChanged)
+    Q_PROPERTY(int litCount READ litCount WRITE setLitCount NOTIFY colorsChanged)
+    Q_PROPERTY(int accentSegments READ accentSegments WRITE setAccentSegments NOTIFY colorsChanged)
+    Q_PROPERTY(QColor litColor READ litColor WRITE setLitColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor unlitColor READ unlitColor WRITE setUnlitColor NOTIFY colorsChanged)
+    Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor NOTIFY colorsChanged)
+    Q_PROPERTY(qreal segmentHeight READ segmentHeight NOTIFY layoutChanged)
+    Q_PROPERTY(QVariantList segmentGeometry READ segmentGeometry NOTIFY layoutChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
+
+public:
+    // 上半部往下時往哪邊斜：Left 為「<」形（轉速表），Right 為「>」形（油量表）
+    enum Bend { BendLeft, BendRight };
+    Q_ENUM(Bend)
+
+    explicit SegmentedBarGauge(QQuickItem *parent = nullptr);
+
+    int segmentCount() const { return m_segmentCount; }
+    void setSegmentCount(int count);
+    QList<int> halfHeightSegments() const { return m_halfHeightSegments; }
+    void setHalfHeightSegments(const QList<int> &segments);
+    Bend bend() const { return m_bend; }
+    void setBend(Bend bend);
+    qreal segmentWidth() const { return m_segmentWidth; }
+    void setSegmentWidth(qreal width);
+    qreal skewRatio() const { return m_skewRatio; }
+    void setSkewRatio(qreal ratio);
+    qreal gap() const { return m_gap; }
+    void setGap(qreal gap);
+    qreal originX() const { return m_originX; }
+    void setOriginX(qreal x);
+    qreal topMargin() const { return m_topMargin; }
+    void setTopMargin(qreal margin);
+    qreal bottomMargin() const { return m_bottomMargin; }
+    void setBottomMargin(qreal margin);
+
+    int litCount() const { return m_litCount; }
+    void setLitCount(int count);
+    int accentSegments() const { return m_accentSegments; }
+    void setAccentSegments(int count);
+    QColor litColor() const { return m_litColor; }
+    void setLitColor(const QColor &color);
+    QColor unlitColor() const { return m_unlitColor; }
+    void setUnlitColor(const QColor &color);
+    QColor accentColor() const { return m_accentColor; }
+    void setAccentColor(const QColor &color);
+
+    // 全高段的高度（半高段為一半）
+    qreal segmentHeight() const { return m_segmentHeight; }
+    QVariantList segmentGeometry() const { return m_segmentGeometry; }
+
+signals:
+    void layoutInputsChanged();
+    void colorsChanged();
+    void layoutChanged();
+
+protected:
+    void componentComplete() override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+    void invalidateLayout();
+    void invalidateColors();
+    void updateLayout();
+    QColor segmentColor(int index) const;
+
+    int m_segmentCount = 6;
+    QList<int> m_halfHeightSegments;
+    Bend m_bend = BendLeft;
+    qreal m_segmentWidth = 0.0;
+    qreal m_skewRatio = 0.7;
+    qreal m_gap = 0.0;
+    qreal m_originX = 0.0;
+    qreal m_topMargin = 0.0;
+    qreal m_bottomMargin = 0.0;
+
+    int m_litCount = 0;
+    int m_accentSegments = 0;
+    QColor m_litColor = QColor(0xff, 0xf5, 0xc0);
+    QColor m_unlitColor = QColor(0x3a, 0x3a, 0x36);
+    QColor m_accentColor = QColor(0xff, 0x44, 0x44);
+
+    // GUI 執行緒算好的版面；updatePaintNode（GUI 執行緒被擋住時）直接複製
+    QVector<QPolygonF> m_segments;
+    qreal m_segmentHeight = 0.0;
+    QVariantList m_segmentGeometry;
+    bool m_geometryDirty = true;
+    bool m_colorsDirty = true;
+};
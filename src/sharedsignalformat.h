@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * 共享記憶體訊號區段格式（POSIX shm，同一台機器上的 gateway 行程寫入、儀表讀取）
+ *
+ * 固定大小的 struct-of-arrays：每個訊號一個 seqlock 序號、一個值、一個時間戳，
+ * 分別放在連續的陣列裡。讀取端每幀只需要掃過 sequence[] 幾條 cache line 就知道哪些訊號有變，
+ * 整個過程沒有系統呼叫、沒有序列化。
+ *
+ * 約定：
+ * - 每個訊號只有一個寫入者（一個 producer 行程）
+ * - 時間戳為 CLOCK_MONOTONIC 微秒（與 VehicleSignalHub::nowUs() 同一時基）
+ * - 名稱表只會往後追加：先寫好 names[i]，再把 signalCount 加一（release）
+ *
+ * 此檔案不依賴 Qt，producer 工具（tools/shm_producer.cpp）也直接使用。
+ */
+
+namespace SharedSignals {
+
+constexpr char DefaultName[] = "/smart_dashboard_signals";
+constexpr std::uint32_t Magic = 0x48534453u;   // "SDSH"
+constexpr std::uint32_t Version = 1;
+constexpr int MaxSignals = 64;
+constexpr int NameLength = 32;
+
+static_assert(std::atomic<double>::is_always_lock_free, "shared-memory atomics must be lock-free");
+static_assert(std::atomic<std::int64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+struct alignas(64) Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t segmentSize;
+    std::uint32_t producerPid;
+    std::atomic<std::uint32_t> signalCount;     // names[0, signalCount) 有效
+    std::uint32_t reserved;
+    std::atomic<std::uint64_t> generation;      // 任何訊號寫入完成後加一，讀取端用來快速判斷「沒有變化」
+};
+
+struct Segment {
+    Header header;
+    char names[MaxSignals][NameLength];         // NUL 結尾
+    alignas(64) std::atomic<std::uint32_t> sequence[MaxSignals];   // 奇數 = 寫入中
+    alignas(64) std::atomic<double> value[MaxSignals];
+    alignas(64) std::atomic<std::int64_t> timestampUs[MaxSignals];
+};
+
+// ---- 寫入端（producer）----
+
+// 在新建立、已清零的區段上寫入檔頭
+inline void initialize(Segment *segment, std::uint32_t pid)
+{
+    segment->header.magic = Magic;
+    segment->header.version = Version;
+    segment->header.segmentSize = sizeof(Segment);
+    segment->header.producerPid = pid;
+    segment->header.signalCount.store(0, std::memory_order_relaxed);
+    segment->header.generation.store(0, std::memory_order_release);
+}
+
+// 回傳訊號 index；名稱表已滿時回傳 -1
+inline int registerSignal(Segment *segment, const char *name)
+{
+    const std::uint32_t count = segment->header.signalCount.load(std::memory_order_relaxed);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (std::strncmp(segment->names[i], name, NameLength) == 0)
+            return int(i);
+    }
+    if (count >= std::uint32_t(MaxSignals))
+        return -1;
+    std::strncpy(segment->names[count], name, NameLength - 1);
+    segment->names[count][NameLength - 1] = '\0';
+    segment->header.signalCount.store(count + 1, std::memory_order_release);
+    return int(count);
+}
+
+inline void write(Segment *segment, int index, double value, std::int64_t timestampUs)
+{
+    std::atomic<std::uint32_t> &seq = segment->sequence[index];
+    const std::uint32_t start = seq.load(std::memory_order_relaxed);
+    seq.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->value[index].store(value, std::memory_order_relaxed);
+    segment->timestampUs[index].store(timestampUs, std::memory_order_relaxed);
+    seq.store(start + 2, std::memory_order_release);
+    segment->header.generation.fetch_add(1, std::memory_order_release);
+}
+
+// ---- 讀取端 ----
+
+// 讀到一致的快照時回傳 true，並在 *sequence 帶回該快照的序號；寫入中或讀到一半被改寫時回傳 false
+inline bool read(const Segment *segment, int index, double *value, std::int64_t *timestampUs,
+                 std::uint32_t *sequence)
+{
+    const std::atomic<std::uint32_t> &seq = segment->sequence[index];
+    const std::uint32_t before = seq.load(std::memory_order_acquire);
+    if (before & 1u)
+        return false;
+    *value = segment->value[index].load(std::memory_order_relaxed);
+    *timestampUs = segment->timestampUs[index].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq.load(std::memory_order_relaxed) != before)
+        return false;
+    *sequence = before;
+    return true;
+}
+
+} // namespace SharedSignals
@@ -0,0 +1,208 @@
+#include "sharedsignalsource.h"
+#include "vehiclesignalhub.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 沒有新資料超過這個時間就重新 shm_open，以接上重新啟動的 producer（舊的映射會指向已 unlink 的區段）
+constexpr qint64 StaleReattachUs = 2000000;
+constexpr qint64 AttachRetryUs = 1000000;
+constexpr qint64 MaxAttachRetryUs = 30000000;
+// 畫面靜止（沒有幀）時檢查 generation 的間隔；有幀時每次輪詢都會重新計時，不會觸發
+constexpr int IdlePollMs = 100;
+constexpr int MaxReadRetries = 4;
+
+} // namespace
+
+SharedSignalSource *SharedSignalSource::fromConfig(const QJsonObject &shmConfig, VehicleSignalHub *hub,
+                                                   QObject *parent)
+{
+    const QString name = qEnvironmentVariable("SMART_DASHBOARD_SHM", shmConfig.value("name").toString());
+    if (name.isEmpty()) {
+        qDebug() << "SharedSignalSource: no shared-memory segment configured";
+        return nullptr;
+    }
+#ifdef Q_OS_UNIX
+    return new SharedSignalSource(name.startsWith(QLatin1Char('/')) ? name : QLatin1Char('/') + name,
+                                  hub, parent);
+#else
+    Q_UNUSED(hub);
+    Q_UNUSED(parent);
+    qWarning() << "SharedSignalSource: POSIX shared memory is not available on this platform";
+    return nullptr;
+#endif
+}
+
+SharedSignalSource::SharedSignalSource(const QString &segmentName, VehicleSignalHub *hub, QObject *parent)
+    : QObject(parent)
+    , m_segmentName(segmentName)
+    , m_hub(hub)
+    , m_attachRetryUs(AttachRetryUs)
+{
+    std::fill(std::begin(m_idMap), std::end(m_idMap), -1);
+    std::fill(std::begin(m_lastSequence), std::end(m_lastSequence), 0u);
+
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(IdlePollMs);
+    connect(&m_idleTimer, &QTimer::timeout, this, &SharedSignalSource::poll);
+
+    // 先嘗試接上一次：producer 已在執行時，訊號名稱會在錄製器寫檔頭之前註冊好
+    attach();
+}
+
+SharedSignalSource::~SharedSignalSource()
+{
+    detach();
+}
+
+void SharedSignalSource::start()
+{
+    connect(m_hub, &VehicleSignalHub::frameStarting, this, &SharedSignalSource::poll, Qt::UniqueConnection);
+    m_idleTimer.start();
+}
+
+void SharedSignalSource::stop()
+{
+    disconnect(m_hub, &VehicleSignalHub::frameStarting, this, &SharedSignalSource::poll);
+    m_idleTimer.stop();
+}
+
+bool SharedSignalSource::attach()
+{
+#ifdef Q_OS_UNIX
+    m_lastAttachAttemptUs = VehicleSignalHub::nowUs();
+
+    const QByteArray name = m_segmentName.toLocal8Bit();
+    const int fd = ::shm_open(name.constData(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    void *mapped = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && info.st_size >= off_t(sizeof(SharedSignals::Segment)))
+        mapped = ::mmap(nullptr, sizeof(SharedSignals::Segment), PROT_READ, MAP_SHARED, fd, 0);
+    // 映射建立後 fd 就不再需要
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    const auto *segment = static_cast<const SharedSignals::Segment *>(mapped);
+    if (segment->header.magic != SharedSignals::Magic
+        || segment->header.version != SharedSignals::Version
+        || segment->header.segmentSize != sizeof(SharedSignals::Segment)) {
+        qWarning() << "SharedSignalSource:" << m_segmentName << "is not a signal segment (version mismatch?)";
+        ::munmap(mapped, sizeof(SharedSignals::Segment));
+        return false;
+    }
+
+    m_segment = segment;
+    m_mappedCount = 0;
+    std::fill(std::begin(m_lastSequence), std::end(m_lastSequence), 0u);
+    // 強制第一次輪詢掃過所有訊號
+    m_lastGeneration = ~quint64(0);
+    m_lastChangeUs = m_lastAttachAttemptUs;
+    syncNames();
+
+    qDebug() << "SharedSignalSource: attached to" << m_segmentName << "producer pid"
+             << segment->header.producerPid << "," << m_mappedCount << "signals";
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SharedSignalSource::detach()
+{
+#ifdef Q_OS_UNIX
+    if (m_segment)
+        ::munmap(const_cast<SharedSignals::Segment *>(m_segment), sizeof(SharedSignals::Segment));
+#endif
+    m_segment = nullptr;
+    m_mappedCount = 0;
+}
+
+void SharedSignalSource::syncNames()
+{
+    const int count = qMin<int>(m_segment->header.signalCount.load(std::memory_order_acquire),
+                                SharedSignals::MaxSignals);
+    for (; m_mappedCount < count; ++m_mappedCount) {
+        const char *raw = m_segment->names[m_mappedCount];
+        const QString name = QString::fromUtf8(raw, int(strnlen(raw, SharedSignals::NameLength)));
+        m_idMap[m_mappedCount] = name.isEmpty() ? -1 : m_hub->registerSignal(name);
+    }
+}
+
+void SharedSignalSource::tryReattach(qint64 now)
+{
+    if (now - m_lastAttachAttemptUs < m_attachRetryUs)
+        return;
+    detach();
+    attach();
+    // 不論成功與否都加倍：producer 只是暫停寫入時，接上的還是同一個沒有新資料的區段
+    m_attachRetryUs = qMin(m_attachRetryUs * 2, MaxAttachRetryUs);
+}
+
+void SharedSignalSource::poll()
+{
+    // 有幀時每次都往後延，只有畫面靜止時才會到期
+    m_idleTimer.start();
+
+    const qint64 now = VehicleSignalHub::nowUs();
+    if (!m_segment) {
+        tryReattach(now);
+        return;
+    }
+
+    // 快速路徑：一次原子讀取就能確定整個區段沒有變化
+    const quint64 generation = m_segment->header.generation.load(std::memory_order_acquire);
+    if (generation == m_lastGeneration) {
+        if (now - m_lastChangeUs >= StaleReattachUs)
+            tryReattach(now);
+        return;
+    }
+    m_lastGeneration = generation;
+    m_lastChangeUs = now;
+    m_attachRetryUs = AttachRetryUs;
+
+    syncNames();
+    bool incomplete = false;
+    for (int i = 0; i < m_mappedCount; ++i) {
+        const quint32 current = m_segment->sequence[i].load(std::memory_order_relaxed);
+        if (current == m_lastSequence[i] || m_idMap[i] < 0)
+            continue;
+
+        double value = 0.0;
+        std::int64_t timestampUs = 0;
+        quint32 sequence = 0;
+        int attempt = 0;
+        while (!SharedSignals::read(m_segment, i, &value, &timestampUs, &sequence)) {
+            ++m_tornReads;
+            if (++attempt >= MaxReadRetries)
+                break;
+        }
+        // 一直讀不到一致的快照就留到下一幀（序號沒更新，下次還會再讀）
+        if (attempt >= MaxReadRetries) {
+            incomplete = true;
+            continue;
+        }
+
+        m_lastSequence[i] = sequence;
+        if (m_hub->publish(m_idMap[i], value, timestampUs))
+            ++m_samplesRead;
+    }
+    // 有訊號沒讀完時，下一幀不能走「generation 沒變」的快速路徑
+    if (incomplete)
+        m_lastGeneration = ~quint64(0);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include "sharedsignalformat.h"
+
+class VehicleSignalHub;
+
+/**
+ * SharedSignalSource
+ *
+ * 讀取同機 gateway 行程寫入的 POSIX 共享記憶體區段（格式見 sharedsignalformat.h），
+ * 把有變化的訊號丟進 VehicleSignalHub。
+ *
+ * 每幀在 GUI 執行緒輪詢一次（VehicleSignalHub::frameStarting，與 hub 取 ring 同一個時間點）：
+ * 先比對 header.generation，沒變就直接返回；有變再掃 sequence[]，只讀序號有變的訊號。
+ * 整條路徑都是記憶體讀取，沒有系統呼叫。讀到資料會讓 hub 要求下一幀，所以 producer 持續寫入時
+ * 就是每幀一次；沒有幀（畫面靜止）時每 100 ms 檢查一次 generation，有變化就把幀帶起來。
+ *
+ * 區段不存在（producer 還沒啟動）或 producer 停止寫入超過 2 秒時重新 shm_open，以便接上重新啟動的
+ * producer；重試間隔從 1 秒起加倍到 30 秒，讀到新資料後回到 1 秒。
+ *
+ * config.json：
+ *   "vehicle": { "shm": { "name": "/smart_dashboard_signals" } }
+ * 環境變量 SMART_DASHBOARD_SHM=<名稱> 可覆蓋設定；名稱為空時不啟用。
+ */
+class SharedSignalSource : public QObject {
+    Q_OBJECT
+
+public:
+    // 依設定建立；沒有設定區段名稱或平台不支援時回傳 nullptr（必須在 GUI 執行緒呼叫）
+    static SharedSignalSource *fromConfig(const QJsonObject &shmConfig, VehicleSignalHub *hub,
+                                          QObject *parent = nullptr);
+
+    SharedSignalSource(const QString &segmentName, VehicleSignalHub *hub, QObject *parent = nullptr);
+    ~SharedSignalSource() override;
+
+    // 開始跟著 hub 的幀輪詢
+    void start();
+    void stop();
+
+    bool isAttached() const { return m_segment != nullptr; }
+    quint64 samplesRead() const { return m_samplesRead; }
+    quint64 tornReads() const { return m_tornReads; }
+
+public slots:
+    void poll();
+
+private:
+    bool attach();
+    void detach();
+    void tryReattach(qint64 now);
+    void syncNames();
+
+    QString m_segmentName;
+    VehicleSignalHub *m_hub;
+    QTimer m_idleTimer;                                 // 沒有幀時的低頻檢查
+
+    const SharedSignals::Segment *m_segment = nullptr;
+    int m_mappedCount = 0;                              // 已對應到 hub 的名稱數量
+    int m_idMap[SharedSignals::MaxSignals];             // 區段訊號 index → hub 訊號 id
+    quint32 m_lastSequence[SharedSignals::MaxSignals];
+    quint64 m_lastGeneration = 0;
+    qint64 m_lastChangeUs = 0;
+    qint64 m_lastAttachAttemptUs = 0;
+    qint64 m_attachRetryUs = 0;                         // 目前的重試間隔（退避）
+
+    quint64 m_samplesRead = 0;
+    quint64 m_tornReads = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * 訊號 datagram 格式（UDP 或 Unix datagram socket，DatagramIngestWorker 接收）
+ *
+ * 一個封包裝多筆 (訊號 id, 時間戳, 值)，固定長度、little-endian，接收端不需要任何解析器：
+ *
+ *   PacketHeader（24 bytes）
+ *   Entry × count（每筆 16 bytes）
+ *
+ * - sequence：每送出一個封包加一（允許 32 位元回繞），接收端用來統計遺失與亂序
+ * - sendTimeUs：送出時的 CLOCK_MONOTONIC 微秒；只有同機（loopback / Unix socket）時才能算延遲
+ * - Entry::timeOffsetUs：樣本時間相對於 sendTimeUs 的偏移（通常 <= 0）
+ * - Entry::signalId：送端的訊號編號，接收端依設定對應到 hub 的訊號（預設 0~3 = speed/rpm/fuelLevel/odometer）
+ *
+ * 此檔案不依賴 Qt，測試用送端（tools/datagram_sender.cpp）也直接使用。
+ */
+
+namespace SignalDatagram {
+
+constexpr std::uint32_t Magic = 0x47444453u;   // "SDDG"
+constexpr std::uint8_t Version = 1;
+constexpr std::size_t MaxPacketSize = 1472;    // 乙太網路 MTU 下不分片的 UDP payload
+constexpr std::uint16_t DefaultPort = 47800;
+
+#pragma pack(push, 1)
+struct PacketHeader {
+    std::uint32_t magic;
+    std::uint8_t version;
+    std::uint8_t flags;
+    std::uint16_t count;
+    std::uint32_t sequence;
+    std::uint32_t reserved;
+    std::int64_t sendTimeUs;
+};
+
+struct Entry {
+    std::uint16_t signalId;
+    std::uint16_t reserved;
+    std::int32_t timeOffsetUs;
+    double value;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PacketHeader) == 24, "PacketHeader layout");
+static_assert(sizeof(Entry) == 16, "Entry layout");
+
+constexpr std::size_t MaxEntries = (MaxPacketSize - sizeof(PacketHeader)) / sizeof(Entry);
+
+// 檢查封包並回傳 entry 數量；格式不符時回傳 -1
+inline int validate(const void *data, std::size_t length, PacketHeader *header)
+{
+    if (length < sizeof(PacketHeader))
+        return -1;
+    std::memcpy(header, data, sizeof(PacketHeader));
+    if (header->magic != Magic || header->version != Version)
+        return -1;
+    if (length < sizeof(PacketHeader) + std::size_t(header->count) * sizeof(Entry))
+        return -1;
+    return header->count;
+}
+
+inline Entry entryAt(const void *data, int index)
+{
+    Entry entry;
+    std::memcpy(&entry, static_cast<const char *>(data) + sizeof(PacketHeader) + std::size_t(index) * sizeof(Entry),
+                sizeof(Entry));
+    return entry;
+}
+
+} // namespace SignalDatagram
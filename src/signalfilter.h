@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QtGlobal>
+
+#include <cmath>
+#include <limits>
+
+// 單一訊號的顯示政策（config.json 裡 widget 的 "signal" 物件）
+struct SignalPolicy {
+    double deadband = 0.0;    // 與上次發佈的原始值差距小於此值就不更新（兼具遲滯效果）
+    double maxRateHz = 0.0;   // 每秒最多更新幾次；0 = 不限（仍受每幀一次限制）
+    double quantum = 0.0;     // 顯示量化單位，例如車速 1 km/h；0 = 不量化
+    bool truncate = false;    // 量化時無條件捨去而非四捨五入（里程不能多報）
+
+    static SignalPolicy fromJson(const QJsonObject &obj)
+    {
+        SignalPolicy policy;
+        policy.deadband = qMax(0.0, obj.value("deadband").toDouble(0.0));
+        policy.maxRateHz = qMax(0.0, obj.value("maxRateHz").toDouble(0.0));
+        policy.quantum = qMax(0.0, obj.value("quantum").toDouble(0.0));
+        policy.truncate = obj.value("truncate").toBool(false);
+        return policy;
+    }
+
+    double quantize(double value) const
+    {
+        if (quantum <= 0.0)
+            return value;
+        return (truncate ? std::trunc(value / quantum) : std::round(value / quantum)) * quantum;
+    }
+};
+
+/**
+ * SignalFilter
+ *
+ * VehicleSignalHub 在每幀發佈前的過濾階段：丟掉畫面上看不出差異的更新，
+ * 不讓它們進到 QML（GUI 執行緒在高負載時大部分時間都花在重新評估這些 binding）。
+ *
+ * 判斷順序：deadband → 量化後與目前顯示值相同 → 更新頻率上限（延後而非丟棄，
+ * 確保最後一個值一定會顯示出來）。
+ */
+class SignalFilter {
+public:
+    static constexpr int MaxSignals = 64;
+
+    enum Decision {
+        Publish,    // 發佈 *out
+        Suppress,   // 看不出差異，丟掉
+        Defer       // 超過頻率上限，*retryInUs 後再試
+    };
+
+    void setPolicy(int signalId, const SignalPolicy &policy)
+    {
+        if (signalId < 0 || signalId >= MaxSignals)
+            return;
+        m_policies[signalId] = policy;
+    }
+
+    const SignalPolicy &policy(int signalId) const { return m_policies[signalId]; }
+
+    Decision evaluate(int signalId, double value, double displayed, qint64 nowUs,
+                      double *out, qint64 *retryInUs)
+    {
+        const SignalPolicy &p = m_policies[signalId];
+        State &state = m_state[signalId];
+
+        if (p.deadband > 0.0 && std::abs(value - state.lastRaw) < p.deadband)
+            return Suppress;
+
+        const double quantized = p.quantize(value);
+        if (state.published && quantized == displayed)
+            return Suppress;
+
+        if (p.maxRateHz > 0.0 && state.published) {
+            const qint64 periodUs = qint64(1e6 / p.maxRateHz);
+            const qint64 sinceUs = nowUs - state.lastPublishUs;
+            if (sinceUs < periodUs) {
+                *retryInUs = periodUs - sinceUs;
+                return Defer;
+            }
+        }
+
+        state.lastRaw = value;
+        state.lastPublishUs = nowUs;
+        state.published = true;
+        *out = quantized;
+        return Publish;
+    }
+
+private:
+    struct State {
+        double lastRaw = std::numeric_limits<double>::quiet_NaN();  // NaN：第一筆一定通過 deadband
+        qint64 lastPublishUs = 0;
+        bool published = false;
+    };
+
+    SignalPolicy m_policies[MaxSignals];
+    State m_state[MaxSignals];
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * SignalRing
+ *
+ * 有界、無鎖的多生產者 / 單消費者環形佇列（Vyukov bounded queue 的 MPSC 用法）
+ *
+ * - 生產者（CAN / 網路 / 重播等擷取執行緒）呼叫 tryPush()，可同時有多個
+ * - 消費者只有一個（GUI 執行緒，每幀呼叫 tryPop() 把資料取乾淨）
+ * - 佇列滿時 tryPush() 直接回傳 false，絕不阻塞生產者
+ */
+template <typename T, std::size_t Capacity>
+class SignalRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SignalRing: Capacity 必須是 2 的次方");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SignalRing: T 必須是 trivially copyable");
+
+public:
+    SignalRing()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    SignalRing(const SignalRing &) = delete;
+    SignalRing &operator=(const SignalRing &) = delete;
+
+    // 任何執行緒皆可呼叫
+    bool tryPush(const T &value)
+    {
+        Cell *cell = nullptr;
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & kMask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // 已滿
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 只能由單一消費者執行緒呼叫
+    bool tryPop(T &out)
+    {
+        Cell &cell = m_cells[m_dequeuePos & kMask];
+        const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(m_dequeuePos + 1) < 0)
+            return false; // 空的
+        out = cell.value;
+        cell.sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // 生產端與消費端的游標分開放在不同 cache line，避免 false sharing
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::size_t m_dequeuePos = 0;
+    alignas(64) Cell m_cells[Capacity];
+};
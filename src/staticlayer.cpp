@@ -0,0 +1,133 @@
+#include "staticlayer.h"
+
+#include <QDebug>
+#include <QMetaMethod>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQuickWindow>
+
+#include <cmath>
+
+StaticLayer::StaticLayer(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    connect(this, &QQuickItem::zChanged, this, &StaticLayer::syncCache);
+}
+
+StaticLayer::~StaticLayer()
+{
+    // 先刪掉快取，它還指著我們（sourceItem）
+    delete m_cache.data();
+}
+
+void StaticLayer::setRevision(int revision)
+{
+    if (m_revision == revision)
+        return;
+    m_revision = revision;
+    emit revisionChanged();
+    invalidate();
+}
+
+void StaticLayer::invalidate()
+{
+    if (m_cache)
+        QMetaObject::invokeMethod(m_cache, "scheduleUpdate");
+}
+
+void StaticLayer::componentComplete()
+{
+    QQuickItem::componentComplete();
+    createCache();
+}
+
+void StaticLayer::createCache()
+{
+    QQmlEngine *engine = qmlEngine(this);
+    if (!engine || !parentItem()) {
+        qWarning() << "StaticLayer: no QML engine or parent item, children are rendered live";
+        return;
+    }
+
+    // ShaderEffectSource 不是公開的 C++ 類別，從 QML 建立；live: false 表示只在 scheduleUpdate() 時重畫
+    QQmlComponent component(engine);
+    component.setData("import QtQuick\n"
+                      "ShaderEffectSource { live: false; hideSource: true; recursive: false }\n",
+                      QUrl());
+    m_cache = qobject_cast<QQuickItem *>(component.create(qmlContext(this)));
+    if (!m_cache) {
+        qWarning() << "StaticLayer: cannot create cache item" << component.errors();
+        return;
+    }
+    m_cache->setParent(this);
+    m_cache->setParentItem(parentItem());
+    m_cache->stackAfter(this);
+    m_cache->setProperty("sourceItem", QVariant::fromValue(static_cast<QQuickItem *>(this)));
+
+    const int signalIndex = m_cache->metaObject()->indexOfSignal("scheduledUpdateCompleted()");
+    if (signalIndex >= 0) {
+        connect(m_cache, m_cache->metaObject()->method(signalIndex), this,
+                metaObject()->method(metaObject()->indexOfSlot("onCaptured()")));
+    }
+
+    syncCache();
+}
+
+void StaticLayer::onCaptured()
+{
+    ++m_captureCount;
+    emit captureCountChanged();
+}
+
+void StaticLayer::syncCache()
+{
+    if (!m_cache)
+        return;
+    m_cache->setPosition(position());
+    m_cache->setSize(size());
+    m_cache->setZ(z());
+    m_cache->setVisible(isVisible());
+    m_cache->setOpacity(opacity());
+
+    // 貼圖以實際像素大小建立，HiDPI 上文字不會糊
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    const QSize textureSize(qMax(1, int(std::ceil(width() * dpr))), qMax(1, int(std::ceil(height() * dpr))));
+    if (m_cache->property("textureSize").toSize() != textureSize)
+        m_cache->setProperty("textureSize", textureSize);
+}
+
+void StaticLayer::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    syncCache();
+    if (newGeometry.size() != oldGeometry.size())
+        invalidate();
+}
+
+void StaticLayer::itemChange(ItemChange change, const ItemChangeData &data)
+{
+    QQuickItem::itemChange(change, data);
+    if (!m_cache)
+        return;
+
+    switch (change) {
+    case ItemParentHasChanged:
+        m_cache->setParentItem(data.item);
+        if (data.item)
+            m_cache->stackAfter(this);
+        syncCache();
+        break;
+    case ItemVisibleHasChanged:
+    case ItemOpacityHasChanged:
+        syncCache();
+        break;
+    case ItemSceneChange:
+    case ItemDevicePixelRatioHasChanged:
+        syncCache();
+        invalidate();
+        break;
+    default:
+        break;
+    }
+}
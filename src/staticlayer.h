@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QPointer>
+#include <QQuickItem>
+
+/**
+ * StaticLayer
+ *
+ * 不會變動的裝飾（背景漸層、外框、刻度文字、Dock 底座）的容器：子項目只畫一次到快取貼圖，
+ * 之後每幀只貼一張圖，直到大小改變或 revision 改變（例如換主題）才重畫。
+ *
+ * 實作上在同一個父項目下建立一個 live: false 的 ShaderEffectSource（hideSource），
+ * 疊在 StaticLayer 正上方，位置 / 大小 / z / 可見度 / 透明度跟著 StaticLayer 走。
+ * 指標、數字、嵌入的 app 畫面等會動的東西不要放進來，放在後面宣告的兄弟項目中即可疊在上面。
+ *
+ * 注意：
+ * - 子項目自己的屬性變化（文字、顏色、位置）不會觸發重畫；要重畫請改 revision 或呼叫 invalidate()
+ * - StaticLayer 本身的 rotation / scale / transform 不會套用到快取
+ */
+class StaticLayer : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(int revision READ revision WRITE setRevision NOTIFY revisionChanged)
+    Q_PROPERTY(int captureCount READ captureCount NOTIFY captureCountChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
+
+public:
+    explicit StaticLayer(QQuickItem *parent = nullptr);
+    ~StaticLayer() override;
+
+    int revision() const { return m_revision; }
+    void setRevision(int revision);
+
+    // 重畫快取的次數（除錯 / benchmark 用）
+    int captureCount() const { return m_captureCount; }
+
+    // 要求下一幀重畫快取
+    Q_INVOKABLE void invalidate();
+
+signals:
+    void revisionChanged();
+    void captureCountChanged();
+
+protected:
+    void componentComplete() override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData &data) override;
+
+private slots:
+    void onCaptured();
+
+private:
+    void createCache();
+    void syncCache();
+
+    QPointer<QQuickItem> m_cache;
+    int m_revision = 0;
+    int m_captureCount = 0;
+};
@@ -0,0 +1,317 @@
+#include "surfaceitem.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGRenderNode>
+#include <QSGRendererInterface>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+
+#include <QtWaylandCompositor/QWaylandView>
+
+#include <memory>
+
+#if __has_include(<rhi/qrhi.h>)
+// QRhi 自 Qt 6.6 起為半公開 API；較舊的 Qt 上 RHI 後端退回 QWaylandQuickItem 的整張上傳
+#include <rhi/qrhi.h>
+#define SMART_DASHBOARD_HAVE_RHI 1
+#endif
+
+namespace {
+
+qint64 regionBytes(const QRegion &region, int bytesPerPixel)
+{
+    qint64 bytes = 0;
+    for (const QRect &rect : region)
+        bytes += qint64(rect.width()) * rect.height() * bytesPerPixel;
+    return bytes;
+}
+
+// software 後端：一格畫面，從目前的 buffer 直接畫（不複製），只有碰到 damage 時才 markDirty
+class SurfaceTileNode : public QSGRenderNode {
+public:
+    SurfaceTileNode(QQuickWindow *window, const QRect &source, const QRectF &target)
+        : m_window(window), m_source(source), m_target(target)
+    {
+    }
+
+    const QRect &source() const { return m_source; }
+
+    void setImage(const QImage &image, bool smooth)
+    {
+        m_image = image;
+        m_smooth = smooth;
+    }
+
+    void render(const RenderState *state) override
+    {
+        auto *painter = static_cast<QPainter *>(
+            m_window->rendererInterface()->getResource(m_window, QSGRendererInterface::PainterResource));
+        if (!painter || m_image.isNull())
+            return;
+        painter->save();
+        painter->setTransform(matrix()->toTransform());
+        painter->setOpacity(inheritedOpacity());
+        if (state->clipRegion() && !state->clipRegion()->isEmpty())
+            painter->setClipRegion(*state->clipRegion(), Qt::ReplaceClip);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, m_smooth);
+        painter->drawImage(m_target, m_image, m_source);
+        painter->restore();
+    }
+
+    RenderingFlags flags() const override
+    {
+        RenderingFlags f = BoundedRectRendering | DepthAwareRendering;
+        if (!m_image.hasAlphaChannel())
+            f |= OpaqueRendering;
+        return f;
+    }
+    QRectF rect() const override { return m_target; }
+
+private:
+    QQuickWindow *m_window;
+    QImage m_image;
+    QRect m_source;    // buffer 座標
+    QRectF m_target;   // 項目座標
+    bool m_smooth = true;
+};
+
+#ifdef SMART_DASHBOARD_HAVE_RHI
+// RHI 後端：持續存在的貼圖，commitTextureOperations 時只上傳累積的 damage
+class DamageTexture : public QSGTexture {
+public:
+    ~DamageTexture() override
+    {
+        if (m_texture)
+            m_texture->deleteLater();
+    }
+
+    void setImage(const QImage &image, const QRegion &damage)
+    {
+        if (image.size() != m_image.size())
+            m_full = true;
+        m_image = image;
+        m_dirty += damage;
+    }
+
+    qint64 comparisonKey() const override { return qint64(reinterpret_cast<quintptr>(this)); }
+    QRhiTexture *rhiTexture() const override { return m_texture; }
+    QSize textureSize() const override { return m_image.size(); }
+    bool hasAlphaChannel() const override { return m_image.hasAlphaChannel(); }
+    bool hasMipmaps() const override { return false; }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (m_image.isNull() || (!m_full && m_dirty.isEmpty()))
+            return;
+
+        if (!m_texture || m_texture->pixelSize() != m_image.size()) {
+            if (m_texture)
+                m_texture->deleteLater();
+            // wl_shm 的 (A|X)RGB8888 在記憶體中是 BGRA，支援時直接上傳不轉換
+            m_bgra = rhi->isTextureFormatSupported(QRhiTexture::BGRA8);
+            m_texture = rhi->newTexture(m_bgra ? QRhiTexture::BGRA8 : QRhiTexture::RGBA8, m_image.size());
+            m_texture->create();
+            m_full = true;
+        }
+
+        const QRegion region = m_full ? QRegion(m_image.rect()) : (m_dirty & m_image.rect());
+        QVarLengthArray<QRhiTextureUploadEntry, 8> entries;
+        for (const QRect &rect : region) {
+            if (m_bgra) {
+                QRhiTextureSubresourceUploadDescription desc(m_image);
+                desc.setSourceTopLeft(rect.topLeft());
+                desc.setSourceSize(rect.size());
+                desc.setDestinationTopLeft(rect.topLeft());
+                entries.append(QRhiTextureUploadEntry(0, 0, desc));
+            } else {
+                QRhiTextureSubresourceUploadDescription desc(
+                    m_image.copy(rect).convertToFormat(QImage::Format_RGBA8888_Premultiplied));
+                desc.setDestinationTopLeft(rect.topLeft());
+                entries.append(QRhiTextureUploadEntry(0, 0, desc));
+            }
+        }
+        QRhiTextureUploadDescription description;
+        description.setEntries(entries.cbegin(), entries.cend());
+        resourceUpdates->uploadTexture(m_texture, description);
+
+        m_full = false;
+        m_dirty = QRegion();
+    }
+
+private:
+    QImage m_image;
+    QRegion m_dirty;
+    QRhiTexture *m_texture = nullptr;
+    bool m_full = true;
+    bool m_bgra = true;
+};
+
+class DamageTextureNode : public QSGSimpleTextureNode {
+public:
+    DamageTextureNode()
+        : m_texture(std::make_unique<DamageTexture>())
+    {
+        setOwnsTexture(false);
+        setTexture(m_texture.get());
+    }
+
+    DamageTexture *damageTexture() const { return m_texture.get(); }
+
+private:
+    std::unique_ptr<DamageTexture> m_texture;
+};
+#endif
+
+} // namespace
+
+SurfaceItem::SurfaceItem(QQuickItem *parent)
+    : QWaylandQuickItem(parent)
+{
+    m_partialUpload = qEnvironmentVariable("SMART_DASHBOARD_PARTIAL_UPLOAD") != QLatin1String("0");
+    // QWaylandQuickItem 自動處理輸入事件轉發；這裡只需要跟著 surface 收 damage
+    connect(this, &QWaylandQuickItem::surfaceChanged, this, &SurfaceItem::trackSurface);
+}
+
+void SurfaceItem::trackSurface()
+{
+    if (m_trackedSurface)
+        disconnect(m_trackedSurface, nullptr, this, nullptr);
+    m_trackedSurface = surface();
+    m_pendingDamage = QRegion();
+    if (!m_trackedSurface || !m_partialUpload)
+        return;
+
+    // view 只保留最後一次 commit 的 damage；兩次 sync 之間有多次 commit 時要自己累積
+    connect(m_trackedSurface, &QWaylandSurface::damaged, this, [this](const QRegion &region) {
+        m_pendingDamage += region;
+    });
+}
+
+QSGNode *SurfaceItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    if (!m_partialUpload)
+        return QWaylandQuickItem::updatePaintNode(oldNode, data);
+
+    const QWaylandBufferRef ref = view()->currentBuffer();
+    const QSGRendererInterface::GraphicsApi api = window()->rendererInterface()->graphicsApi();
+    const bool software = api == QSGRendererInterface::Software;
+#ifdef SMART_DASHBOARD_HAVE_RHI
+    const bool rhi = QSGRendererInterface::isApiRhiBased(api);
+#else
+    const bool rhi = false;
+#endif
+    const QImage image = (surface() && ref.hasContent() && ref.isSharedMemory()) ? ref.image() : QImage();
+    const bool usable = (software || rhi) && !image.isNull() && image.depth() == 32;
+
+    if (!usable) {
+        if (m_ownNode) {
+            delete oldNode;
+            oldNode = nullptr;
+            m_ownNode = false;
+        }
+        m_buffer = QWaylandBufferRef();
+        m_pendingDamage = QRegion();
+        return QWaylandQuickItem::updatePaintNode(oldNode, data);
+    }
+
+    if (!m_ownNode) {
+        delete oldNode;
+        oldNode = nullptr;
+        m_ownNode = true;
+    }
+    if (view()->isBufferLocked() && oldNode)
+        return oldNode;
+
+    // damage 從 surface 座標換成 buffer 座標
+    const int scale = qMax(1, surface()->bufferScale());
+    QRegion damage;
+    for (const QRect &rect : std::as_const(m_pendingDamage))
+        damage += QRect(rect.topLeft() * scale, rect.size() * scale);
+    damage &= image.rect();
+    m_pendingDamage = QRegion();
+    m_buffer = ref;
+
+    return software ? updateTiles(oldNode, image, damage) : updateTexture(oldNode, image, damage);
+}
+
+QSGNode *SurfaceItem::updateTiles(QSGNode *oldNode, const QImage &image, QRegion damage)
+{
+    QSGNode *root = oldNode ? oldNode : new QSGNode;
+    const QRectF target = boundingRect();
+    bool full = false;
+
+    // buffer 或項目大小改變時重新切格子
+    if (!root->firstChild() || m_nodeImageSize != image.size() || m_nodeRect != target) {
+        while (QSGNode *child = root->firstChild()) {
+            root->removeChildNode(child);
+            delete child;
+        }
+        const qreal sx = target.width() / image.width();
+        const qreal sy = target.height() / image.height();
+        for (int y = 0; y < image.height(); y += TileSize) {
+            for (int x = 0; x < image.width(); x += TileSize) {
+                const QRect source(x, y, qMin(TileSize, image.width() - x), qMin(TileSize, image.height() - y));
+                const QRectF tileTarget(target.x() + source.x() * sx, target.y() + source.y() * sy,
+                                        source.width() * sx, source.height() * sy);
+                root->appendChildNode(new SurfaceTileNode(window(), source, tileTarget));
+            }
+        }
+        m_nodeImageSize = image.size();
+        m_nodeRect = target;
+        damage = image.rect();
+        full = true;
+    }
+
+    qint64 bytes = 0;
+    for (QSGNode *child = root->firstChild(); child; child = child->nextSibling()) {
+        auto *tile = static_cast<SurfaceTileNode *>(child);
+        tile->setImage(image, smooth());
+        if (damage.intersects(tile->source())) {
+            tile->markDirty(QSGNode::DirtyMaterial);
+            bytes += qint64(tile->source().width()) * tile->source().height() * 4;
+        }
+    }
+    if (bytes > 0)
+        recordUpload(bytes, full);
+    return root;
+}
+
+QSGNode *SurfaceItem::updateTexture(QSGNode *oldNode, const QImage &image, QRegion damage)
+{
+#ifdef SMART_DASHBOARD_HAVE_RHI
+    auto *node = static_cast<DamageTextureNode *>(oldNode);
+    bool full = false;
+    if (!node || m_nodeImageSize != image.size()) {
+        if (!node)
+            node = new DamageTextureNode;
+        damage = image.rect();
+        m_nodeImageSize = image.size();
+        full = true;
+    }
+
+    node->damageTexture()->setImage(image, damage);
+    node->setRect(boundingRect());
+    node->setFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
+    if (!damage.isEmpty()) {
+        node->markDirty(QSGNode::DirtyMaterial);
+        recordUpload(regionBytes(damage, 4), full);
+    }
+    return node;
+#else
+    Q_UNUSED(image);
+    Q_UNUSED(damage);
+    return oldNode;
+#endif
+}
+
+void SurfaceItem::recordUpload(qint64 bytes, bool full)
+{
+    // render 執行緒上（GUI 執行緒此時被擋住），通知排回 GUI 執行緒
+    m_bytesLastCommit = bytes;
+    m_bytesTotal += bytes;
+    ++m_commitsUploaded;
+    if (full)
+        ++m_fullUploads;
+    QMetaObject::invokeMethod(this, &SurfaceItem::uploadStatsChanged, Qt::QueuedConnection);
+}
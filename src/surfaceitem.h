@@ -1,47 +1,72 @@
 #pragma once
 
+#include <QtWaylandCompositor/QWaylandBufferRef>
 #include <QtWaylandCompositor/QWaylandSurface>
 #include <QtWaylandCompositor/qwaylandquickitem.h>
 #include <QQuickItem>
 #include <QPointer>
+#include <QRegion>
+#include <QRectF>
+#include <QSize>
 
 /**
  * SurfaceItem
- * 
- * QML 組件，用於在 QML 場景中顯示 Wayland 表面
- * 
- * 這是真正的 compositor 模式：表面內容直接渲染到 QML 場景中
- * 
- * 注意：使用 QWaylandQuickItem 來顯示表面
+ *
+ * QML 組件，用於在 QML 場景中顯示 Wayland 表面（appArea 的 delegate）
+ *
+ * 輸入事件轉發、focus 等仍由 QWaylandQuickItem 處理；不同的是 wl_shm buffer 的上傳：
+ * QWaylandQuickItem 每次 commit 都把整張 buffer 重新上傳 / 重畫，這裡則累積每次 commit 的 damage，
+ * 只處理有變動的區域：
+ *
+ * - RHI 後端：持續存在的貼圖，只上傳 damage 矩形（需要 Qt 6.6 以上的 <rhi/qrhi.h>）
+ * - software 後端：把畫面切成 TileSize 的格子，每格一個 render node，只有碰到 damage 的格子會重畫
+ * - 其他情況（dmabuf / EGL buffer、非 32-bit 格式）退回 QWaylandQuickItem 原本的做法
+ *
+ * bytesLastCommit / bytesTotal 為實際上傳或重畫的位元組數（除錯 / benchmark 用）。
+ * SMART_DASHBOARD_PARTIAL_UPLOAD=0 可停用。
  */
 class SurfaceItem : public QWaylandQuickItem {
     Q_OBJECT
-    Q_PROPERTY(QWaylandSurface* surface READ surface WRITE setSurface NOTIFY surfaceChanged)
-    // 注意：不使用 QML_ELEMENT，因為我們在 main.cpp 中手動註冊
+    Q_PROPERTY(bool partialUpload READ partialUpload CONSTANT)
+    Q_PROPERTY(qint64 bytesLastCommit READ bytesLastCommit NOTIFY uploadStatsChanged)
+    Q_PROPERTY(qint64 bytesTotal READ bytesTotal NOTIFY uploadStatsChanged)
+    Q_PROPERTY(int commitsUploaded READ commitsUploaded NOTIFY uploadStatsChanged)
+    Q_PROPERTY(int fullUploads READ fullUploads NOTIFY uploadStatsChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
 
 public:
-    explicit SurfaceItem(QQuickItem *parent = nullptr)
-        : QWaylandQuickItem(parent)
-    {
-    }
-
-    QWaylandSurface* surface() const {
-        return QWaylandQuickItem::surface();
-    }
-    
-    void setSurface(QWaylandSurface *s) {
-        if (surface() != s) {
-            QWaylandQuickItem::setSurface(s);
-            // QWaylandQuickItem 自動處理輸入事件轉發
-            // 不需要手動設置輸入區域
-            emit surfaceChanged();
-        }
-    }
-    
-    // QWaylandQuickItem 已經處理了輸入事件轉發
-    // 當用戶在 Item 上點擊時，事件會自動轉發到對應的表面
+    static constexpr int TileSize = 128;
+
+    explicit SurfaceItem(QQuickItem *parent = nullptr);
+
+    bool partialUpload() const { return m_partialUpload; }
+    qint64 bytesLastCommit() const { return m_bytesLastCommit; }
+    qint64 bytesTotal() const { return m_bytesTotal; }
+    int commitsUploaded() const { return m_commitsUploaded; }
+    int fullUploads() const { return m_fullUploads; }
 
 signals:
-    void surfaceChanged();
-};
+    void uploadStatsChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
 
+private:
+    void trackSurface();
+    QSGNode *updateTiles(QSGNode *oldNode, const QImage &image, QRegion damage);
+    QSGNode *updateTexture(QSGNode *oldNode, const QImage &image, QRegion damage);
+    void recordUpload(qint64 bytes, bool full);
+
+    QPointer<QWaylandSurface> m_trackedSurface;
+    QRegion m_pendingDamage;          // surface 座標，GUI 執行緒累積、sync 時取用
+    QWaylandBufferRef m_buffer;       // 持有目前顯示的 buffer，確保 render 時 shm 記憶體仍有效
+    bool m_ownNode = false;           // 目前的節點是否由我們建立（否則是 QWaylandQuickItem 的）
+    QSize m_nodeImageSize;
+    QRectF m_nodeRect;
+    bool m_partialUpload = true;
+
+    qint64 m_bytesLastCommit = 0;
+    qint64 m_bytesTotal = 0;
+    int m_commitsUploaded = 0;
+    int m_fullUploads = 0;
+};
@@ -0,0 +1,333 @@
+#include "surfacelaunchtracker.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QQuickWindow>
+#include <QStringList>
+#include <QTimer>
+
+#include <QtWaylandCompositor/QWaylandClient>
+#include <QtWaylandCompositor/QWaylandCompositor>
+#include <QtWaylandCompositor/QWaylandOutput>
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandView>
+#include <QtWaylandCompositor/QWaylandXdgToplevel>
+
+#include <algorithm>
+#include <iterator>
+
+#include "packagesurfacematcher.h"
+
+namespace {
+
+// 各階段在 history / JSON 裡的欄位名（相對 requested 的毫秒）
+const char *const StageKeys[SurfaceLaunchTracker::StageCount] = {
+    nullptr,
+    "clientConnectedMs",
+    "toplevelMs",
+    "firstBufferMs",
+    "firstFrameMs",
+};
+
+} // namespace
+
+SurfaceLaunchTracker::SurfaceLaunchTracker(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+}
+
+SurfaceLaunchTracker::~SurfaceLaunchTracker()
+{
+    // render 執行緒上的 DirectConnection 要先斷開
+    const QList<QQuickWindow *> windows = m_frameWait.keys();
+    for (QQuickWindow *window : windows)
+        detachWindow(window);
+}
+
+void SurfaceLaunchTracker::launchRequested(const QString &packageName, qint64 clientPid)
+{
+    Launch launch;
+    launch.id = m_nextId++;
+    launch.packageName = packageName;
+    launch.key = packageName.trimmed().toLower();
+    launch.clientPid = clientPid;
+    std::fill(std::begin(launch.stampNs), std::end(launch.stampNs), qint64(-1));
+    launch.stampNs[Requested] = now();
+    m_pending.append(launch);
+
+    // 每次啟動一個 single-shot 逾時，不輪詢
+    const quint64 id = launch.id;
+    QTimer::singleShot(TimeoutMs, this, [this, id] { expire(id); });
+    emit pendingCountChanged();
+}
+
+void SurfaceLaunchTracker::surfaceCreated(QWaylandSurface *surface)
+{
+    // 沒有等待中的啟動時什麼都不記
+    if (!surface || m_pending.isEmpty())
+        return;
+
+    Candidate candidate;
+    candidate.createdNs = now();
+    m_candidates.insert(surface, candidate);
+    connect(surface, &QWaylandSurface::surfaceDestroyed, this, [this, surface] {
+        m_candidates.remove(surface);
+        const int index = indexOfSurface(surface);
+        if (index >= 0)
+            finish(index, QStringLiteral("destroyed"));
+    });
+    tryMatch(surface);
+}
+
+void SurfaceLaunchTracker::toplevelCreated(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel)
+{
+    auto it = m_candidates.find(surface);
+    if (it == m_candidates.end() || !toplevel)
+        return;
+
+    it->toplevelNs = now();
+    it->toplevel = toplevel;
+    connect(toplevel, &QWaylandXdgToplevel::appIdChanged, this, [this, surface] { tryMatch(surface); });
+    tryMatch(surface);
+}
+
+void SurfaceLaunchTracker::tryMatch(QWaylandSurface *surface)
+{
+    const auto it = m_candidates.constFind(surface);
+    if (it == m_candidates.cend())
+        return;
+    const Candidate candidate = *it;
+
+    const qint64 pid = surface->client() ? surface->client()->processId() : 0;
+    const QString appKey = candidate.toplevel
+        ? PackageSurfaceMatcher::packageFromAppId(candidate.toplevel->appId()) : QString();
+    for (int i = 0; i < m_pending.size(); ++i) {
+        const Launch &launch = m_pending.at(i);
+        if (launch.surface)
+            continue;
+        const bool pidMatches = launch.clientPid > 0 && launch.clientPid == pid;
+        const bool appIdMatches = !appKey.isEmpty() && appKey == launch.key;
+        if (!pidMatches && !appIdMatches)
+            continue;
+
+        if (pidMatches && launch.stampNs[ClientConnected] < 0)
+            m_pending[i].stampNs[ClientConnected] = candidate.createdNs;
+        // PID 配對時 surface 一建立就知道是誰的，但還要等它成為 toplevel 才綁定
+        if (candidate.toplevelNs >= 0)
+            bind(i, surface, candidate);
+        return;
+    }
+}
+
+void SurfaceLaunchTracker::bind(int index, QWaylandSurface *surface, const Candidate &candidate)
+{
+    Launch &launch = m_pending[index];
+    launch.surface = surface;
+    if (launch.stampNs[ClientConnected] < 0)
+        launch.stampNs[ClientConnected] = candidate.createdNs;
+    launch.stampNs[ToplevelCreated] = candidate.toplevelNs;
+
+    m_candidates.remove(surface);
+    if (candidate.toplevel)
+        disconnect(candidate.toplevel, nullptr, this, nullptr);
+
+    // 第一個帶 buffer 的 commit：hasContentChanged 之外也看 redraw（每次 commit 都會發）
+    auto checkContent = [this, surface] {
+        if (surface->hasContent())
+            onFirstBuffer(surface);
+    };
+    connect(surface, &QWaylandSurface::hasContentChanged, this, checkContent);
+    connect(surface, &QWaylandSurface::redraw, this, checkContent);
+    checkContent();
+}
+
+void SurfaceLaunchTracker::dropCandidates()
+{
+    for (auto it = m_candidates.cbegin(); it != m_candidates.cend(); ++it) {
+        disconnect(it.key(), nullptr, this, nullptr);
+        if (it->toplevel)
+            disconnect(it->toplevel, nullptr, this, nullptr);
+    }
+    m_candidates.clear();
+}
+
+void SurfaceLaunchTracker::onFirstBuffer(QWaylandSurface *surface)
+{
+    const int index = indexOfSurface(surface);
+    if (index < 0 || m_pending[index].stampNs[FirstBuffer] >= 0)
+        return;
+
+    m_pending[index].stampNs[FirstBuffer] = now();
+    disconnect(surface, &QWaylandSurface::hasContentChanged, this, nullptr);
+    disconnect(surface, &QWaylandSurface::redraw, this, nullptr);
+
+    QQuickWindow *window = attachWindow(surface);
+    if (!window) {
+        // 沒有輸出視窗就量不到上屏時間
+        finish(index, QStringLiteral("ok"));
+        return;
+    }
+    m_pending[index].window = window;
+    m_frameWait.value(window)->store(AwaitSync);
+    window->update();
+}
+
+QQuickWindow *SurfaceLaunchTracker::attachWindow(QWaylandSurface *surface)
+{
+    // 實際顯示這個 surface 的 output；還沒有 view 時退回 defaultOutput（cluster）
+    const QWaylandView *view = surface->primaryView();
+    QWaylandOutput *output = view ? view->output() : nullptr;
+    if (!output && surface->compositor())
+        output = surface->compositor()->defaultOutput();
+    QQuickWindow *window = output ? qobject_cast<QQuickWindow *>(output->window()) : nullptr;
+    if (!window || m_frameWait.contains(window))
+        return window;
+
+    auto *frameWait = new std::atomic<int>(Idle);
+    m_frameWait.insert(window, frameWait);
+
+    // threaded render loop 時這兩個訊號在該視窗的 render 執行緒發出；只動 atomic，時間戳再丟回 GUI 執行緒
+    connect(window, &QQuickWindow::beforeSynchronizing, this, [frameWait] {
+        int expected = AwaitSync;
+        frameWait->compare_exchange_strong(expected, AwaitSwap);
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::frameSwapped, this, [this, frameWait, window] {
+        int expected = AwaitSwap;
+        if (!frameWait->compare_exchange_strong(expected, Idle))
+            return;
+        const qint64 ns = now();
+        // 排回 GUI 執行緒時視窗可能已關閉
+        QPointer<QQuickWindow> guard = window;
+        QMetaObject::invokeMethod(this, [this, guard, ns] {
+            if (guard)
+                onFrameSwapped(guard, ns);
+        }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+    // 例如 center 的 Loader 停用：這個視窗不會再 swap，等它的啟動以沒有上屏時間結束
+    connect(window, &QObject::destroyed, this, [this, window] {
+        delete m_frameWait.take(window);
+        for (int i = 0; i < m_pending.size();) {
+            if (m_pending.at(i).stampNs[FirstBuffer] >= 0 && !m_pending.at(i).window)
+                finish(i, QStringLiteral("ok"));
+            else
+                ++i;
+        }
+    });
+    return window;
+}
+
+void SurfaceLaunchTracker::detachWindow(QQuickWindow *window)
+{
+    disconnect(window, nullptr, this, nullptr);
+    delete m_frameWait.take(window);
+}
+
+void SurfaceLaunchTracker::onFrameSwapped(QQuickWindow *window, qint64 ns)
+{
+    for (int i = 0; i < m_pending.size();) {
+        Launch &launch = m_pending[i];
+        if (launch.window == window && launch.stampNs[FirstBuffer] >= 0 && launch.stampNs[FirstBuffer] <= ns) {
+            launch.stampNs[FirstFrame] = ns;
+            finish(i, QStringLiteral("ok"));
+        } else {
+            ++i;
+        }
+    }
+}
+
+void SurfaceLaunchTracker::finish(int index, const QString &result)
+{
+    Launch launch = m_pending.takeAt(index);
+    launch.result = result;
+    if (launch.surface)
+        disconnect(launch.surface, nullptr, this, nullptr);
+
+    m_history.append(launch);
+    while (m_history.size() > MaxHistory)
+        m_history.removeFirst();
+    if (launch.window) {
+        const bool waiting = std::any_of(m_pending.cbegin(), m_pending.cend(),
+                                         [&](const Launch &other) { return other.window == launch.window; });
+        std::atomic<int> *frameWait = m_frameWait.value(launch.window);
+        if (!waiting && frameWait)
+            frameWait->store(Idle);
+    }
+    if (m_pending.isEmpty()) {
+        // 沒有人在等了，還沒配對的 surface 不再需要追蹤
+        dropCandidates();
+    }
+
+    const QVariantMap map = toMap(launch);
+    QStringList stages;
+    for (int stage = ClientConnected; stage < StageCount; ++stage) {
+        const QVariant ms = map.value(QLatin1String(StageKeys[stage]));
+        stages << QStringLiteral("%1=%2").arg(QLatin1String(StageKeys[stage]),
+                                             ms.isNull() ? QStringLiteral("-") : QString::number(ms.toDouble(), 'f', 1));
+    }
+    qInfo().noquote() << "SurfaceLaunchTracker:" << launch.packageName << result << stages.join(QLatin1Char(' '));
+
+    emit pendingCountChanged();
+    emit historyChanged();
+    emit launchCompleted(map);
+}
+
+void SurfaceLaunchTracker::expire(quint64 id)
+{
+    for (int i = 0; i < m_pending.size(); ++i) {
+        if (m_pending.at(i).id == id) {
+            finish(i, QStringLiteral("timeout"));
+            return;
+        }
+    }
+}
+
+int SurfaceLaunchTracker::indexOfSurface(QWaylandSurface *surface) const
+{
+    for (int i = 0; i < m_pending.size(); ++i) {
+        if (m_pending.at(i).surface == surface)
+            return i;
+    }
+    return -1;
+}
+
+QVariantMap SurfaceLaunchTracker::toMap(const Launch &launch)
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("packageName"), launch.packageName);
+    map.insert(QStringLiteral("result"), launch.result);
+    const qint64 start = launch.stampNs[Requested];
+    for (int stage = ClientConnected; stage < StageCount; ++stage) {
+        const qint64 stamp = launch.stampNs[stage];
+        // 沒走到的階段為 null
+        map.insert(QLatin1String(StageKeys[stage]),
+                   stamp >= 0 ? QVariant(double(stamp - start) / 1e6) : QVariant());
+    }
+    return map;
+}
+
+QVariantMap SurfaceLaunchTracker::lastLaunch() const
+{
+    return m_history.isEmpty() ? QVariantMap() : toMap(m_history.last());
+}
+
+QVariantList SurfaceLaunchTracker::history() const
+{
+    QVariantList list;
+    list.reserve(m_history.size());
+    for (const Launch &launch : m_history)
+        list.append(toMap(launch));
+    return list;
+}
+
+QJsonObject SurfaceLaunchTracker::toJson() const
+{
+    QJsonArray launches;
+    for (const Launch &launch : m_history)
+        launches.append(QJsonObject::fromVariantMap(toMap(launch)));
+
+    QJsonObject obj;
+    obj.insert(QStringLiteral("pending"), m_pending.size());
+    obj.insert(QStringLiteral("launches"), launches);
+    return obj;
+}
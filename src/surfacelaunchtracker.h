@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <atomic>
+
+class QQuickWindow;
+class QWaylandSurface;
+class QWaylandXdgToplevel;
+
+/**
+ * SurfaceLaunchTracker
+ *
+ * compositor 模式下「點 app → 畫面出現」的各階段延遲（QML 中以 xdgShellHelper.launchTracker 取得）。
+ * 全部由事件驅動，不輪詢：
+ *
+ * - requested：launchRequested()（DashboardShell 呼叫 Waydroid.launchApp 之前）
+ * - clientConnected：屬於這次啟動的 wl_surface 建立的時間
+ * - toplevel：該 surface 成為 xdg_toplevel 的時間，surface 從此綁定到這次啟動
+ * - firstBuffer：綁定的 surface 第一次 commit 帶 buffer（hasContentChanged）
+ * - firstFrame：之後顯示該 surface 的視窗（primary view 所在的 output，cluster 或 center）
+ *   第一次 sync 進場景並 frameSwapped 的幀（真正顯示在螢幕上）
+ *
+ * 「屬於這次啟動」以 client PID（launchRequested 帶了 PID 時，surface 一建立就能確定）或 toplevel 的
+ * app_id（"waydroid.<包名>"，與 PackageSurfaceMatcher 相同規則；app_id 通常在 toplevel 建立之後才送到）
+ * 判斷。等待期間建立的 surface 先記下建立 / toplevel 時間，配對成功才寫進啟動；
+ * 別的 app 或 popup 的 surface 不會誤把階段蓋掉，配不到的階段保持未設定。
+ *
+ * 完成的啟動以毫秒（相對 requested）留在 history（最多 MaxHistory 筆），
+ * 並以 qInfo 印一行摘要；TimeoutMs 內沒完成或 surface 先被銷毀的記為未完成。
+ */
+class SurfaceLaunchTracker : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QVariantMap lastLaunch READ lastLaunch NOTIFY historyChanged)
+    Q_PROPERTY(QVariantList history READ history NOTIFY historyChanged)
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY pendingCountChanged)
+
+public:
+    enum Stage {
+        Requested,
+        ClientConnected,
+        ToplevelCreated,
+        FirstBuffer,
+        FirstFrame,
+        StageCount
+    };
+    Q_ENUM(Stage)
+
+    static constexpr int MaxHistory = 32;
+    static constexpr int TimeoutMs = 30000;
+
+    explicit SurfaceLaunchTracker(QObject *parent = nullptr);
+    ~SurfaceLaunchTracker() override;
+
+    // clientPid：已知會連線的 client PID（非 Waydroid 的原生 client）；0 表示只看 app_id
+    Q_INVOKABLE void launchRequested(const QString &packageName, qint64 clientPid = 0);
+
+    // 由 XdgShellHelper 呼叫
+    void surfaceCreated(QWaylandSurface *surface);
+    void toplevelCreated(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel);
+
+    QVariantMap lastLaunch() const;
+    QVariantList history() const;
+    int pendingCount() const { return m_pending.size(); }
+
+    QJsonObject toJson() const;
+
+signals:
+    void historyChanged();
+    void pendingCountChanged();
+    void launchCompleted(const QVariantMap &launch);
+
+private:
+    struct Launch {
+        quint64 id = 0;
+        QString packageName;
+        QString key;      // 小寫包名，與 app_id 比對用
+        qint64 clientPid = 0;
+        qint64 stampNs[StageCount];
+        QPointer<QWaylandSurface> surface;
+        QPointer<QQuickWindow> window;   // 等 firstFrame 的視窗
+        QString result;   // "ok" / "timeout" / "destroyed"
+    };
+
+    // 等待中的啟動期間建立、還沒配對的 surface
+    struct Candidate {
+        qint64 createdNs = -1;
+        qint64 toplevelNs = -1;
+        QPointer<QWaylandXdgToplevel> toplevel;
+    };
+
+    void tryMatch(QWaylandSurface *surface);
+    void bind(int index, QWaylandSurface *surface, const Candidate &candidate);
+    void dropCandidates();
+    void onFirstBuffer(QWaylandSurface *surface);
+    void onFrameSwapped(QQuickWindow *window, qint64 ns);
+    QQuickWindow *attachWindow(QWaylandSurface *surface);
+    void detachWindow(QQuickWindow *window);
+    void finish(int index, const QString &result);
+    void expire(quint64 id);
+    int indexOfSurface(QWaylandSurface *surface) const;
+    qint64 now() const { return m_clock.nsecsElapsed(); }
+    static QVariantMap toMap(const Launch &launch);
+
+    QElapsedTimer m_clock;
+    quint64 m_nextId = 1;
+    QList<Launch> m_pending;
+    QList<Launch> m_history;
+    QHash<QWaylandSurface *, Candidate> m_candidates;
+
+    // firstFrame：GUI 執行緒設 AwaitSync，該視窗的 render 執行緒 sync 時改成 AwaitSwap，swap 時取時間。
+    // 每個視窗有自己的 render 執行緒，狀態各自一份
+    enum FrameWait { Idle, AwaitSync, AwaitSwap };
+    QHash<QQuickWindow *, std::atomic<int> *> m_frameWait;
+};
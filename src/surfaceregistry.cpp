@@ -0,0 +1,224 @@
+#include "surfaceregistry.h"
+
+#include <QtWaylandCompositor/QWaylandClient>
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandXdgToplevel>
+
+SurfaceRegistry::SurfaceRegistry(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+SurfaceRegistry::~SurfaceRegistry()
+{
+    qDeleteAll(m_entries);
+}
+
+int SurfaceRegistry::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant SurfaceRegistry::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size())
+        return QVariant();
+
+    const Entry *entry = m_rows.at(index.row());
+    switch (role) {
+    case SurfaceRole:
+        return QVariant::fromValue<QObject *>(entry->surface);
+    case ClientPidRole:
+        return entry->pid;
+    case AppIdRole:
+        return entry->toplevel ? entry->toplevel->appId() : QString();
+    case TitleRole:
+        return entry->toplevel ? entry->toplevel->title() : QString();
+    case SizeRole:
+        return entry->surface->destinationSize();
+    case MappedRole:
+        return entry->surface->hasContent();
+    case ToplevelRole:
+        return !entry->toplevel.isNull();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> SurfaceRegistry::roleNames() const
+{
+    return {
+        {SurfaceRole, "surface"},
+        {ClientPidRole, "clientPid"},
+        {AppIdRole, "appId"},
+        {TitleRole, "title"},
+        {SizeRole, "size"},
+        {MappedRole, "mapped"},
+        {ToplevelRole, "toplevel"},
+    };
+}
+
+void SurfaceRegistry::addSurface(QWaylandSurface *surface)
+{
+    if (!surface || m_entries.contains(surface))
+        return;
+
+    auto *entry = new Entry;
+    entry->surface = surface;
+    entry->pid = surface->client() ? surface->client()->processId() : 0;
+    m_entries.insert(surface, entry);
+    m_byPid.insert(entry->pid, surface);
+
+    // surfaceDestroyed 在 surface 還有效時發出；destroyed 只是保險（例如 client 直接斷線）
+    connect(surface, &QWaylandSurface::surfaceDestroyed, this, [this, surface] { removeSurface(surface); });
+    connect(surface, &QObject::destroyed, this, [this, surface] { removeSurface(surface); });
+    connect(surface, &QWaylandSurface::hasContentChanged, this,
+            [this, surface] { notifyChanged(surface, {MappedRole}); });
+    connect(surface, &QWaylandSurface::destinationSizeChanged, this,
+            [this, surface] { notifyChanged(surface, {SizeRole}); });
+}
+
+void SurfaceRegistry::setToplevel(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel)
+{
+    addSurface(surface);
+    Entry *entry = m_entries.value(surface);
+    if (!entry || entry->toplevel == toplevel)
+        return;
+
+    if (entry->toplevel)
+        disconnect(entry->toplevel, nullptr, this, nullptr);
+    entry->toplevel = toplevel;
+    if (!toplevel) {
+        removeRow(entry);
+        return;
+    }
+
+    connect(toplevel, &QWaylandXdgToplevel::appIdChanged, this,
+            [this, surface] { notifyChanged(surface, {AppIdRole}); });
+    connect(toplevel, &QWaylandXdgToplevel::titleChanged, this,
+            [this, surface] { notifyChanged(surface, {TitleRole}); });
+    // client 可以只銷毀 xdg_toplevel、留著 wl_surface：對 QML 來說視窗已經關掉了
+    connect(toplevel, &QObject::destroyed, this, [this, surface] {
+        Entry *entry = m_entries.value(surface);
+        if (!entry || entry->row < 0)
+            return;
+        removeRow(entry);
+        emit surfaceRemoved(surface);
+    });
+    if (entry->row >= 0)
+        notifyChanged(surface, {ToplevelRole, AppIdRole, TitleRole});
+    else
+        insertRow(entry);
+}
+
+void SurfaceRegistry::markPopup(QWaylandSurface *surface, QWaylandSurface *parent)
+{
+    // popup 不佔列，只需要在索引裡（addSurface 不插入列）；記下父 surface 以便判斷它在哪個 output
+    addSurface(surface);
+    if (Entry *entry = m_entries.value(surface))
+        entry->parent = parent;
+}
+
+QList<QWaylandSurface *> SurfaceRegistry::rowSurfaces() const
+{
+    QList<QWaylandSurface *> surfaces;
+    surfaces.reserve(m_rows.size());
+    for (const Entry *entry : m_rows)
+        surfaces.append(entry->surface);
+    return surfaces;
+}
+
+QWaylandXdgToplevel *SurfaceRegistry::toplevelFor(QWaylandSurface *surface) const
+{
+    const Entry *entry = m_entries.value(surface);
+    return entry ? entry->toplevel.data() : nullptr;
+}
+
+QWaylandSurface *SurfaceRegistry::parentOf(QWaylandSurface *surface) const
+{
+    const Entry *entry = m_entries.value(surface);
+    return entry ? entry->parent.data() : nullptr;
+}
+
+bool SurfaceRegistry::contains(QObject *surface) const
+{
+    const Entry *entry = m_entries.value(static_cast<QWaylandSurface *>(surface));
+    return entry && entry->row >= 0;
+}
+
+int SurfaceRegistry::rowOf(QObject *surface) const
+{
+    const Entry *entry = m_entries.value(static_cast<QWaylandSurface *>(surface));
+    return entry ? entry->row : -1;
+}
+
+QObject *SurfaceRegistry::surfaceAt(int row) const
+{
+    return row >= 0 && row < m_rows.size() ? m_rows.at(row)->surface : nullptr;
+}
+
+QObject *SurfaceRegistry::surfaceForPid(qint64 pid) const
+{
+    QWaylandSurface *best = nullptr;
+    int bestRow = -1;
+    for (auto it = m_byPid.constFind(pid); it != m_byPid.cend() && it.key() == pid; ++it) {
+        const int row = rowOf(it.value());
+        if (row >= 0 && (bestRow < 0 || row < bestRow)) {
+            best = it.value();
+            bestRow = row;
+        }
+    }
+    return best;
+}
+
+void SurfaceRegistry::removeSurface(QWaylandSurface *surface)
+{
+    Entry *entry = m_entries.take(surface);
+    if (!entry)
+        return;
+
+    disconnect(surface, nullptr, this, nullptr);
+    if (entry->toplevel)
+        disconnect(entry->toplevel, nullptr, this, nullptr);
+    m_byPid.remove(entry->pid, surface);
+    removeRow(entry);
+    delete entry;
+    emit surfaceRemoved(surface);
+}
+
+void SurfaceRegistry::insertRow(Entry *entry)
+{
+    if (entry->row >= 0)
+        return;
+    const int row = m_rows.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.append(entry);
+    entry->row = row;
+    endInsertRows();
+    emit countChanged();
+    emit surfaceAdded(entry->surface);
+}
+
+void SurfaceRegistry::removeRow(Entry *entry)
+{
+    if (entry->row < 0)
+        return;
+    // 保留疊放順序，只移除這一列；後面的列號往前遞補
+    const int row = entry->row;
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.remove(row);
+    entry->row = -1;
+    for (int i = row; i < m_rows.size(); ++i)
+        m_rows[i]->row = i;
+    endRemoveRows();
+    emit countChanged();
+}
+
+void SurfaceRegistry::notifyChanged(QWaylandSurface *surface, const QList<int> &roles)
+{
+    const int row = rowOf(surface);
+    if (row < 0)
+        return;
+    const QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex, roles);
+}
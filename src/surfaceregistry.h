@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QMultiHash>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+class QWaylandSurface;
+class QWaylandXdgToplevel;
+
+/**
+ * SurfaceRegistry
+ *
+ * compositor 模式下的 Wayland surface 清單（QML 中以 xdgShellHelper.surfaces 取得，給 appArea 的 Repeater 用）。
+ * 取代原本 DashboardShell 裡的 JS ListModel：去重與移除不再每次線性掃 ListModel.get(i)，
+ * 每個 surface 也不再各自掛一個 JS closure。
+ *
+ * - 以 surface 指標為 key（QHash），另有 client PID → surface 的索引
+ * - 只有 xdg toplevel 佔列：在 setToplevel 時才插入（toplevel 被銷毀時移除），
+ *   popup、游標與還沒有角色的 surface 只留在索引裡，不會先插入再移除
+ * - 列的順序就是成為 toplevel 的順序（= 疊放順序），移除時只發出該列的 rowsRemoved
+ * - 每個 entry 記著自己的列號，rowOf / dataChanged 不用掃清單；移除時要保留順序，
+ *   後面的列號要往前遞補（O(n)，與 QVector 搬移元素相同）
+ * - app_id / 標題 / 大小 / 是否有內容改變時只對該列發 dataChanged（只帶變動的 role）
+ */
+class SurfaceRegistry : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        SurfaceRole = Qt::UserRole + 1,
+        ClientPidRole,
+        AppIdRole,
+        TitleRole,
+        SizeRole,
+        MappedRole,
+        ToplevelRole,
+    };
+    Q_ENUM(Roles)
+
+    explicit SurfaceRegistry(QObject *parent = nullptr);
+    ~SurfaceRegistry() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_rows.size(); }
+
+    // 由 XdgShellHelper 呼叫
+    void addSurface(QWaylandSurface *surface);
+    void setToplevel(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel);
+    void markPopup(QWaylandSurface *surface, QWaylandSurface *parent);
+
+    // 所有已知 surface（含 popup / 游標）與佔列的 surface（依疊放順序）
+    QList<QWaylandSurface *> allSurfaces() const { return m_entries.keys(); }
+    QList<QWaylandSurface *> rowSurfaces() const;
+    QWaylandXdgToplevel *toplevelFor(QWaylandSurface *surface) const;
+    // popup 的父 surface（可能也是 popup）；不是 popup 或父 surface 已銷毀時為 nullptr
+    QWaylandSurface *parentOf(QWaylandSurface *surface) const;
+
+    Q_INVOKABLE bool contains(QObject *surface) const;
+    Q_INVOKABLE int rowOf(QObject *surface) const;
+    Q_INVOKABLE QObject *surfaceAt(int row) const;
+    // 該 client 最早建立、仍在清單中的 surface（沒有時為 null）
+    Q_INVOKABLE QObject *surfaceForPid(qint64 pid) const;
+
+signals:
+    void countChanged();
+    // 成為 toplevel（插入列）時
+    void surfaceAdded(QObject *surface);
+    // surface 銷毀，或它的 toplevel 被銷毀（移除列）時；同一個 surface 可能收到兩次
+    void surfaceRemoved(QObject *surface);
+
+private:
+    struct Entry {
+        QWaylandSurface *surface = nullptr;
+        QPointer<QWaylandXdgToplevel> toplevel;
+        QPointer<QWaylandSurface> parent;   // popup 的父 surface
+        qint64 pid = 0;
+        int row = -1;          // 在 m_rows 中的位置；不佔列時為 -1
+    };
+
+    void removeSurface(QWaylandSurface *surface);
+    void insertRow(Entry *entry);
+    void removeRow(Entry *entry);
+    void notifyChanged(QWaylandSurface *surface, const QList<int> &roles);
+
+    QHash<QWaylandSurface *, Entry *> m_entries;
+    QMultiHash<qint64, QWaylandSurface *> m_byPid;
+    QVector<Entry *> m_rows;
+};
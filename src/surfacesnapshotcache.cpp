@@ -0,0 +1,80 @@
+#include "surfacesnapshotcache.h"
+
+#include "packagesurfacematcher.h"
+
+#include <QtWaylandCompositor/QWaylandBufferRef>
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandView>
+
+SurfaceSnapshotCache::SurfaceSnapshotCache(PackageSurfaceMatcher *matcher, QObject *parent)
+    : QObject(parent)
+    , m_matcher(matcher)
+{
+    bool ok = false;
+    const int budgetMb = qEnvironmentVariableIntValue("SMART_DASHBOARD_SNAPSHOT_BUDGET_MB", &ok);
+    m_cache.setMaxCost(qsizetype(ok && budgetMb >= 0 ? budgetMb : DefaultBudgetMb) * 1024 * 1024);
+    const int maxEdge = qEnvironmentVariableIntValue("SMART_DASHBOARD_SNAPSHOT_EDGE", &ok);
+    if (ok && maxEdge > 0)
+        m_maxEdge = maxEdge;
+}
+
+bool SurfaceSnapshotCache::capture(QObject *surface)
+{
+    auto *waylandSurface = qobject_cast<QWaylandSurface *>(surface);
+    if (!waylandSurface || m_cache.maxCost() == 0 || !waylandSurface->hasContent())
+        return false;
+    const QString packageName = m_matcher->packageForSurface(waylandSurface);
+    if (packageName.isEmpty())
+        return false;
+
+    // 從 view 目前持有的 buffer 拿；只有 wl_shm buffer 有 CPU 可讀的影像
+    QWaylandView *view = waylandSurface->primaryView();
+    const QWaylandBufferRef buffer = view ? view->currentBuffer() : QWaylandBufferRef();
+    if (!buffer.hasContent() || !buffer.isSharedMemory())
+        return false;
+    const QImage image = buffer.image();
+    if (image.isNull())
+        return false;
+
+    // scaled() 一定會複製，之後 buffer 被 client 重用也不影響快照
+    QImage snapshot = image.width() > m_maxEdge || image.height() > m_maxEdge
+        ? image.scaled(m_maxEdge, m_maxEdge, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+        : image.copy();
+    const qsizetype cost = snapshot.sizeInBytes();
+    if (!m_cache.insert(packageName, new QImage(std::move(snapshot)), cost))
+        return false;
+
+    emit snapshotChanged(packageName);
+    emit cacheChanged();
+    return true;
+}
+
+bool SurfaceSnapshotCache::contains(const QString &packageName) const
+{
+    return m_cache.contains(packageName.trimmed().toLower());
+}
+
+void SurfaceSnapshotCache::remove(const QString &packageName)
+{
+    const QString key = packageName.trimmed().toLower();
+    if (!m_cache.remove(key))
+        return;
+    emit snapshotChanged(key);
+    emit cacheChanged();
+}
+
+QImage SurfaceSnapshotCache::snapshot(const QString &packageName)
+{
+    const QImage *image = m_cache.object(packageName.trimmed().toLower());
+    return image ? *image : QImage();
+}
+
+void SurfaceSnapshotCache::setForegroundSurface(QWaylandSurface *surface)
+{
+    if (m_foreground == surface)
+        return;
+    // 換下來的那個還在顯示最後一幀，趁現在拍
+    if (m_foreground)
+        capture(m_foreground);
+    m_foreground = surface;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class PackageSurfaceMatcher;
+class QWaylandSurface;
+
+/**
+ * SurfaceSnapshotCache
+ *
+ * 每個 app 最後一幀的縮小快照（QML 中以 xdgShellHelper.snapshots 取得），以包名為 key。
+ * 從 Dock 切回一個 app 時，新的 buffer 還沒 commit 前 appArea 先顯示這張快照（SurfaceSnapshotItem），
+ * 而不是一片空白。
+ *
+ * - 何時拍：surface 離開前景時（FrameCallbackThrottler 的 foregroundSurface 改變），以及 capture() 明確要求時
+ * - 怎麼拍：直接從 view 目前持有的 wl_shm buffer 縮小複製（不重新 render）；dmabuf / EGL buffer 沒有
+ *   CPU 可讀的影像，不拍
+ * - 存多少：QCache（LRU），cost 為位元組數，超過 budgetBytes 時丟掉最久沒用的
+ *
+ * 環境變數：SMART_DASHBOARD_SNAPSHOT_BUDGET_MB（預設 16，0 = 停用），
+ * SMART_DASHBOARD_SNAPSHOT_EDGE（快照長邊像素，預設 640）。
+ */
+class SurfaceSnapshotCache : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY cacheChanged)
+    Q_PROPERTY(qint64 bytes READ bytes NOTIFY cacheChanged)
+    Q_PROPERTY(qint64 budgetBytes READ budgetBytes CONSTANT)
+
+public:
+    static constexpr int DefaultBudgetMb = 16;
+    static constexpr int DefaultMaxEdge = 640;
+
+    explicit SurfaceSnapshotCache(PackageSurfaceMatcher *matcher, QObject *parent = nullptr);
+
+    int count() const { return int(m_cache.count()); }
+    qint64 bytes() const { return qint64(m_cache.totalCost()); }
+    qint64 budgetBytes() const { return qint64(m_cache.maxCost()); }
+
+    // 以 surface 目前顯示的 buffer 更新它所屬 app 的快照；成功時回傳 true
+    Q_INVOKABLE bool capture(QObject *surface);
+    Q_INVOKABLE bool contains(const QString &packageName) const;
+    Q_INVOKABLE void remove(const QString &packageName);
+
+    // 沒有時為 null image（查詢會讓該項目變成最近使用）
+    QImage snapshot(const QString &packageName);
+
+    // FrameCallbackThrottler 的前景改變時呼叫：被換下來的 surface 先拍一張
+    void setForegroundSurface(QWaylandSurface *surface);
+
+signals:
+    void cacheChanged();
+    void snapshotChanged(const QString &packageName);
+
+private:
+    PackageSurfaceMatcher *m_matcher;
+    QPointer<QWaylandSurface> m_foreground;
+    QCache<QString, QImage> m_cache;
+    int m_maxEdge = DefaultMaxEdge;
+};
@@ -0,0 +1,143 @@
+#include "surfacesnapshotitem.h"
+
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+
+#include <QtWaylandCompositor/QWaylandSurface>
+
+SurfaceSnapshotItem::SurfaceSnapshotItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(DefaultTimeoutMs);
+    connect(&m_timeout, &QTimer::timeout, this, &SurfaceSnapshotItem::disarm);
+}
+
+void SurfaceSnapshotItem::setSnapshots(SurfaceSnapshotCache *snapshots)
+{
+    if (m_snapshots == snapshots)
+        return;
+    if (m_snapshots)
+        disconnect(m_snapshots, nullptr, this, nullptr);
+    m_snapshots = snapshots;
+    if (m_snapshots) {
+        connect(m_snapshots, &SurfaceSnapshotCache::snapshotChanged, this, [this](const QString &packageName) {
+            if (packageName == m_packageName.trimmed().toLower())
+                reloadSnapshot();
+        });
+    }
+    emit snapshotsChanged();
+    reloadSnapshot();
+}
+
+void SurfaceSnapshotItem::setPackageName(const QString &packageName)
+{
+    if (m_packageName == packageName)
+        return;
+    m_packageName = packageName;
+    emit packageNameChanged();
+    reloadSnapshot();
+}
+
+QObject *SurfaceSnapshotItem::liveSurface() const
+{
+    return m_liveSurface;
+}
+
+void SurfaceSnapshotItem::setLiveSurface(QObject *surface)
+{
+    auto *waylandSurface = qobject_cast<QWaylandSurface *>(surface);
+    if (m_liveSurface == waylandSurface)
+        return;
+    if (m_liveSurface)
+        disconnect(m_liveSurface, nullptr, this, nullptr);
+    m_liveSurface = waylandSurface;
+    if (m_liveSurface) {
+        // redraw：每次 commit 都會發；沒有 buffer 的 commit（例如第一次 configure）不算
+        connect(m_liveSurface, &QWaylandSurface::redraw, this, &SurfaceSnapshotItem::onLiveCommit);
+        connect(m_liveSurface, &QObject::destroyed, this, &SurfaceSnapshotItem::disarm);
+    }
+    emit liveSurfaceChanged();
+}
+
+void SurfaceSnapshotItem::setTimeoutMs(int timeoutMs)
+{
+    if (m_timeout.interval() == timeoutMs)
+        return;
+    m_timeout.setInterval(timeoutMs);
+    emit timeoutMsChanged();
+}
+
+void SurfaceSnapshotItem::beginSwitch(const QString &packageName, QObject *liveSurface)
+{
+    setPackageName(packageName);
+    setLiveSurface(liveSurface);
+    m_armed = true;
+    m_timeout.start();
+    updateShowing();
+}
+
+void SurfaceSnapshotItem::clear()
+{
+    disarm();
+    setLiveSurface(nullptr);
+    setPackageName(QString());
+}
+
+void SurfaceSnapshotItem::onLiveCommit()
+{
+    if (m_armed && m_liveSurface && m_liveSurface->hasContent())
+        disarm();
+}
+
+void SurfaceSnapshotItem::disarm()
+{
+    m_timeout.stop();
+    m_armed = false;
+    updateShowing();
+}
+
+void SurfaceSnapshotItem::reloadSnapshot()
+{
+    m_image = m_snapshots && !m_packageName.isEmpty() ? m_snapshots->snapshot(m_packageName) : QImage();
+    m_imageDirty = true;
+    updateShowing();
+    update();
+}
+
+void SurfaceSnapshotItem::updateShowing()
+{
+    const bool showing = m_armed && !m_image.isNull();
+    if (m_showing == showing)
+        return;
+    m_showing = showing;
+    emit showingChanged();
+    update();
+}
+
+QSGNode *SurfaceSnapshotItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    // 不顯示時把貼圖也釋放掉，快照只留在 SurfaceSnapshotCache 裡
+    if (!m_showing || width() <= 0 || height() <= 0) {
+        delete oldNode;
+        m_imageDirty = true;
+        return nullptr;
+    }
+
+    auto *node = static_cast<QSGSimpleTextureNode *>(oldNode);
+    if (!node) {
+        node = new QSGSimpleTextureNode;
+        node->setOwnsTexture(true);
+        node->setFiltering(QSGTexture::Linear);
+        m_imageDirty = true;
+    }
+    if (m_imageDirty) {
+        node->setTexture(window()->createTextureFromImage(m_image));
+        m_imageDirty = false;
+    }
+    node->setRect(boundingRect());
+    return node;
+}
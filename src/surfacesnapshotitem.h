@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QImage>
+#include <QPointer>
+#include <QQuickItem>
+#include <QString>
+#include <QTimer>
+
+#include "surfacesnapshotcache.h"
+
+class QWaylandSurface;
+
+/**
+ * SurfaceSnapshotItem
+ *
+ * 切換 app 時蓋在 appArea 上的快照（SurfaceSnapshotCache 中 packageName 的最後一幀）。
+ * beginSwitch() 開始顯示；liveSurface（該 app 真正的 surface）在那之後第一次帶內容的 commit
+ * （redraw）時就不再畫，露出下面的 SurfaceItem。已經在背景的 surface 原本就有內容，
+ * 所以不能看 hasContent，要等切換後的新 buffer。
+ * liveSurface 為 null（app 還沒有視窗）時等它被設定後的 commit；timeoutMs 內都沒有就收起來，
+ * 不讓舊畫面一直蓋住 appArea。快照比 appArea 小，以線性縮放填滿。
+ */
+class SurfaceSnapshotItem : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(SurfaceSnapshotCache *snapshots READ snapshots WRITE setSnapshots NOTIFY snapshotsChanged)
+    Q_PROPERTY(QString packageName READ packageName WRITE setPackageName NOTIFY packageNameChanged)
+    Q_PROPERTY(QObject *liveSurface READ liveSurface WRITE setLiveSurface NOTIFY liveSurfaceChanged)
+    Q_PROPERTY(int timeoutMs READ timeoutMs WRITE setTimeoutMs NOTIFY timeoutMsChanged)
+    Q_PROPERTY(bool showing READ showing NOTIFY showingChanged)
+    // 注意：不使用 QML_ELEMENT，因為我們在 DashboardQml::registerTypes()（src/dashboardqml.cpp）中手動註冊
+
+public:
+    static constexpr int DefaultTimeoutMs = 3000;
+
+    explicit SurfaceSnapshotItem(QQuickItem *parent = nullptr);
+
+    SurfaceSnapshotCache *snapshots() const { return m_snapshots; }
+    void setSnapshots(SurfaceSnapshotCache *snapshots);
+    QString packageName() const { return m_packageName; }
+    void setPackageName(const QString &packageName);
+    QObject *liveSurface() const;
+    void setLiveSurface(QObject *surface);
+    int timeoutMs() const { return m_timeout.interval(); }
+    void setTimeoutMs(int timeoutMs);
+    bool showing() const { return m_showing; }
+
+    // 切換到 packageName：顯示它的快照，直到 liveSurface 的下一次 commit 或逾時
+    Q_INVOKABLE void beginSwitch(const QString &packageName, QObject *liveSurface);
+    // 不再顯示（例如使用者切到別的 surface）
+    Q_INVOKABLE void clear();
+
+signals:
+    void snapshotsChanged();
+    void packageNameChanged();
+    void liveSurfaceChanged();
+    void timeoutMsChanged();
+    void showingChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    void reloadSnapshot();
+    void updateShowing();
+    void onLiveCommit();
+    void disarm();
+
+    QPointer<SurfaceSnapshotCache> m_snapshots;
+    QPointer<QWaylandSurface> m_liveSurface;
+    QString m_packageName;
+    QTimer m_timeout;
+    bool m_armed = false;      // beginSwitch 之後、live surface 還沒 commit 新 buffer
+    QImage m_image;            // GUI 執行緒取出，sync 時交給 render 執行緒
+    bool m_imageDirty = false;
+    bool m_showing = false;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * 遙測記錄檔格式（TelemetryRecorder 寫入、TelemetryReplay 以 mmap 讀取）
+ *
+ * <name>.sdtlm：
+ *   TelemetryFileHeader
+ *   TelemetryRecord × N（固定長度、時間戳單調遞增，只會往後追加）
+ *
+ * <name>.sdtlm.idx（時間索引，同樣只往後追加）：
+ *   TelemetryIndexHeader
+ *   TelemetryIndexEntry × M（每 indexInterval 筆記錄一筆）
+ *
+ * 所有欄位皆為 little-endian（寫入端與讀取端都是 x86/ARM little-endian）。
+ */
+
+namespace Telemetry {
+
+constexpr char FileMagic[8] = {'S', 'D', 'T', 'L', 'M', '0', '0', '1'};
+constexpr char IndexMagic[8] = {'S', 'D', 'T', 'L', 'I', 'D', 'X', '1'};
+constexpr quint32 FormatVersion = 1;
+constexpr int MaxSignalNames = 64;
+constexpr int SignalNameLength = 32;
+constexpr quint32 DefaultIndexInterval = 1024;
+
+struct FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    qint64 createdMsecsSinceEpoch;
+    quint32 signalCount;
+    quint32 recordSize;
+    char signalNames[MaxSignalNames][SignalNameLength];  // 依訊號 id 排列，NUL 結尾
+};
+
+struct Record {
+    qint64 timestampUs;   // 單調時鐘微秒（相對於錄製時的 steady clock）
+    double value;
+    quint16 signalId;
+    quint16 reserved0;
+    quint32 reserved1;
+};
+
+struct IndexHeader {
+    char magic[8];
+    quint32 version;
+    quint32 interval;     // 每幾筆記錄寫一筆索引
+};
+
+struct IndexEntry {
+    qint64 timestampUs;
+    quint64 recordIndex;
+};
+
+static_assert(sizeof(Record) == 24, "Telemetry::Record layout changed");
+static_assert(sizeof(IndexEntry) == 16, "Telemetry::IndexEntry layout changed");
+
+} // namespace Telemetry
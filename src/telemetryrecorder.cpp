@@ -0,0 +1,119 @@
+#include "telemetryrecorder.h"
+#include "vehiclesignalhub.h"
+
+#include <QDateTime>
+#include <QDebug>
+
+#include <cstring>
+
+namespace {
+constexpr int kFlushThreshold = 64 * 1024;
+}
+
+TelemetryRecorder::TelemetryRecorder(QObject *parent)
+    : QObject(parent)
+{
+    m_flushTimer.setInterval(1000);
+    connect(&m_flushTimer, &QTimer::timeout, this, &TelemetryRecorder::flush);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    close();
+}
+
+bool TelemetryRecorder::open(const QString &filePath, const QStringList &signalNames, quint32 indexInterval)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    m_indexFile.setFileName(filePath + QStringLiteral(".idx"));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || !m_indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "TelemetryRecorder: cannot open" << filePath << m_file.errorString();
+        m_file.close();
+        m_indexFile.close();
+        return false;
+    }
+
+    Telemetry::FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Telemetry::FileMagic, sizeof(header.magic));
+    header.version = Telemetry::FormatVersion;
+    header.headerSize = sizeof(Telemetry::FileHeader);
+    header.createdMsecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+    header.signalCount = quint32(qMin(signalNames.size(), Telemetry::MaxSignalNames));
+    header.recordSize = sizeof(Telemetry::Record);
+    for (quint32 i = 0; i < header.signalCount; ++i) {
+        const QByteArray name = signalNames.at(int(i)).toUtf8().left(Telemetry::SignalNameLength - 1);
+        std::memcpy(header.signalNames[i], name.constData(), size_t(name.size()));
+    }
+    m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    Telemetry::IndexHeader indexHeader;
+    std::memcpy(indexHeader.magic, Telemetry::IndexMagic, sizeof(indexHeader.magic));
+    indexHeader.version = Telemetry::FormatVersion;
+    indexHeader.interval = qMax<quint32>(1, indexInterval);
+    m_indexFile.write(reinterpret_cast<const char *>(&indexHeader), sizeof(indexHeader));
+
+    m_indexInterval = indexHeader.interval;
+    m_recordCount = 0;
+    m_lastTimestampUs = 0;
+    m_buffer.reserve(kFlushThreshold + int(sizeof(Telemetry::Record)));
+    m_flushTimer.start();
+    qDebug() << "TelemetryRecorder: recording to" << filePath;
+    return true;
+}
+
+void TelemetryRecorder::close()
+{
+    if (!m_file.isOpen())
+        return;
+    flush();
+    m_flushTimer.stop();
+    qDebug() << "TelemetryRecorder: closed" << m_file.fileName() << "with" << m_recordCount << "records";
+    m_file.close();
+    m_indexFile.close();
+}
+
+void TelemetryRecorder::append(const VehicleSample &sample)
+{
+    if (!m_file.isOpen())
+        return;
+
+    // 多個生產者的樣本可能稍微交錯；鉗制成單調遞增，重播時才能二分搜尋
+    Telemetry::Record record;
+    record.timestampUs = qMax(sample.timestampUs, m_lastTimestampUs);
+    record.value = sample.value;
+    record.signalId = sample.signalId;
+    record.reserved0 = 0;
+    record.reserved1 = 0;
+    m_lastTimestampUs = record.timestampUs;
+
+    if (m_recordCount % m_indexInterval == 0) {
+        const Telemetry::IndexEntry entry{record.timestampUs, m_recordCount};
+        m_indexBuffer.append(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    }
+    m_buffer.append(reinterpret_cast<const char *>(&record), sizeof(record));
+    ++m_recordCount;
+
+    if (m_buffer.size() >= kFlushThreshold)
+        flush();
+}
+
+void TelemetryRecorder::flush()
+{
+    if (!m_file.isOpen())
+        return;
+    // 先寫資料再寫索引：崩潰時索引最多落後，不會指向不存在的記錄
+    if (!m_buffer.isEmpty()) {
+        m_file.write(m_buffer);
+        m_file.flush();
+        m_buffer.truncate(0);   // 保留容量，避免每次重新配置
+    }
+    if (!m_indexBuffer.isEmpty()) {
+        m_indexFile.write(m_indexBuffer);
+        m_indexFile.flush();
+        m_indexBuffer.truncate(0);
+    }
+}
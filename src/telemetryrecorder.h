@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+#include "telemetryformat.h"
+
+struct VehicleSample;
+
+/**
+ * TelemetryRecorder
+ *
+ * 把 VehicleSignalHub 收到的每一筆樣本（合併前）寫成只追加的二進位檔，
+ * 並每 indexInterval 筆在 .idx 旁檔追加一筆時間索引，讓 TelemetryReplay 能 O(log n) 跳轉。
+ *
+ * append() 在 GUI 執行緒由 hub 每幀呼叫，只寫進記憶體緩衝；
+ * 緩衝超過 64 KB 或每秒一次才真正寫檔。
+ */
+class TelemetryRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TelemetryRecorder(QObject *parent = nullptr);
+    ~TelemetryRecorder() override;
+
+    // signalNames：依訊號 id 排列（寫進檔頭，重播時用名稱對回 id）
+    bool open(const QString &filePath, const QStringList &signalNames,
+              quint32 indexInterval = Telemetry::DefaultIndexInterval);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void append(const VehicleSample &sample);
+
+    quint64 recordCount() const { return m_recordCount; }
+
+public slots:
+    void flush();
+
+private:
+    QFile m_file;
+    QFile m_indexFile;
+    QByteArray m_buffer;
+    QByteArray m_indexBuffer;
+    QTimer m_flushTimer;
+    quint32 m_indexInterval = Telemetry::DefaultIndexInterval;
+    quint64 m_recordCount = 0;
+    qint64 m_lastTimestampUs = 0;
+};
@@ -0,0 +1,205 @@
+#include "telemetryreplay.h"
+#include "vehiclesignalhub.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// 紀錄間隔可能長達數分鐘：分段睡，stop() 才不會被卡住
+constexpr qint64 MaxSleepSliceUs = 50000;
+}
+
+TelemetryReplay::TelemetryReplay(VehicleSignalHub *hub, QObject *parent)
+    : QThread(parent)
+    , m_hub(hub)
+{
+    setObjectName(QStringLiteral("TelemetryReplay"));
+}
+
+TelemetryReplay::~TelemetryReplay()
+{
+    stop();
+    close();
+}
+
+bool TelemetryReplay::open(const QString &filePath)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "TelemetryReplay: cannot open" << filePath << m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    if (size < qint64(sizeof(Telemetry::FileHeader))) {
+        qWarning() << "TelemetryReplay: file too small" << filePath;
+        close();
+        return false;
+    }
+
+    const uchar *base = m_file.map(0, size);
+    if (!base) {
+        qWarning() << "TelemetryReplay: mmap failed" << m_file.errorString();
+        close();
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const Telemetry::FileHeader *>(base);
+    if (std::memcmp(header->magic, Telemetry::FileMagic, sizeof(header->magic)) != 0
+        || header->version != Telemetry::FormatVersion
+        || header->recordSize != sizeof(Telemetry::Record)
+        || header->headerSize > quint64(size)) {
+        qWarning() << "TelemetryReplay: not a telemetry recording" << filePath;
+        close();
+        return false;
+    }
+
+    m_records = reinterpret_cast<const Telemetry::Record *>(base + header->headerSize);
+    // 錄製中途中斷時，最後一筆可能不完整，直接忽略
+    m_recordCount = quint64(size - header->headerSize) / sizeof(Telemetry::Record);
+
+    m_idMap.fill(-1, Telemetry::MaxSignalNames);
+    const quint32 signalCount = qMin<quint32>(header->signalCount, Telemetry::MaxSignalNames);
+    for (quint32 i = 0; i < signalCount; ++i) {
+        const char *raw = header->signalNames[i];
+        const QString name = QString::fromUtf8(raw, int(strnlen(raw, Telemetry::SignalNameLength)));
+        if (!name.isEmpty())
+            m_idMap[int(i)] = m_hub->registerSignal(name);
+    }
+
+    // 時間索引是選用的：沒有 .idx 時直接在記錄上二分搜尋（記錄本身時間戳單調遞增）
+    m_indexFile.setFileName(filePath + QStringLiteral(".idx"));
+    if (m_indexFile.open(QIODevice::ReadOnly)) {
+        const qint64 indexSize = m_indexFile.size();
+        const uchar *indexBase = indexSize > qint64(sizeof(Telemetry::IndexHeader))
+                ? m_indexFile.map(0, indexSize) : nullptr;
+        const auto *indexHeader = reinterpret_cast<const Telemetry::IndexHeader *>(indexBase);
+        if (indexHeader && std::memcmp(indexHeader->magic, Telemetry::IndexMagic, sizeof(indexHeader->magic)) == 0) {
+            m_index = reinterpret_cast<const Telemetry::IndexEntry *>(indexBase + sizeof(Telemetry::IndexHeader));
+            m_indexCount = quint64(indexSize - qint64(sizeof(Telemetry::IndexHeader))) / sizeof(Telemetry::IndexEntry);
+            // 索引不能指向資料檔之外
+            while (m_indexCount > 0 && m_index[m_indexCount - 1].recordIndex >= m_recordCount)
+                --m_indexCount;
+        } else {
+            m_indexFile.close();
+        }
+    }
+
+    m_startRecord = 0;
+    qDebug() << "TelemetryReplay: opened" << filePath << m_recordCount << "records,"
+             << m_indexCount << "index entries," << durationUs() / 1000 << "ms";
+    return m_recordCount > 0;
+}
+
+void TelemetryReplay::close()
+{
+    m_records = nullptr;
+    m_recordCount = 0;
+    m_index = nullptr;
+    m_indexCount = 0;
+    // QFile::close() 會一併解除 mmap
+    m_indexFile.close();
+    m_file.close();
+}
+
+qint64 TelemetryReplay::durationUs() const
+{
+    if (m_recordCount == 0)
+        return 0;
+    return record(m_recordCount - 1).timestampUs - record(0).timestampUs;
+}
+
+quint64 TelemetryReplay::findRecord(qint64 timestampUs) const
+{
+    if (m_recordCount == 0)
+        return 0;
+
+    // 1) 在索引上找區間：從最後一個 timestamp < t 的索引點，到第一個 >= t 的索引點。
+    //    不能用 <= t：相同時間戳（夾住的或剛好相等）跨過索引點時，前面那幾筆會被跳過
+    quint64 lo = 0;
+    quint64 hi = m_recordCount;
+    if (m_indexCount > 0) {
+        const Telemetry::IndexEntry *end = m_index + m_indexCount;
+        const Telemetry::IndexEntry *it = std::lower_bound(
+            m_index, end, timestampUs,
+            [](const Telemetry::IndexEntry &e, qint64 t) { return e.timestampUs < t; });
+        if (it != m_index)
+            lo = (it - 1)->recordIndex;
+        if (it != end)
+            hi = qMin(m_recordCount, it->recordIndex + 1);
+    }
+
+    // 2) 在區間內找第一筆 timestamp >= t 的記錄
+    const Telemetry::Record *first = m_records + lo;
+    const Telemetry::Record *last = m_records + hi;
+    const Telemetry::Record *found = std::lower_bound(
+        first, last, timestampUs,
+        [](const Telemetry::Record &r, qint64 t) { return r.timestampUs < t; });
+    return quint64(found - m_records);
+}
+
+void TelemetryReplay::seek(qint64 offsetUs)
+{
+    if (m_recordCount == 0)
+        return;
+    m_startRecord = findRecord(record(0).timestampUs + qMax<qint64>(0, offsetUs));
+}
+
+void TelemetryReplay::stop()
+{
+    requestInterruption();
+    wait();
+}
+
+void TelemetryReplay::run()
+{
+    if (m_recordCount == 0)
+        return;
+
+    const bool maxSpeed = m_speed <= 0.0;
+    const qint64 wallStartUs = VehicleSignalHub::nowUs();
+    quint64 replayed = 0;
+    quint64 position = m_startRecord;
+
+    do {
+        if (position >= m_recordCount)
+            break;
+        const qint64 loopStartUs = VehicleSignalHub::nowUs();
+        const qint64 firstTs = record(position).timestampUs;
+
+        for (; position < m_recordCount && !isInterruptionRequested(); ++position) {
+            const Telemetry::Record &r = record(position);
+            const int targetId = r.signalId < Telemetry::MaxSignalNames ? m_idMap.at(r.signalId) : -1;
+            if (targetId < 0)
+                continue;
+
+            if (!maxSpeed) {
+                const qint64 dueUs = loopStartUs + qint64((r.timestampUs - firstTs) / m_speed);
+                qint64 aheadUs = dueUs - VehicleSignalHub::nowUs();
+                while (aheadUs > 1000 && !isInterruptionRequested()) {
+                    QThread::usleep(quint64(qMin(aheadUs, MaxSleepSliceUs)));
+                    aheadUs = dueUs - VehicleSignalHub::nowUs();
+                }
+                if (isInterruptionRequested())
+                    break;
+                m_hub->publish(targetId, r.value);
+            } else {
+                // 全速：ring 滿時等 GUI 執行緒取走，量測的是整條路徑的實際吞吐量
+                while (!m_hub->tryPublish(targetId, r.value) && !isInterruptionRequested())
+                    QThread::yieldCurrentThread();
+            }
+            ++replayed;
+            m_samplesReplayed.store(replayed, std::memory_order_relaxed);
+        }
+        position = 0;
+    } while (m_loop && !isInterruptionRequested());
+
+    const qint64 elapsedUs = qMax<qint64>(1, VehicleSignalHub::nowUs() - wallStartUs);
+    qDebug() << "TelemetryReplay: replayed" << replayed << "samples in" << elapsedUs / 1000 << "ms ("
+             << qRound64(replayed * 1e6 / elapsedUs) << "samples/s, speed"
+             << (maxSpeed ? QStringLiteral("max") : QString::number(m_speed)) << ")";
+    emit replayFinished(replayed, elapsedUs);
+}
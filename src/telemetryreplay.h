@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+#include <atomic>
+
+#include "telemetryformat.h"
+
+class VehicleSignalHub;
+
+/**
+ * TelemetryReplay
+ *
+ * 以 mmap 讀取 TelemetryRecorder 產生的記錄檔，在獨立執行緒上照時間重播回 VehicleSignalHub。
+ *
+ * - seek()：先在 .idx 時間索引上二分搜尋，再在一個索引區間（預設 1024 筆）內二分搜尋，O(log n)
+ * - 速度：1x、10x 等倍率照原始間隔播放；speed <= 0 為全速（max），
+ *   全速時 ring 滿了會讓出 CPU 重試而不是丟樣本，可當作「訊號 → 儀表」整條路徑的吞吐量測試
+ *
+ * 環境變量（main.cpp）：SMART_DASHBOARD_REPLAY=<檔案>、SMART_DASHBOARD_REPLAY_SPEED=1|10|max、
+ * SMART_DASHBOARD_REPLAY_START=<秒>
+ */
+class TelemetryReplay : public QThread {
+    Q_OBJECT
+
+public:
+    explicit TelemetryReplay(VehicleSignalHub *hub, QObject *parent = nullptr);
+    ~TelemetryReplay() override;
+
+    // 在 GUI 執行緒呼叫：mmap 檔案並把檔頭裡的訊號名稱對應到 hub 的訊號 id
+    bool open(const QString &filePath);
+    void close();
+
+    void setSpeed(double speed) { m_speed = speed; }
+    double speed() const { return m_speed; }
+    void setLoop(bool loop) { m_loop = loop; }
+
+    // 跳到錄製開始後 offsetUs 的位置（start() 之前呼叫）
+    void seek(qint64 offsetUs);
+    quint64 findRecord(qint64 timestampUs) const;
+
+    quint64 recordCount() const { return m_recordCount; }
+    qint64 durationUs() const;
+    quint64 samplesReplayed() const { return m_samplesReplayed.load(std::memory_order_relaxed); }
+
+    void stop();
+
+signals:
+    void replayFinished(quint64 samples, qint64 elapsedUs);
+
+protected:
+    void run() override;
+
+private:
+    const Telemetry::Record &record(quint64 index) const { return m_records[index]; }
+
+    VehicleSignalHub *m_hub;
+    QFile m_file;
+    QFile m_indexFile;
+    const Telemetry::Record *m_records = nullptr;
+    quint64 m_recordCount = 0;
+    const Telemetry::IndexEntry *m_index = nullptr;
+    quint64 m_indexCount = 0;
+    QVector<int> m_idMap;           // 檔案中的訊號 id → hub 訊號 id
+
+    quint64 m_startRecord = 0;
+    double m_speed = 1.0;
+    bool m_loop = false;
+    std::atomic<quint64> m_samplesReplayed{0};
+};
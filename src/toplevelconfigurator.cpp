@@ -0,0 +1,159 @@
+#include "toplevelconfigurator.h"
+
+#include "outputplacement.h"
+
+#include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandXdgToplevel>
+
+ToplevelConfigurator::ToplevelConfigurator(OutputPlacement *placement, QObject *parent)
+    : QObject(parent)
+    , m_placement(placement)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(DebounceMs);
+    connect(&m_debounce, &QTimer::timeout, this, &ToplevelConfigurator::applyTargetSize);
+    // app_id 送到後 surface 可能換到另一個 output，改用那邊的大小
+    connect(m_placement, &OutputPlacement::surfaceOutputChanged, this,
+            [this](QWaylandSurface *surface) { flush(surface); });
+}
+
+void ToplevelConfigurator::addToplevel(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel)
+{
+    if (!surface || !toplevel || m_entries.contains(surface))
+        return;
+
+    Entry entry;
+    entry.toplevel = toplevel;
+    m_entries.insert(surface, entry);
+
+    // redraw：每次 commit 都會發出，用來判斷 client 是否已套用上一個 configure
+    connect(surface, &QWaylandSurface::redraw, this, [this, surface] { onCommit(surface); });
+    connect(surface, &QWaylandSurface::surfaceDestroyed, this, [this, surface] { removeSurface(surface); });
+
+    // 新視窗一開始就以嵌入大小畫
+    if (targetSizeFor(surface).isValid())
+        flush(surface);
+}
+
+void ToplevelConfigurator::requestTargetSize(const QSize &size, const QString &output)
+{
+    if (size.isEmpty() || size == m_pendingTargetSizes.value(output, m_targetSizes.value(output)))
+        return;
+    m_pendingTargetSizes.insert(output, size);
+    m_debounce.start();
+}
+
+QSize ToplevelConfigurator::targetSize() const
+{
+    return m_targetSizes.value(OutputPlacement::clusterOutput());
+}
+
+QSize ToplevelConfigurator::targetSizeFor(QWaylandSurface *surface) const
+{
+    return m_targetSizes.value(m_placement->outputForSurface(surface));
+}
+
+void ToplevelConfigurator::applyTargetSize()
+{
+    bool changed = false;
+    for (auto it = m_pendingTargetSizes.cbegin(); it != m_pendingTargetSizes.cend(); ++it) {
+        QSize &current = m_targetSizes[it.key()];
+        if (current == it.value())
+            continue;
+        current = it.value();
+        changed = true;
+        if (it.key() == OutputPlacement::clusterOutput())
+            emit targetSizeChanged();
+    }
+    m_pendingTargetSizes.clear();
+    if (!changed)
+        return;
+
+    const QList<QWaylandSurface *> surfaces = m_entries.keys();
+    for (QWaylandSurface *surface : surfaces)
+        flush(surface);
+}
+
+void ToplevelConfigurator::setActivated(QWaylandSurface *surface, bool activated)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end() || it->wantActivated == int(activated))
+        return;
+    it->wantActivated = int(activated);
+    flush(surface);
+}
+
+void ToplevelConfigurator::flush(QWaylandSurface *surface)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end() || !it->toplevel)
+        return;
+    Entry &entry = *it;
+
+    const QSize target = targetSizeFor(surface);
+    const QSize size = target.isValid() ? target : entry.sentSize;
+    const bool activated = entry.wantActivated >= 0 ? entry.wantActivated != 0 : entry.toplevel->activated();
+    if (entry.sentOnce && size == entry.sentSize && activated == entry.sentActivated) {
+        entry.dirty = false;
+        return;
+    }
+    if (entry.awaitingAck) {
+        entry.dirty = true;
+        return;
+    }
+
+    // 保留其他狀態（maximized / fullscreen ...），只改 activated
+    QList<QWaylandXdgToplevel::State> states = entry.toplevel->states();
+    states.removeAll(QWaylandXdgToplevel::ActivatedState);
+    if (activated)
+        states.append(QWaylandXdgToplevel::ActivatedState);
+
+    entry.serial = entry.toplevel->sendConfigure(size.isValid() ? size : QSize(0, 0), states);
+    entry.sentSize = size;
+    entry.sentActivated = activated;
+    entry.sentOnce = true;
+    entry.awaitingAck = true;
+    entry.dirty = false;
+    ++m_sent;
+    emit statsChanged();
+
+    const uint serial = entry.serial;
+    QTimer::singleShot(AckTimeoutMs, this, [this, surface, serial] { onAckTimeout(surface, serial); });
+}
+
+void ToplevelConfigurator::onCommit(QWaylandSurface *surface)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end() || !it->awaitingAck)
+        return;
+
+    // 沒指定大小時任何 commit 都算；指定了就要等 client 真的換成這個大小
+    if (it->sentSize.isValid() && surface->destinationSize() != it->sentSize)
+        return;
+
+    it->awaitingAck = false;
+    ++m_acked;
+    emit statsChanged();
+    if (it->dirty)
+        flush(surface);
+}
+
+void ToplevelConfigurator::onAckTimeout(QWaylandSurface *surface, uint serial)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end() || !it->awaitingAck || it->serial != serial)
+        return;
+
+    // client 不理會大小（或畫面被節流沒有 commit），不再擋住後面的 configure
+    it->awaitingAck = false;
+    ++m_timedOut;
+    emit statsChanged();
+    if (it->dirty)
+        flush(surface);
+}
+
+void ToplevelConfigurator::removeSurface(QWaylandSurface *surface)
+{
+    if (m_entries.remove(surface))
+        disconnect(surface, nullptr, this, nullptr);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QTimer>
+
+class OutputPlacement;
+class QWaylandSurface;
+class QWaylandXdgToplevel;
+
+/**
+ * ToplevelConfigurator
+ *
+ * 所有送給 xdg_toplevel 的 configure 都從這裡出去（QML 中以 xdgShellHelper.configurator 取得）：
+ *
+ * - 大小：surface 所在 output 的嵌入區域大小（cluster 為 XdgShellHelper.embedSize，其他 output 由
+ *   XdgShellHelper.setOutputEmbedSize() 設定），讓 Waydroid 直接以嵌入大小畫，而不是以自己的
+ *   預設解析度畫再由 WaylandQuickItem 縮放。拖動 / 版面變動時以 DebounceMs 合併，只送最後的大小；
+ *   surface 換到另一個 output（OutputPlacement）時改送那個 output 的大小
+ * - activated：由 FrameCallbackThrottler 決定（前景為 activated）
+ *
+ * 每個 toplevel 同時最多一個未確認的 configure：送出後等到 client commit 出符合的大小
+ * （或 AckTimeoutMs 逾時）才送下一個，中間的變化合併成一次。Qt 沒有公開 ack_configure 的訊號，
+ * 所以「確認」以之後的 commit 判斷。
+ */
+class ToplevelConfigurator : public QObject {
+    Q_OBJECT
+    // cluster 的嵌入大小
+    Q_PROPERTY(QSize targetSize READ targetSize NOTIFY targetSizeChanged)
+    Q_PROPERTY(int configuresSent READ configuresSent NOTIFY statsChanged)
+    Q_PROPERTY(int configuresAcked READ configuresAcked NOTIFY statsChanged)
+    Q_PROPERTY(int configuresTimedOut READ configuresTimedOut NOTIFY statsChanged)
+
+public:
+    static constexpr int DebounceMs = 120;
+    static constexpr int AckTimeoutMs = 500;
+
+    explicit ToplevelConfigurator(OutputPlacement *placement, QObject *parent = nullptr);
+
+    void addToplevel(QWaylandSurface *surface, QWaylandXdgToplevel *toplevel);
+
+    // 某個 output 新的嵌入大小（邏輯像素），DebounceMs 內的變化只送最後一次
+    void requestTargetSize(const QSize &size, const QString &output);
+    QSize targetSize() const;
+
+    void setActivated(QWaylandSurface *surface, bool activated);
+
+    int configuresSent() const { return m_sent; }
+    int configuresAcked() const { return m_acked; }
+    int configuresTimedOut() const { return m_timedOut; }
+
+signals:
+    void targetSizeChanged();
+    void statsChanged();
+
+private:
+    struct Entry {
+        QPointer<QWaylandXdgToplevel> toplevel;
+        QSize sentSize;
+        int wantActivated = -1;   // -1：不干涉
+        bool sentActivated = false;
+        bool sentOnce = false;
+        bool awaitingAck = false;
+        bool dirty = false;       // 等待確認期間又有變化
+        uint serial = 0;
+    };
+
+    void applyTargetSize();
+    QSize targetSizeFor(QWaylandSurface *surface) const;
+    void flush(QWaylandSurface *surface);
+    void onCommit(QWaylandSurface *surface);
+    void onAckTimeout(QWaylandSurface *surface, uint serial);
+    void removeSurface(QWaylandSurface *surface);
+
+    OutputPlacement *m_placement;
+    QHash<QWaylandSurface *, Entry> m_entries;
+    QHash<QString, QSize> m_targetSizes;          // output 名稱 → 已生效的大小
+    QHash<QString, QSize> m_pendingTargetSizes;   // debounce 中
+    QTimer m_debounce;
+    int m_sent = 0;
+    int m_acked = 0;
+    int m_timedOut = 0;
+};
@@ -0,0 +1,197 @@
+#include "vehiclesignalhub.h"
+#include "telemetryrecorder.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QtNumeric>
+
+#include <chrono>
+
+VehicleSignalHub::VehicleSignalHub(QObject *parent)
+    : QObject(parent)
+{
+    m_names = {QStringLiteral("speed"), QStringLiteral("rpm"),
+               QStringLiteral("fuelLevel"), QStringLiteral("odometer")};
+
+    // 尚未綁定視窗時（例如 QML 還在載入）用計時器代替幀訊號
+    m_fallbackTimer.setSingleShot(true);
+    m_fallbackTimer.setInterval(16);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &VehicleSignalHub::onFrame);
+
+    // 被頻率上限延後的訊號：到期後再排一次 flush，確保最後的值會顯示
+    m_deferTimer.setSingleShot(true);
+    m_deferTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_deferTimer, &QTimer::timeout, this, &VehicleSignalHub::retryDeferred);
+}
+
+qint64 VehicleSignalHub::nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool VehicleSignalHub::publish(int signalId, double value, qint64 timestampUs)
+{
+    if (tryPublish(signalId, value, timestampUs))
+        return true;
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool VehicleSignalHub::tryPublish(int signalId, double value, qint64 timestampUs)
+{
+    if (signalId < 0 || signalId >= MaxSignals)
+        return false;
+
+    const VehicleSample sample{timestampUs > 0 ? timestampUs : nowUs(), value,
+                               static_cast<quint16>(signalId)};
+    if (!m_ring.tryPush(sample))
+        return false;
+
+    // 每幀只排一次：第一個把旗標從 false 改成 true 的生產者負責叫醒 GUI 執行緒
+    if (!m_flushPending.exchange(true, std::memory_order_acq_rel))
+        QMetaObject::invokeMethod(this, &VehicleSignalHub::scheduleFlush, Qt::QueuedConnection);
+    return true;
+}
+
+int VehicleSignalHub::registerSignal(const QString &name)
+{
+    const int existing = m_names.indexOf(name);
+    if (existing >= 0)
+        return existing;
+    if (m_names.size() >= MaxSignals) {
+        qWarning() << "VehicleSignalHub: too many signals, cannot register" << name;
+        return -1;
+    }
+    m_names.append(name);
+    return m_names.size() - 1;
+}
+
+int VehicleSignalHub::signalId(const QString &name) const
+{
+    return m_names.indexOf(name);
+}
+
+QString VehicleSignalHub::signalName(int signalId) const
+{
+    return m_names.value(signalId);
+}
+
+double VehicleSignalHub::value(const QString &name) const
+{
+    const int id = signalId(name);
+    return id >= 0 ? m_published[id] : qQNaN();
+}
+
+void VehicleSignalHub::attachWindow(QQuickWindow *window)
+{
+    if (m_window == window)
+        return;
+    if (m_window)
+        disconnect(m_window, nullptr, this, nullptr);
+
+    m_window = window;
+    if (m_window) {
+        // afterAnimating 在 GUI 執行緒、同步到 render thread 之前發出：
+        // 在這裡更新屬性，變更會在同一幀被畫出來
+        connect(m_window, &QQuickWindow::afterAnimating, this, &VehicleSignalHub::onFrame);
+        qDebug() << "VehicleSignalHub: attached to window" << m_window;
+    }
+    if (m_flushPending.load(std::memory_order_acquire))
+        scheduleFlush();
+}
+
+void VehicleSignalHub::scheduleFlush()
+{
+    if (m_window)
+        m_window->requestUpdate();
+    else if (!m_fallbackTimer.isActive())
+        m_fallbackTimer.start();
+}
+
+void VehicleSignalHub::retryDeferred()
+{
+    if (!m_flushPending.exchange(true, std::memory_order_acq_rel))
+        scheduleFlush();
+}
+
+void VehicleSignalHub::onFrame()
+{
+    emit frameStarting();
+    flush();
+}
+
+void VehicleSignalHub::flush()
+{
+    // 先清旗標再取資料：之後才進來的樣本會重新排程下一幀
+    if (!m_flushPending.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    VehicleSample sample;
+    quint64 drained = 0;
+    while (m_ring.tryPop(sample)) {
+        ++drained;
+        if (m_recorder)
+            m_recorder->append(sample);
+        // 同一幀內的多筆樣本只保留最後一筆（ring 保留各生產者的寫入順序）
+        m_latest[sample.signalId] = sample.value;
+        m_latestTimestampUs[sample.signalId] = sample.timestampUs;
+        m_dirty.set(sample.signalId);
+    }
+    if (m_dirty.none())
+        return;
+
+    m_samplesReceived += drained;
+    ++m_flushCount;
+
+    // 過濾階段：畫面上看不出差異的更新不會進到 QML
+    const qint64 now = nowUs();
+    qint64 retryInUs = -1;
+    const int count = m_names.size();
+    for (int id = 0; id < count; ++id) {
+        if (!m_dirty.test(id))
+            continue;
+
+        double value = 0.0;
+        qint64 waitUs = 0;
+        switch (m_filter.evaluate(id, m_latest[id], m_published[id], now, &value, &waitUs)) {
+        case SignalFilter::Suppress:
+            m_dirty.reset(id);
+            ++m_suppressed;
+            break;
+        case SignalFilter::Defer:
+            // 保持 dirty，等到期後以最新值再評估
+            retryInUs = retryInUs < 0 ? waitUs : qMin(retryInUs, waitUs);
+            break;
+        case SignalFilter::Publish:
+            m_dirty.reset(id);
+            m_published[id] = value;
+            emitChanged(id);
+            break;
+        }
+    }
+    if (retryInUs >= 0 && !m_deferTimer.isActive())
+        m_deferTimer.start(int((retryInUs + 999) / 1000));
+    emit statsChanged();
+}
+
+void VehicleSignalHub::emitChanged(int signalId)
+{
+    switch (signalId) {
+    case Speed:
+        emit speedChanged();
+        break;
+    case Rpm:
+        emit rpmChanged();
+        break;
+    case FuelLevel:
+        emit fuelLevelChanged();
+        break;
+    case Odometer:
+        emit odometerChanged();
+        break;
+    default:
+        break;
+    }
+    emit signalUpdated(signalId, m_published[signalId]);
+}
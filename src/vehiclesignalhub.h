@@ -0,0 +1,143 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <atomic>
+#include <bitset>
+
+#include "signalfilter.h"
+#include "signalring.h"
+
+class TelemetryRecorder;
+
+// 擷取執行緒丟進 ring 的單筆樣本
+struct VehicleSample {
+    qint64 timestampUs;   // 單調時鐘（steady clock）微秒
+    double value;
+    quint16 signalId;
+};
+
+/**
+ * VehicleSignalHub
+ *
+ * 車輛訊號的匯流中心：擷取執行緒（CAN、網路、重播...）把樣本丟進無鎖 ring，
+ * GUI 執行緒在每一幀開始前（QQuickWindow::afterAnimating）一次把 ring 取乾淨，
+ * 每個訊號只保留最新值，最後每幀最多發出一次屬性變更通知給 QML。
+ *
+ * 我們的資料源是 100~1000 Hz，若每筆樣本都觸發 QML binding，GUI 執行緒會被淹沒；
+ * 這裡把頻率降到與畫面更新一致。
+ *
+ * 用法（main.cpp）：
+ *   VehicleSignalHub hub;
+ *   engine.rootContext()->setContextProperty("VehicleSignals", &hub);
+ *   ...載入 QML 後...
+ *   hub.attachWindow(window);
+ */
+class VehicleSignalHub : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(double speed READ speed NOTIFY speedChanged)
+    Q_PROPERTY(double rpm READ rpm NOTIFY rpmChanged)
+    Q_PROPERTY(double fuelLevel READ fuelLevel NOTIFY fuelLevelChanged)
+    Q_PROPERTY(double odometer READ odometer NOTIFY odometerChanged)
+    Q_PROPERTY(quint64 samplesReceived READ samplesReceived NOTIFY statsChanged)
+    Q_PROPERTY(quint64 droppedSamples READ droppedSamples NOTIFY statsChanged)
+    Q_PROPERTY(quint64 flushCount READ flushCount NOTIFY statsChanged)
+    Q_PROPERTY(quint64 suppressedUpdates READ suppressedUpdates NOTIFY statsChanged)
+
+public:
+    // 內建訊號（固定 id，儀表直接綁定）；其他訊號用 registerSignal() 動態註冊
+    enum SignalId {
+        Speed = 0,      // km/h
+        Rpm,            // r/min
+        FuelLevel,      // 0~100 %
+        Odometer,       // km
+        BuiltinSignalCount
+    };
+    Q_ENUM(SignalId)
+
+    static constexpr int MaxSignals = SignalFilter::MaxSignals;
+    static constexpr std::size_t RingCapacity = 8192;
+
+    explicit VehicleSignalHub(QObject *parent = nullptr);
+
+    // 任何執行緒皆可呼叫（無鎖）；timestampUs <= 0 時用目前時間
+    // ring 滿時回傳 false 並累計 droppedSamples
+    bool publish(int signalId, double value, qint64 timestampUs = 0);
+    // 同 publish()，但 ring 滿時不計入 droppedSamples（呼叫端會自己重試，例如全速重播）
+    bool tryPublish(int signalId, double value, qint64 timestampUs = 0);
+
+    // 以下只能在 GUI 執行緒呼叫（擷取執行緒啟動前先註冊好）
+    int registerSignal(const QString &name);
+    int signalId(const QString &name) const;
+    QString signalName(int signalId) const;
+    int signalCount() const { return m_names.size(); }
+    QStringList signalNames() const { return m_names; }
+
+    // 綁定到要同步更新的視窗；未綁定時退回 16 ms 計時器
+    void attachWindow(QQuickWindow *window);
+
+    // 顯示政策（deadband / 頻率上限 / 量化），在發佈給 QML 之前套用
+    void setPolicy(int signalId, const SignalPolicy &policy) { m_filter.setPolicy(signalId, policy); }
+
+    // 錄製：每幀取出的每一筆樣本（合併前）都交給 recorder
+    void setRecorder(TelemetryRecorder *recorder) { m_recorder = recorder; }
+
+    Q_INVOKABLE double value(const QString &name) const;
+
+    double speed() const { return m_published[Speed]; }
+    double rpm() const { return m_published[Rpm]; }
+    double fuelLevel() const { return m_published[FuelLevel]; }
+    double odometer() const { return m_published[Odometer]; }
+
+    quint64 samplesReceived() const { return m_samplesReceived; }
+    quint64 droppedSamples() const { return m_dropped.load(std::memory_order_relaxed); }
+    quint64 flushCount() const { return m_flushCount; }
+    quint64 suppressedUpdates() const { return m_suppressed; }
+
+    static qint64 nowUs();
+
+signals:
+    void speedChanged();
+    void rpmChanged();
+    void fuelLevelChanged();
+    void odometerChanged();
+    // 每個訊號每幀最多一次（包含動態註冊的訊號）
+    void signalUpdated(int signalId, double value);
+    void statsChanged();
+    // 每幀取 ring 之前（GUI 執行緒）：輪詢型的資料源在這裡讀，讀到的樣本同一幀就會顯示
+    void frameStarting();
+
+private slots:
+    void scheduleFlush();
+    void onFrame();
+    void flush();
+    void retryDeferred();
+
+private:
+    void emitChanged(int signalId);
+
+    SignalRing<VehicleSample, RingCapacity> m_ring;
+    std::atomic<bool> m_flushPending{false};
+    std::atomic<quint64> m_dropped{0};
+
+    // 以下僅 GUI 執行緒存取
+    double m_latest[MaxSignals] = {};
+    qint64 m_latestTimestampUs[MaxSignals] = {};
+    double m_published[MaxSignals] = {};
+    std::bitset<MaxSignals> m_dirty;
+    QStringList m_names;
+    quint64 m_samplesReceived = 0;
+    quint64 m_flushCount = 0;
+    quint64 m_suppressed = 0;
+    SignalFilter m_filter;
+    QTimer m_deferTimer;
+
+    QPointer<QQuickWindow> m_window;
+    TelemetryRecorder *m_recorder = nullptr;
+    QTimer m_fallbackTimer;
+};
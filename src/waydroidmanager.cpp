@@ -1,9 +1,55 @@
 #include "waydroidmanager.h"
 #include "waydroidwindowembedder.h"
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
 QObject* WaydroidManager::createWindowEmbedder(const QString &pkg) {
     auto *embedder = new WaydroidWindowEmbedder(this);
     embedder->setPackageName(pkg);
     return embedder;
 }
 
+QString WaydroidManager::appsCachePath() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/waydroid-apps.json");
+}
+
+void WaydroidManager::loadAppsCache() {
+    QFile file(appsCachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QVector<AppEntry> apps;
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).array();
+    apps.reserve(entries.size());
+    for (const QJsonValue &value : entries) {
+        const QJsonObject entry = value.toObject();
+        const QString package = entry.value(QStringLiteral("package")).toString();
+        if (!package.isEmpty())
+            apps.push_back(AppEntry{entry.value(QStringLiteral("label")).toString(), package});
+    }
+    qDebug() << "WaydroidManager: loaded" << apps.size() << "apps from" << file.fileName();
+    m_apps->setApps(std::move(apps));
+}
+
+void WaydroidManager::saveAppsCache(const QVector<AppEntry> &apps) {
+    const QString path = appsCachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QJsonArray entries;
+    for (const AppEntry &app : apps)
+        entries.append(QJsonObject{{QStringLiteral("label"), app.label}, {QStringLiteral("package"), app.package}});
+
+    // QSaveFile：寫到一半斷電也不會留下壞掉的快取
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(entries).toJson(QJsonDocument::Compact)) < 0
+        || !file.commit()) {
+        qWarning() << "WaydroidManager: cannot write app cache" << path;
+    }
+}
@@ -7,137 +7,81 @@
 #include <QVector>
 #include <QDebug>
 #include <QRegularExpression>
+#include <QSet>
 
-struct AppEntry {
-    QString label;
-    QString package;
-};
-
-class AppsModel : public QAbstractListModel {
-    Q_OBJECT
-    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
-public:
-    enum Roles { LabelRole = Qt::UserRole + 1, PackageRole };
-
-    explicit AppsModel(QObject *parent = nullptr)
-        : QAbstractListModel(parent) {}
-
-    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
-        Q_UNUSED(parent);
-        return m_apps.size();
-    }
-
-    QVariant data(const QModelIndex &index, int role) const override {
-        if (!index.isValid() || index.row() < 0 || index.row() >= m_apps.size())
-            return {};
-        const auto &app = m_apps.at(index.row());
-        switch (role) {
-        case LabelRole:
-            return app.label;
-        case PackageRole:
-            return app.package;
-        default:
-            return {};
-        }
-    }
-
-    QHash<int, QByteArray> roleNames() const override {
-        return {{LabelRole, QByteArrayLiteral("label")},
-                {PackageRole, QByteArrayLiteral("package")}};
-    }
-
-    void setApps(QVector<AppEntry> apps) {
-        beginResetModel();
-        m_apps = std::move(apps);
-        endResetModel();
-        emit countChanged();
-    }
-
-signals:
-    void countChanged();
-
-private:
-    QVector<AppEntry> m_apps;
-};
+#include "appsmodel.h"
+#include "waydroidsessionmonitor.h"
 
 class WaydroidManager : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool running READ running NOTIFY runningChanged)
     Q_PROPERTY(AppsModel *appsModel READ appsModel CONSTANT)
+    // session 狀態來源（inotify 監看 / 退避輪詢）與省下的 fork 次數
+    Q_PROPERTY(WaydroidSessionMonitor *monitor READ monitor CONSTANT)
 public:
     explicit WaydroidManager(QObject *parent = nullptr)
         : QObject(parent)
         , m_running(false)
         , m_apps(new AppsModel(this))
+        , m_monitor(new WaydroidSessionMonitor(this))
         , m_refreshing(false)
         , m_refreshProcess(nullptr)
         , m_startupDelayDone(false)
         , m_refreshRetryCount(0)
     {
-        connect(&m_timer, &QTimer::timeout, this, &WaydroidManager::checkStatus);
-        m_timer.start(3000);  // 改為 3 秒，給 Waydroid 更多時間
-        checkStatus();
+        // 上次的 app 列表：Dock 第一幀就有圖示，不用等 Waydroid 啟動 + app list 完成
+        loadAppsCache();
+
+        // 不再固定每 3 秒 fork `waydroid status`：狀態改變時由 monitor 通知
+        connect(m_monitor, &WaydroidSessionMonitor::runningChanged, this, &WaydroidManager::onRunningChanged);
+        // 確定沒有在執行（包括第一次確認、Waydroid 沒安裝）就收起列表，Dock 不會對著停掉的 session 啟動 app；
+        // 磁碟上的快取保留，下次啟動時仍然先顯示
+        connect(m_monitor, &WaydroidSessionMonitor::checkFinished, this, [this](bool running) {
+            if (!running && m_apps->rowCount() > 0) {
+                qDebug() << "WaydroidManager: Waydroid not running, hiding" << m_apps->rowCount() << "cached apps";
+                m_apps->setApps({});
+            }
+        });
+
+        // Android 啟動時 app 會陸續出現：啟動後前 10 次每 3 秒刷新 app 列表
+        m_appRefreshTimer.setInterval(3000);
+        connect(&m_appRefreshTimer, &QTimer::timeout, this, [this]() {
+            if (!m_running || m_refreshRetryCount >= 10) {
+                m_appRefreshTimer.stop();
+                return;
+            }
+            qDebug() << "WaydroidManager: Waydroid running, refreshing apps (attempt" << m_refreshRetryCount << ")";
+            refreshApps();
+        });
     }
 
     bool running() const { return m_running; }
     AppsModel *appsModel() const { return m_apps; }
+    WaydroidSessionMonitor *monitor() const { return m_monitor; }
 
-    Q_INVOKABLE void startSession() { QProcess::startDetached(QStringLiteral("waydroid"), {QStringLiteral("container"), QStringLiteral("start")}); }
-    Q_INVOKABLE void stopSession() { QProcess::startDetached(QStringLiteral("waydroid"), {QStringLiteral("container"), QStringLiteral("stop")}); }
-    Q_INVOKABLE void showFullUI() { QProcess::startDetached(QStringLiteral("waydroid"), {QStringLiteral("show-full-ui")}); }
-    Q_INVOKABLE void launchApp(const QString &pkg) { QProcess::startDetached(QStringLiteral("waydroid"), {QStringLiteral("app"), QStringLiteral("launch"), pkg}); }
+    Q_INVOKABLE void startSession() { QProcess::startDetached(WaydroidSessionMonitor::waydroidProgram(), {QStringLiteral("container"), QStringLiteral("start")}); }
+    Q_INVOKABLE void stopSession() { QProcess::startDetached(WaydroidSessionMonitor::waydroidProgram(), {QStringLiteral("container"), QStringLiteral("stop")}); }
+    Q_INVOKABLE void showFullUI() { QProcess::startDetached(WaydroidSessionMonitor::waydroidProgram(), {QStringLiteral("show-full-ui")}); }
+    Q_INVOKABLE void launchApp(const QString &pkg) { QProcess::startDetached(WaydroidSessionMonitor::waydroidProgram(), {QStringLiteral("app"), QStringLiteral("launch"), pkg}); }
     
     // 創建視窗嵌入器（返回給 QML 使用）
     Q_INVOKABLE QObject* createWindowEmbedder(const QString &pkg);
 
+    // 上次成功取得的 app 列表（CacheLocation/waydroid-apps.json）
+    static QString appsCachePath();
+
 signals:
     void runningChanged();
 
 public slots:
     void checkStatus() {
-        auto *process = new QProcess(this);
-        connect(process, &QProcess::finished, this, [this, process](int, QProcess::ExitStatus) {
-            const QString output = QString::fromUtf8(process->readAllStandardOutput());
-            process->deleteLater();
-            const bool newState = output.contains(QStringLiteral("RUNNING"), Qt::CaseInsensitive)
-                                  || output.contains(QStringLiteral("Running: Yes"), Qt::CaseInsensitive);
-            
-            qDebug() << "WaydroidManager::checkStatus() - output:" << output.trimmed();
-            qDebug() << "WaydroidManager::checkStatus() - newState:" << newState << "current m_running:" << m_running;
-            
-            if (newState != m_running) {
-                m_running = newState;
-                qDebug() << "WaydroidManager::checkStatus() - state changed to:" << m_running;
-                emit runningChanged();
-                if (m_running) {
-                    // Waydroid 剛啟動，等待 8 秒讓它完全初始化
-                    // （"Failed to get service waydroidplatform" 表示還沒準備好）
-                    m_startupDelayDone = false;
-                    m_refreshRetryCount = 0;
-                    qDebug() << "WaydroidManager::checkStatus() - Waydroid just started, waiting 8s for initialization...";
-                    QTimer::singleShot(8000, this, [this]() {
-                        m_startupDelayDone = true;
-                        qDebug() << "WaydroidManager: Startup delay done, now refreshing apps";
-                        refreshApps();
-                    });
-                } else {
-                    m_startupDelayDone = false;
-                    m_apps->setApps({});
-                }
-            } else if (m_running && m_startupDelayDone && m_refreshRetryCount < 10) {
-                // 持續刷新 app 列表（前 10 次），因為 Android 啟動時 app 會陸續出現
-                // 即使已經有一些 app，也要繼續刷新以獲取完整列表
-                qDebug() << "WaydroidManager::checkStatus() - Waydroid running, refreshing apps (attempt" << m_refreshRetryCount << ")";
-                refreshApps();
-            }
-        });
-        process->start(QStringLiteral("waydroid"), {QStringLiteral("status")});
+        m_monitor->checkNow();
     }
 
     void refreshApps() {
         if (!m_running) {
-            qDebug() << "WaydroidManager::refreshApps() - Waydroid not running, clearing apps";
-            m_apps->setApps({});
+            // 列表已在 monitor 確認沒有執行時收起，Waydroid 起來後再刷新
+            qDebug() << "WaydroidManager::refreshApps() - Waydroid not running, skipping";
             return;
         }
 
@@ -325,15 +269,55 @@ public slots:
             }
             
             qDebug() << "WaydroidManager::refreshApps() - total apps:" << apps.size();
+            if (apps.isEmpty()) {
+                // Android 還沒啟動完時常是空的：保留目前（可能來自快取）的列表
+                return;
+            }
+            if (apps != m_apps->apps())
+                saveAppsCache(apps);
             m_apps->setApps(std::move(apps));
         });
-        process->start(QStringLiteral("waydroid"), {QStringLiteral("app"), QStringLiteral("list")});
+        process->start(WaydroidSessionMonitor::waydroidProgram(), {QStringLiteral("app"), QStringLiteral("list")});
     }
 
 private:
+    void loadAppsCache();
+    void saveAppsCache(const QVector<AppEntry> &apps);
+
+    void onRunningChanged() {
+        const bool newState = m_monitor->running();
+        if (newState == m_running)
+            return;
+        m_running = newState;
+        qDebug() << "WaydroidManager: state changed to:" << m_running;
+        emit runningChanged();
+        if (m_running) {
+            // 停止時收起的列表先從快取放回來，app list 完成後再增量更新
+            if (m_apps->rowCount() == 0)
+                loadAppsCache();
+            // Waydroid 剛啟動，等待 8 秒讓它完全初始化
+            // （"Failed to get service waydroidplatform" 表示還沒準備好）
+            m_startupDelayDone = false;
+            m_refreshRetryCount = 0;
+            qDebug() << "WaydroidManager: Waydroid just started, waiting 8s for initialization...";
+            QTimer::singleShot(8000, this, [this]() {
+                if (!m_running)
+                    return;
+                m_startupDelayDone = true;
+                qDebug() << "WaydroidManager: Startup delay done, now refreshing apps";
+                refreshApps();
+                m_appRefreshTimer.start();
+            });
+        } else {
+            m_startupDelayDone = false;
+            m_appRefreshTimer.stop();
+        }
+    }
+
     bool m_running;
-    QTimer m_timer;
     AppsModel *m_apps;
+    WaydroidSessionMonitor *m_monitor;
+    QTimer m_appRefreshTimer;
     bool m_refreshing;
     QProcess *m_refreshProcess;
     QTimer *m_refreshTimeout = nullptr;
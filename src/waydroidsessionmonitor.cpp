@@ -0,0 +1,150 @@
+#include "waydroidsessionmonitor.h"
+
+#include <QDebug>
+#include <QFileInfo>
+
+QString WaydroidSessionMonitor::waydroidProgram()
+{
+    const QString program = qEnvironmentVariable("SMART_DASHBOARD_WAYDROID_BIN");
+    return program.isEmpty() ? QStringLiteral("waydroid") : program;
+}
+
+QStringList WaydroidSessionMonitor::defaultWatchPaths()
+{
+    const QString paths = qEnvironmentVariable("SMART_DASHBOARD_WAYDROID_WATCH");
+    if (!paths.isEmpty())
+        return paths.split(QLatin1Char(':'), Qt::SkipEmptyParts);
+    // 目錄：session.cfg 等檔案建立 / 刪除；檔案：內容改變（state = RUNNING / STOPPED）
+    return {QStringLiteral("/var/lib/waydroid"),
+            QStringLiteral("/var/lib/waydroid/session.cfg"),
+            QStringLiteral("/var/lib/waydroid/lxc/waydroid")};
+}
+
+bool WaydroidSessionMonitor::parseStatus(const QString &output)
+{
+    return output.contains(QStringLiteral("RUNNING"), Qt::CaseInsensitive)
+        || output.contains(QStringLiteral("Running: Yes"), Qt::CaseInsensitive);
+}
+
+WaydroidSessionMonitor::WaydroidSessionMonitor(QObject *parent)
+    : QObject(parent)
+    , m_paths(defaultWatchPaths())
+{
+    m_uptime.start();
+
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(DebounceMs);
+    connect(&m_debounce, &QTimer::timeout, this, &WaydroidSessionMonitor::checkNow);
+
+    m_poll.setSingleShot(true);
+    connect(&m_poll, &QTimer::timeout, this, &WaydroidSessionMonitor::checkNow);
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &WaydroidSessionMonitor::onWatchEvent);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &WaydroidSessionMonitor::onWatchEvent);
+
+    updateWatches();
+    checkNow();
+}
+
+QString WaydroidSessionMonitor::mode() const
+{
+    return watchedPaths().isEmpty() ? QStringLiteral("poll") : QStringLiteral("watch");
+}
+
+QStringList WaydroidSessionMonitor::watchedPaths() const
+{
+    return m_watcher.files() + m_watcher.directories();
+}
+
+int WaydroidSessionMonitor::spawnsAvoided() const
+{
+    const int legacySpawns = int(m_uptime.elapsed() / LegacyPollMs) + 1;
+    return qMax(0, legacySpawns - m_statusSpawns);
+}
+
+void WaydroidSessionMonitor::checkNow()
+{
+    if (m_process) {
+        m_checkPending = true;
+        return;
+    }
+    m_poll.stop();
+
+    auto *process = new QProcess(this);
+    m_process = process;
+    connect(process, &QProcess::finished, this, [this, process](int, QProcess::ExitStatus) {
+        const QString output = QString::fromUtf8(process->readAllStandardOutput());
+        process->deleteLater();
+        qDebug() << "WaydroidSessionMonitor: status output:" << output.trimmed();
+        finishCheck(parseStatus(output));
+    });
+    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
+        // 啟動失敗時不會有 finished
+        if (error != QProcess::FailedToStart)
+            return;
+        qWarning() << "WaydroidSessionMonitor: cannot run" << waydroidProgram() << "-" << process->errorString();
+        process->deleteLater();
+        finishCheck(false);
+    });
+    ++m_statusSpawns;
+    process->start(waydroidProgram(), {QStringLiteral("status")});
+}
+
+void WaydroidSessionMonitor::onWatchEvent(const QString &path)
+{
+    qDebug() << "WaydroidSessionMonitor: changed:" << path;
+    // 被刪除再建立的檔案會從 watcher 中移除，要重新加回去
+    updateWatches();
+    m_debounce.start();
+}
+
+void WaydroidSessionMonitor::updateWatches()
+{
+    QStringList missing;
+    for (const QString &path : std::as_const(m_paths)) {
+        if (!m_watcher.files().contains(path) && !m_watcher.directories().contains(path) && QFileInfo::exists(path))
+            missing.append(path);
+    }
+    if (!missing.isEmpty())
+        m_watcher.addPaths(missing);
+
+    // 被刪除的路徑 watcher 會自己移除，所以和上次的清單比
+    const QStringList watched = watchedPaths();
+    if (watched != m_lastWatched) {
+        m_lastWatched = watched;
+        qDebug() << "WaydroidSessionMonitor: mode" << mode() << "watching" << watched;
+        emit modeChanged();
+    }
+}
+
+void WaydroidSessionMonitor::finishCheck(bool running)
+{
+    m_process = nullptr;
+
+    if (running != m_running) {
+        m_running = running;
+        m_pollIntervalMs = MinPollMs;
+        qDebug() << "WaydroidSessionMonitor: running changed to" << m_running;
+        emit runningChanged();
+    } else {
+        // 狀態沒變：輪詢間隔加倍（只影響 poll 模式）
+        m_pollIntervalMs = qMin(m_pollIntervalMs * 2, MaxPollMs);
+    }
+    emit statsChanged();
+    emit checkFinished(m_running);
+
+    if (m_checkPending) {
+        m_checkPending = false;
+        checkNow();
+        return;
+    }
+    // session 啟動時才建立的路徑，這時可能已經出現
+    updateWatches();
+    scheduleNextCheck();
+}
+
+void WaydroidSessionMonitor::scheduleNextCheck()
+{
+    // watch 模式只留一個低頻的保底確認（例如 container 異常結束沒有動到檔案）
+    m_poll.start(mode() == QLatin1String("watch") ? MaxPollMs : m_pollIntervalMs);
+}
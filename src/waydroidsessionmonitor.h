@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+/**
+ * WaydroidSessionMonitor
+ *
+ * 監看 Waydroid session / container 是否在執行（QML 中以 Waydroid.monitor 取得）。
+ * 原本每 3 秒 fork 一次 `waydroid status`（Python CLI），在 CPU 有限的車機上一直佔著資源；
+ * 現在改成事件驅動：
+ *
+ * - watch 模式：以 QFileSystemWatcher（inotify）監看 Waydroid 的狀態檔 / 目錄
+ *   （預設 /var/lib/waydroid、session.cfg、lxc/waydroid），有變動時 debounce 後才跑一次
+ *   `waydroid status` 確認（不同版本的檔案格式不同，所以不直接解析檔案）；另外每 60 秒保底確認一次
+ * - poll 模式：上述路徑都不存在時退回輪詢，狀態沒變就把間隔加倍（3 秒 → 最多 60 秒），
+ *   狀態一變回到 3 秒；每次輪詢後也會重試加入監看，路徑出現就切回 watch 模式
+ *
+ * statusSpawns 是實際 fork 的次數，spawnsAvoided 是與舊的固定 3 秒輪詢相比省下的次數。
+ *
+ * 環境變數：SMART_DASHBOARD_WAYDROID_WATCH（以 ':' 分隔的監看路徑，覆蓋預設）、
+ * SMART_DASHBOARD_WAYDROID_BIN（waydroid 執行檔，可換成 scripts/fake-waydroid.sh 測試）。
+ */
+class WaydroidSessionMonitor : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(QString mode READ mode NOTIFY modeChanged)
+    Q_PROPERTY(QStringList watchedPaths READ watchedPaths NOTIFY modeChanged)
+    Q_PROPERTY(int pollIntervalMs READ pollIntervalMs NOTIFY statsChanged)
+    Q_PROPERTY(int statusSpawns READ statusSpawns NOTIFY statsChanged)
+    Q_PROPERTY(int spawnsAvoided READ spawnsAvoided NOTIFY statsChanged)
+
+public:
+    static constexpr int LegacyPollMs = 3000;    // 舊版固定輪詢間隔（計算 spawnsAvoided 的基準）
+    static constexpr int MinPollMs = 3000;
+    static constexpr int MaxPollMs = 60000;
+    static constexpr int DebounceMs = 250;       // 一次啟動 / 停止會連續改好幾個檔案
+
+    static QString waydroidProgram();
+    static QStringList defaultWatchPaths();
+    // `waydroid status` 的輸出是否表示正在執行
+    static bool parseStatus(const QString &output);
+
+    explicit WaydroidSessionMonitor(QObject *parent = nullptr);
+
+    bool running() const { return m_running; }
+    QString mode() const;
+    QStringList watchedPaths() const;
+    int pollIntervalMs() const { return m_pollIntervalMs; }
+    int statusSpawns() const { return m_statusSpawns; }
+    int spawnsAvoided() const;
+
+    // 立即確認一次（已有 `waydroid status` 在跑時，等它結束後再跑一次）
+    Q_INVOKABLE void checkNow();
+
+signals:
+    void runningChanged();
+    // 每次 `waydroid status` 結束（包括狀態沒變、啟動失敗）
+    void checkFinished(bool running);
+    void modeChanged();
+    void statsChanged();
+
+private:
+    void onWatchEvent(const QString &path);
+    void updateWatches();
+    void finishCheck(bool running);
+    void scheduleNextCheck();
+
+    QStringList m_paths;
+    QStringList m_lastWatched;
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounce;
+    QTimer m_poll;
+    QElapsedTimer m_uptime;
+    QPointer<QProcess> m_process;
+    bool m_running = false;
+    bool m_checkPending = false;
+    int m_pollIntervalMs = MinPollMs;
+    int m_statusSpawns = 0;
+};
@@ -6,22 +6,25 @@
 #include <QtWaylandCompositor/QWaylandXdgToplevel>
 #include <QtWaylandCompositor/QWaylandXdgSurface>
 #include <QtWaylandCompositor/QWaylandSurface>
+#include <QtWaylandCompositor/QWaylandClient>
 #include <QtWaylandCompositor/QWaylandWlShell>
 #include <QtWaylandCompositor/QWaylandWlShellSurface>
 #include <QObject>
+#include <QPointer>
 #include <QHash>
 #include <QList>
 #include <QString>
 #include <QVariant>
 #include <QVariantList>
 #include <QSize>
-#include <QTimer>
 #include <QDebug>
 #include <QStandardPaths>
 #include <QDir>
 #include <QFileInfo>
 #include <QWindow>
 
+#include "packagesurfacematcher.h"
+
 /**
  * DashboardWaylandCompositor
  * 
@@ -64,6 +67,13 @@ public:
         connect(m_xdgShell, &QWaylandXdgShell::toplevelCreated, this,
                 &DashboardWaylandCompositor::onXdgToplevelCreated);
         
+        // 包名 ↔ 表面（app_id 索引，標題只作後備）
+        m_matcher = new PackageSurfaceMatcher(this);
+        connect(m_matcher, &PackageSurfaceMatcher::surfaceMatched, this,
+                [this](const QString &packageName, QObject *surface) {
+            emit surfaceMatchedToPackage(packageName, static_cast<QWaylandSurface *>(surface));
+        });
+        
         // 創建 WL Shell（舊版 Wayland 應用使用）
         m_wlShell = new QWaylandWlShell(this);
         // 注意：QWaylandWlShell 可能沒有 shellSurfaceCreated 信號
@@ -173,69 +183,17 @@ public:
     // 註冊包名與表面的映射關係（當應用啟動時調用）
     Q_INVOKABLE void registerPackageSurface(const QString &packageName, QWaylandSurface *surface) {
         if (surface) {
-            m_packageToSurface[packageName] = surface;
+            m_matcher->registerSurface(packageName, surface);
             qDebug() << "DashboardWaylandCompositor: Registered surface for package" << packageName;
         }
     }
     
-    // 根據包名查找對應的表面（如果還沒找到，會等待表面創建）
+    // 根據包名查找對應的表面（如果還沒找到，登記為等待中的啟動，表面出現時發出 surfaceMatchedToPackage）
     Q_INVOKABLE QWaylandSurface* findSurfaceByPackage(const QString &packageName) {
-        qDebug() << "========================================";
-        qDebug() << "🔍 DashboardWaylandCompositor: Finding surface for package:" << packageName;
-        
-        // 首先檢查已註冊的映射
-        if (m_packageToSurface.contains(packageName)) {
-            QWaylandSurface *surface = m_packageToSurface[packageName];
-            if (surface && hasSurfaceContent(surface)) {
-                qDebug() << "✅ Found surface in registered mapping";
-                return surface;
-            }
-        }
-        
-        // 如果沒有找到，添加到待匹配列表
-        if (!m_pendingPackages.contains(packageName)) {
-            m_pendingPackages.append(packageName);
-            qDebug() << "📝 Added package to pending list:" << packageName;
-            qDebug() << "   Pending packages:" << m_pendingPackages;
-        }
-        
-        // 嘗試立即匹配（如果表面已經存在）
-        QString searchTerm = packageName;
-        if (packageName.contains('.')) {
-            QStringList parts = packageName.split('.');
-            if (!parts.isEmpty()) {
-                searchTerm = parts.last();
-            }
-        }
-        qDebug() << "   Search term:" << searchTerm;
-        qDebug() << "   Total surfaces:" << m_surfaces.size();
-        qDebug() << "   XDG surfaces:" << m_xdgSurfaces.size();
-        
-        for (auto *surface : m_surfaces) {
-            if (!hasSurfaceContent(surface)) {
-                qDebug() << "   Skipping surface (no content)";
-                continue;
-            }
-            
-            // 檢查 XDG Surface
-            for (auto *xdgSurface : m_xdgSurfaces) {
-                if (xdgSurface->surface() == surface && xdgSurface->toplevel()) {
-                    QString title = xdgSurface->toplevel()->title();
-                    qDebug() << "   Checking XDG Surface, title:" << title;
-                    if (title.contains(searchTerm, Qt::CaseInsensitive) || 
-                        title.contains(packageName, Qt::CaseInsensitive)) {
-                        qDebug() << "✅ Matched XDG Surface to package:" << packageName;
-                        m_packageToSurface[packageName] = surface;
-                        m_pendingPackages.removeAll(packageName);
-                        return surface;
-                    }
-                }
-            }
-        }
-        
-        qDebug() << "⏳ No surface found yet, waiting for surface creation...";
-        qDebug() << "========================================";
-        return nullptr; // 還沒找到，等待表面創建
+        auto *surface = static_cast<QWaylandSurface *>(m_matcher->expectLaunch(packageName));
+        qDebug() << "🔍 DashboardWaylandCompositor: Finding surface for package:" << packageName
+                 << (surface ? "found" : "pending");
+        return surface;
     }
     
     // 獲取所有已映射的表面
@@ -270,73 +228,47 @@ private slots:
             m_surfaces.removeAll(surface);
         });
         
-        // 使用定時器定期檢查表面是否有內容
-        // 當表面有內容時，觸發 mapped 信號
-        QTimer *checkTimer = new QTimer(this);
-        checkTimer->setSingleShot(false);
-        checkTimer->setInterval(100); // 每 100ms 檢查一次
-        int checkCount = 0;
-        connect(checkTimer, &QTimer::timeout, this, [this, surface, checkTimer, &checkCount]() {
-            checkCount++;
-            bool hasContent = hasSurfaceContent(surface);
-            qDebug() << "   Checking surface content (attempt" << checkCount << "):" << hasContent;
-            
-            if (hasContent) {
-                qDebug() << "🟢 DashboardWaylandCompositor: Surface mapped (has content)";
-                emit surfaceMapped(surface);
-                checkTimer->stop();
-                checkTimer->deleteLater();
-                
-                // 嘗試匹配到待匹配的包名
-                if (!m_pendingPackages.isEmpty()) {
-                    qDebug() << "   Trying to match surface to pending packages:" << m_pendingPackages;
-                    // 檢查是否有 XDG Surface 關聯
-                    for (auto *xdgSurface : m_xdgSurfaces) {
-                        if (xdgSurface->surface() == surface && xdgSurface->toplevel()) {
-                            QString title = xdgSurface->toplevel()->title();
-                            qDebug() << "   XDG Surface title:" << title;
-                            matchSurfaceToPackage(surface, title);
-                        }
-                    }
-                }
-            } else if (checkCount > 50) {
-                // 10 秒後停止檢查
-                qDebug() << "   Surface check timeout after 10 seconds";
-                checkTimer->stop();
-                checkTimer->deleteLater();
-            }
+        // 由 hasContentChanged 驅動（client commit 第一個 buffer 時發出），不再每 100ms 輪詢
+        connect(surface, &QWaylandSurface::hasContentChanged, this, [this, surface]() {
+            if (hasSurfaceContent(surface))
+                onSurfaceMapped(surface);
+            else
+                emit surfaceUnmapped(surface);
         });
-        checkTimer->start();
-        
-        // 如果表面已經有內容，立即觸發 mapped 信號
         if (hasSurfaceContent(surface)) {
-            checkTimer->stop();
-            checkTimer->deleteLater();
             qDebug() << "🟢 DashboardWaylandCompositor: Surface already has content";
-            QTimer::singleShot(0, this, [this, surface]() {
-                emit surfaceMapped(surface);
-            });
+            onSurfaceMapped(surface);
         }
         
         emit surfaceCreated(surface);
         qDebug() << "========================================";
     }
     
+    void onSurfaceMapped(QWaylandSurface *surface) {
+        qDebug() << "🟢 DashboardWaylandCompositor: Surface mapped (has content)";
+        emit surfaceMapped(surface);
+    }
+    
     void onXdgToplevelCreated(QWaylandXdgToplevel *toplevel, QWaylandXdgSurface *xdgSurface) {
         qDebug() << "DashboardWaylandCompositor: XDG Toplevel created";
         // 可以從 toplevel 獲取應用信息
         if (toplevel && xdgSurface) {
             m_xdgSurfaces.append(xdgSurface);
-            connect(toplevel, &QWaylandXdgToplevel::titleChanged, this, [this, toplevel, xdgSurface]() {
-                QString title = toplevel->title();
-                qDebug() << "DashboardWaylandCompositor: XDG Toplevel title:" << title;
-                // 嘗試根據標題匹配包名
-                matchSurfaceToPackage(xdgSurface->surface(), title);
+            QWaylandSurface *surface = xdgSurface->surface();
+            const qint64 pid = surface && surface->client() ? surface->client()->processId() : 0;
+            const QPointer<QWaylandXdgToplevel> guard(toplevel);
+            // app_id / 標題改變時重新交給 matcher（app_id 優先，標題只在沒有 app_id 時使用）
+            auto offer = [this, guard, surface, pid]() {
+                if (guard)
+                    m_matcher->offerSurface(surface, guard->appId(), guard->title(), pid);
+            };
+            connect(toplevel, &QWaylandXdgToplevel::appIdChanged, this, offer);
+            connect(toplevel, &QWaylandXdgToplevel::titleChanged, this, offer);
+            connect(xdgSurface, &QObject::destroyed, this, [this, xdgSurface, surface]() {
+                m_xdgSurfaces.removeAll(xdgSurface);
+                m_matcher->removeSurface(surface);
             });
-            // 立即檢查標題
-            if (!toplevel->title().isEmpty()) {
-                matchSurfaceToPackage(xdgSurface->surface(), toplevel->title());
-            }
+            offer();
         }
     }
     
@@ -344,32 +276,6 @@ private slots:
     // 我們通過其他方式處理 WL Shell 表面
     // 如果需要，可以在 onSurfaceCreated 中檢查表面類型
     
-    // 嘗試將表面匹配到包名
-    void matchSurfaceToPackage(QWaylandSurface *surface, const QString &title) {
-        // 遍歷所有等待匹配的包名
-        for (auto it = m_pendingPackages.begin(); it != m_pendingPackages.end();) {
-            const QString &packageName = *it;
-            QString searchTerm = packageName;
-            if (packageName.contains('.')) {
-                QStringList parts = packageName.split('.');
-                if (!parts.isEmpty()) {
-                    searchTerm = parts.last();
-                }
-            }
-            
-            // 檢查標題是否匹配
-            if (title.contains(searchTerm, Qt::CaseInsensitive) || 
-                title.contains(packageName, Qt::CaseInsensitive)) {
-                m_packageToSurface[packageName] = surface;
-                qDebug() << "DashboardWaylandCompositor: Matched surface to package" << packageName;
-                it = m_pendingPackages.erase(it);
-                emit surfaceMatchedToPackage(packageName, surface);
-            } else {
-                ++it;
-            }
-        }
-    }
-
     // 檢查表面是否有內容（替代 isMapped）
     bool hasSurfaceContent(QWaylandSurface *surface) const {
         if (!surface) return false;
@@ -384,7 +290,6 @@ private:
     QWaylandOutput *m_output = nullptr; // Output 必需，compositor 需要它來創建 socket
     QList<QWaylandSurface*> m_surfaces;
     QList<QWaylandXdgSurface*> m_xdgSurfaces;
-    QHash<QString, QWaylandSurface*> m_packageToSurface; // 包名到表面的映射
-    QStringList m_pendingPackages; // 等待匹配的包名列表
+    PackageSurfaceMatcher *m_matcher = nullptr; // 包名到表面的映射與等待匹配的啟動
 };
 
@@ -2,9 +2,24 @@
 
 #include <QDebug>
 
+#include <QtWaylandCompositor/QWaylandClient>
+#include <QtWaylandCompositor/QWaylandSurface>
+
 XdgShellHelper::XdgShellHelper(QObject *parent)
     : QObject(parent)
+    , m_surfaces(new SurfaceRegistry(this))
+    , m_launchTracker(new SurfaceLaunchTracker(this))
+    , m_packageMatcher(new PackageSurfaceMatcher(this))
+    , m_placement(new OutputPlacement(m_surfaces, this))
+    , m_configurator(new ToplevelConfigurator(m_placement, this))
+    , m_frameThrottler(new FrameCallbackThrottler(m_surfaces, m_configurator, m_placement, this))
+    , m_clientStats(new ClientFrameStats(m_surfaces, this))
+    , m_snapshots(new SurfaceSnapshotCache(m_packageMatcher, this))
 {
+    // 換到背景的 app 在還顯示最後一幀時拍快照
+    connect(m_frameThrottler, &FrameCallbackThrottler::foregroundSurfaceChanged, m_snapshots, [this] {
+        m_snapshots->setForegroundSurface(qobject_cast<QWaylandSurface *>(m_frameThrottler->foregroundSurface()));
+    });
 }
 
 void XdgShellHelper::setCompositor(QObject *comp)
@@ -12,7 +27,9 @@ void XdgShellHelper::setCompositor(QObject *comp)
     if (m_waylandCompositor == comp)
         return;
 
-    // 先清掉舊的 xdgShell
+    // 先清掉舊的 xdgShell 與對舊 compositor 的連線
+    if (m_waylandCompositor)
+        m_waylandCompositor->disconnect(this);
     if (m_xdgShell) {
         m_xdgShell->deleteLater();
         m_xdgShell.clear();
@@ -24,6 +41,8 @@ void XdgShellHelper::setCompositor(QObject *comp)
     }
 
     m_waylandCompositor = qobject_cast<QWaylandCompositor *>(comp);
+    m_frameThrottler->setCompositor(m_waylandCompositor);
+    m_clientStats->setCompositor(m_waylandCompositor);
     if (!m_waylandCompositor) {
         qWarning() << "XdgShellHelper: compositor 不是 QWaylandCompositor 實例";
         emit compositorChanged();
@@ -51,11 +70,26 @@ void XdgShellHelper::setCompositor(QObject *comp)
     // 在現有 compositor 上建立 QWaylandXdgShell 擴充
     m_xdgShell = new QWaylandXdgShell(m_waylandCompositor);
 
-    // 輸出 debug 訊息幫助確認
+    // surface 清單：建立時就登記索引，成為 xdg toplevel 時才佔列
+    QObject::connect(m_waylandCompositor, &QWaylandCompositor::surfaceCreated,
+                     m_surfaces, &SurfaceRegistry::addSurface);
+    QObject::connect(m_waylandCompositor, &QWaylandCompositor::surfaceCreated,
+                     m_launchTracker, &SurfaceLaunchTracker::surfaceCreated);
+    QObject::connect(m_waylandCompositor, &QWaylandCompositor::surfaceCreated,
+                     m_clientStats, &ClientFrameStats::addSurface);
     QObject::connect(m_xdgShell, &QWaylandXdgShell::toplevelCreated,
-                     this, [](QWaylandXdgToplevel *toplevel, QWaylandXdgSurface *xdgSurface) {
-        Q_UNUSED(toplevel);
+                     this, [this](QWaylandXdgToplevel *toplevel, QWaylandXdgSurface *xdgSurface) {
         qInfo() << "XdgShellHelper: xdg toplevel created for surface" << xdgSurface;
+        // 先交給 configurator，registry 插入這一列會讓 throttler 接著設定 activated
+        m_configurator->addToplevel(xdgSurface->surface(), toplevel);
+        m_surfaces->setToplevel(xdgSurface->surface(), toplevel);
+        m_launchTracker->toplevelCreated(xdgSurface->surface(), toplevel);
+        trackToplevel(toplevel, xdgSurface->surface());
+    });
+    QObject::connect(m_xdgShell, &QWaylandXdgShell::popupCreated,
+                     this, [this](QWaylandXdgPopup *popup, QWaylandXdgSurface *xdgSurface) {
+        QWaylandXdgSurface *parent = popup->parentXdgSurface();
+        m_surfaces->markPopup(xdgSurface->surface(), parent ? parent->surface() : nullptr);
     });
 
     qInfo() << "XdgShellHelper: XDG Shell 已啟用";
@@ -63,3 +97,45 @@ void XdgShellHelper::setCompositor(QObject *comp)
     emit seatChanged();
 }
 
+
+void XdgShellHelper::setEmbedSize(const QSizeF &size)
+{
+    if (m_embedSize == size)
+        return;
+    m_embedSize = size;
+    emit embedSizeChanged();
+    m_configurator->requestTargetSize(size.toSize(), OutputPlacement::clusterOutput());
+}
+
+void XdgShellHelper::setOutputEmbedSize(const QString &output, const QSizeF &size)
+{
+    m_configurator->requestTargetSize(size.toSize(), output);
+}
+
+void XdgShellHelper::setOutputs(const QJsonArray &outputs)
+{
+    if (m_placement->outputs() == outputs)
+        return;
+    m_placement->setOutputs(outputs);
+    emit outputsChanged();
+}
+
+void XdgShellHelper::trackToplevel(QWaylandXdgToplevel *toplevel, QWaylandSurface *surface)
+{
+    if (!toplevel || !surface)
+        return;
+
+    // app_id 通常在第一次 commit 前才送來，所以建立時與之後改變時都要交給 matcher
+    const qint64 pid = surface->client() ? surface->client()->processId() : 0;
+    const QPointer<QWaylandXdgToplevel> guard(toplevel);
+    auto offer = [this, guard, surface, pid] {
+        if (guard)
+            m_packageMatcher->offerSurface(surface, guard->appId(), guard->title(), pid);
+    };
+    QObject::connect(toplevel, &QWaylandXdgToplevel::appIdChanged, m_packageMatcher, offer);
+    QObject::connect(toplevel, &QWaylandXdgToplevel::titleChanged, m_packageMatcher, offer);
+    QObject::connect(surface, &QWaylandSurface::surfaceDestroyed, m_packageMatcher, [this, surface] {
+        m_packageMatcher->removeSurface(surface);
+    });
+    offer();
+}
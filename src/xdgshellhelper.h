@@ -3,13 +3,24 @@
 
 #pragma once
 
+#include <QJsonArray>
 #include <QObject>
 #include <QPointer>
+#include <QSizeF>
 
 #include <QtWaylandCompositor/QWaylandCompositor>
 #include <QtWaylandCompositor/QWaylandSeat>
 #include <QtWaylandCompositor/QWaylandXdgShell>
 
+#include "clientframestats.h"
+#include "framecallbackthrottler.h"
+#include "outputplacement.h"
+#include "packagesurfacematcher.h"
+#include "surfacelaunchtracker.h"
+#include "surfaceregistry.h"
+#include "surfacesnapshotcache.h"
+#include "toplevelconfigurator.h"
+
 // 簡單的 C++ 幫手：在現有的 QML WaylandCompositor 上啟用 xdg-shell
 // 用法（在 QML 中）：
 //
@@ -30,6 +41,24 @@ class XdgShellHelper : public QObject
     Q_PROPERTY(QObject *compositor READ compositor WRITE setCompositor NOTIFY compositorChanged)
     // 由 C++ 建立的 seat（QML 端不可 creatable 的 WaylandSeat，會在某些 Qt build 直接報錯）
     Q_PROPERTY(QObject *seat READ seat NOTIFY seatChanged)
+    // compositor 上所有 surface 的清單（appArea 的 Repeater model）
+    Q_PROPERTY(SurfaceRegistry *surfaces READ surfaces CONSTANT)
+    // 啟動 → 第一幀的各階段延遲
+    Q_PROPERTY(SurfaceLaunchTracker *launchTracker READ launchTracker CONSTANT)
+    // 包名 ↔ surface（以 xdg_toplevel app_id 為主）
+    Q_PROPERTY(PackageSurfaceMatcher *packageMatcher READ packageMatcher CONSTANT)
+    // 被蓋住 / 不可見的 surface 降低 frame callback 頻率
+    Q_PROPERTY(FrameCallbackThrottler *frameThrottler READ frameThrottler CONSTANT)
+    // 多螢幕：config.json 的 outputs（哪些 app 顯示在哪個 output）
+    Q_PROPERTY(QJsonArray outputs READ outputs WRITE setOutputs NOTIFY outputsChanged)
+    Q_PROPERTY(OutputPlacement *placement READ placement CONSTANT)
+    // cluster 嵌入區域大小（邏輯像素），透過 xdg configure 告訴 client 以這個大小畫
+    Q_PROPERTY(QSizeF embedSize READ embedSize WRITE setEmbedSize NOTIFY embedSizeChanged)
+    Q_PROPERTY(ToplevelConfigurator *configurator READ configurator CONSTANT)
+    // 每個 app 最後一幀的縮小快照（切換 app 時先顯示）
+    Q_PROPERTY(SurfaceSnapshotCache *snapshots READ snapshots CONSTANT)
+    // 逐 client 的 commit 頻率 / 被取代的 buffer / commit → 上畫面延遲（並提供 wp_presentation）
+    Q_PROPERTY(ClientFrameStats *clientStats READ clientStats CONSTANT)
 
 public:
     explicit XdgShellHelper(QObject *parent = nullptr);
@@ -37,14 +66,41 @@ public:
     QObject *compositor() const { return m_waylandCompositor; }
     void setCompositor(QObject *comp);
     QObject *seat() const { return m_seat; }
+    SurfaceRegistry *surfaces() const { return m_surfaces; }
+    SurfaceLaunchTracker *launchTracker() const { return m_launchTracker; }
+    PackageSurfaceMatcher *packageMatcher() const { return m_packageMatcher; }
+    FrameCallbackThrottler *frameThrottler() const { return m_frameThrottler; }
+    ToplevelConfigurator *configurator() const { return m_configurator; }
+    ClientFrameStats *clientStats() const { return m_clientStats; }
+    SurfaceSnapshotCache *snapshots() const { return m_snapshots; }
+    OutputPlacement *placement() const { return m_placement; }
+    QJsonArray outputs() const { return m_placement->outputs(); }
+    void setOutputs(const QJsonArray &outputs);
+    QSizeF embedSize() const { return m_embedSize; }
+    void setEmbedSize(const QSizeF &size);
+    // 其他 output（例如 center）的嵌入區域大小
+    Q_INVOKABLE void setOutputEmbedSize(const QString &output, const QSizeF &size);
 
 signals:
     void compositorChanged();
     void seatChanged();
+    void embedSizeChanged();
+    void outputsChanged();
 
 private:
+    void trackToplevel(QWaylandXdgToplevel *toplevel, QWaylandSurface *surface);
+
     QPointer<QWaylandCompositor> m_waylandCompositor;
     QPointer<QWaylandXdgShell> m_xdgShell;
     QPointer<QWaylandSeat> m_seat;
+    SurfaceRegistry *m_surfaces = nullptr;
+    SurfaceLaunchTracker *m_launchTracker = nullptr;
+    PackageSurfaceMatcher *m_packageMatcher = nullptr;
+    OutputPlacement *m_placement = nullptr;
+    ToplevelConfigurator *m_configurator = nullptr;
+    FrameCallbackThrottler *m_frameThrottler = nullptr;
+    ClientFrameStats *m_clientStats = nullptr;
+    SurfaceSnapshotCache *m_snapshots = nullptr;
+    QSizeF m_embedSize;
 };
 
@@ -0,0 +1,132 @@
+// AppsModel::setApps 的增量更新：只發出必要的 remove / move / insert / dataChanged，
+// 結果必須和輸入（去重後）一致。QAbstractItemModelTester 同時檢查每個訊號前後 model 的一致性。
+
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "appsmodel.h"
+
+namespace {
+
+QVector<AppEntry> entries(const QStringList &packages)
+{
+    QVector<AppEntry> apps;
+    for (const QString &package : packages)
+        apps.push_back(AppEntry{package.toUpper(), package});
+    return apps;
+}
+
+QStringList packagesOf(const AppsModel &model)
+{
+    QStringList packages;
+    for (int row = 0; row < model.rowCount(); ++row)
+        packages << model.data(model.index(row), AppsModel::PackageRole).toString();
+    return packages;
+}
+
+} // namespace
+
+class TestAppsModel : public QObject {
+    Q_OBJECT
+
+private slots:
+    void reorderOnlyMoves()
+    {
+        AppsModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        model.setApps(entries({"a", "b", "c", "d"}));
+
+        QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+        QSignalSpy count(&model, &AppsModel::countChanged);
+        model.setApps(entries({"d", "a", "c", "b"}));
+
+        QCOMPARE(packagesOf(model), QStringList({"d", "a", "c", "b"}));
+        QCOMPARE(inserted.count(), 0);
+        QCOMPARE(removed.count(), 0);
+        QVERIFY(moved.count() > 0);
+        QCOMPARE(count.count(), 0);
+    }
+
+    void renameOnlyChangesLabel()
+    {
+        AppsModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        model.setApps(entries({"a", "b"}));
+
+        QVector<AppEntry> renamed = entries({"a", "b"});
+        renamed[1].label = QStringLiteral("Browser");
+        QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+        model.setApps(renamed);
+
+        QCOMPARE(model.data(model.index(1), AppsModel::LabelRole).toString(), QStringLiteral("Browser"));
+        QCOMPARE(inserted.count(), 0);
+        QCOMPARE(removed.count(), 0);
+        QCOMPARE(changed.count(), 1);
+        QCOMPARE(changed.at(0).at(0).toModelIndex().row(), 1);
+        QCOMPARE(changed.at(0).at(2).value<QList<int>>(), QList<int>({AppsModel::LabelRole}));
+    }
+
+    void mixedInsertRemoveMove()
+    {
+        AppsModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        model.setApps(entries({"a", "b", "c", "d", "e"}));
+        model.setApps(entries({"f", "d", "b", "g"}));
+        QCOMPARE(packagesOf(model), QStringList({"f", "d", "b", "g"}));
+        QCOMPARE(model.apps(), entries({"f", "d", "b", "g"}));
+    }
+
+    void duplicatesKeepFirst()
+    {
+        AppsModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        QVector<AppEntry> apps = entries({"a", "b", "a", "c", "b"});
+        apps[2].label = QStringLiteral("second a");
+        model.setApps(apps);
+        QCOMPARE(packagesOf(model), QStringList({"a", "b", "c"}));
+        QCOMPARE(model.data(model.index(0), AppsModel::LabelRole).toString(), QStringLiteral("A"));
+
+        model.setApps(entries({"c", "c", "a"}));
+        QCOMPARE(packagesOf(model), QStringList({"c", "a"}));
+    }
+
+    void emptyInput()
+    {
+        AppsModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+
+        // 空 → 空：什麼都不發
+        QSignalSpy count(&model, &AppsModel::countChanged);
+        QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+        model.setApps({});
+        QCOMPARE(count.count(), 0);
+
+        model.setApps(entries({"a", "b", "c"}));
+        QCOMPARE(count.count(), 1);
+        model.setApps({});
+        QCOMPARE(model.rowCount(), 0);
+        QCOMPARE(count.count(), 2);
+        QCOMPARE(reset.count(), 0);
+    }
+
+    void unchangedEmitsNothing()
+    {
+        AppsModel model;
+        model.setApps(entries({"a", "b", "c"}));
+
+        QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+        QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+        model.setApps(entries({"a", "b", "c"}));
+        QCOMPARE(inserted.count() + removed.count() + moved.count() + changed.count(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestAppsModel)
+#include "tst_appsmodel.moc"
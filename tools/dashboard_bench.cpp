@@ -0,0 +1,492 @@
+// 無頭效能量測：以 offscreen 平台 + software scene graph 載入 DashboardShell.qml，
+// 用合成的車輛訊號驅動儀表，量 N 幀的幀時間百分位數、每幀記憶體配置次數與 CPU 時間。
+// 不需要 GPU 或顯示伺服器，可在 CI 上執行。
+//
+// 用法：
+//   dashboard_bench [--frames 600] [--warmup 120] [--fps 0] [--rate 200]
+//                   [--qml <url>] [--json <檔案>] [--max-frame-p95 <ms>]
+//                   [--clients <n>] [--client-rate 60] [--client-size <WxH>] [--client-damage 100]
+//
+// --fps 0 表示盡快畫（每幀 swap 完立刻要下一幀），否則以固定節奏要求更新。
+// --rate 為每個內建訊號每秒發佈的樣本數（在獨立執行緒上發佈，與實際擷取 worker 相同的路徑）。
+// --max-frame-p95 超過時 exit code 為 2，可直接當 CI 門檻。
+// --clients N 以 compositor 模式載入，並啟動 smartdashboard-wayland-stub 建立 N 個 surface
+// （與本程式同目錄，或以 --client-bin 指定），N 個 surface 都送出第一個 buffer 後才開始 warmup；
+// 結果多了 stub（client 端的 commit / frame callback）、clientStats（ClientFrameStats）與 center（中控 output 的幀計時）。
+// scripts/compositor-throughput.sh 以此逐步增加 surface 數，找出 cluster 幀開始超時的點。
+// 平台 / 後端可用 QT_QPA_PLATFORM / QT_QUICK_BACKEND 覆蓋（預設 offscreen / software；
+// QT_QUICK_BACKEND= 空字串表示用 RHI）。
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QQmlApplicationEngine>
+#include <QQmlContext>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#include "AppConfig.h"
+#include "src/dashboardqml.h"
+#include "src/framestats.h"
+#include "src/vehiclesignalhub.h"
+#include "src/xdgshellhelper.h"
+
+// ---- 配置次數：取代全域 operator new（Qt 函式庫中的 new 也會走到這裡） ----
+// 注意：QString / QList 等 QArrayData 直接呼叫 malloc，不在此計數內
+
+namespace {
+std::atomic<quint64> g_allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+namespace {
+
+// 行程 / 目前執行緒的 CPU 時間（µs）
+qint64 processCpuUs()
+{
+#ifdef Q_OS_UNIX
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return qint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+        + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#else
+    return 0;
+#endif
+}
+
+qint64 threadCpuUs()
+{
+#ifdef Q_OS_UNIX
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else
+    return 0;
+#endif
+}
+
+qint64 wallUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// 合成行車資料（與 smartdashboard-shm-producer 相同的 60 秒循環，但加快 4 倍讓儀表持續在動）
+class SyntheticLoad {
+public:
+    SyntheticLoad(VehicleSignalHub *hub, double rateHz) : m_hub(hub), m_rateHz(rateHz) {}
+    ~SyntheticLoad() { stop(); }
+
+    void start()
+    {
+        if (m_rateHz <= 0.0)
+            return;
+        m_running.store(true);
+        m_thread = std::thread([this] { run(); });
+    }
+
+    void stop()
+    {
+        m_running.store(false);
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    quint64 published() const { return m_published.load(std::memory_order_relaxed); }
+
+private:
+    void run()
+    {
+        using namespace std::chrono;
+        const auto period = duration_cast<steady_clock::duration>(duration<double>(1.0 / m_rateHz));
+        const qint64 startUs = wallUs();
+        auto next = steady_clock::now();
+        double odometerKm = 12345.0;
+
+        while (m_running.load(std::memory_order_relaxed)) {
+            const qint64 nowUs = wallUs();
+            const double t = double(nowUs - startUs) / 1e6 * 4.0;
+            const double phase = std::fmod(t, 60.0) / 60.0;
+            const double speed = std::max(0.0, 120.0 * std::sin(phase * M_PI) + 2.0 * std::sin(t * 7.0));
+            const double rpm = 900.0 + speed * 45.0 + 150.0 * std::sin(t * 13.0);
+            const double fuel = 80.0 - std::fmod(t / 30.0, 60.0);
+            odometerKm += speed / 3600.0 / m_rateHz * 4.0;
+
+            m_hub->publish(VehicleSignalHub::Speed, speed, nowUs);
+            m_hub->publish(VehicleSignalHub::Rpm, rpm, nowUs);
+            m_hub->publish(VehicleSignalHub::FuelLevel, fuel, nowUs);
+            m_hub->publish(VehicleSignalHub::Odometer, odometerKm, nowUs);
+            m_published.fetch_add(4, std::memory_order_relaxed);
+
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    VehicleSignalHub *m_hub;
+    double m_rateHz;
+    std::atomic<bool> m_running{false};
+    std::atomic<quint64> m_published{0};
+    std::thread m_thread;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 必須在 QGuiApplication 之前設定；使用者已指定的平台 / 後端不覆蓋
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    // QT_QUICK_BACKEND 設為空字串時用預設的 RHI 後端
+    if (!qEnvironmentVariableIsSet("QT_QUICK_BACKEND"))
+        qputenv("QT_QUICK_BACKEND", "software");
+    // requestUpdate() 預設會延遲 5 ms，盡快畫時要關掉
+    if (qEnvironmentVariableIsEmpty("QT_QPA_UPDATE_IDLE_TIME"))
+        qputenv("QT_QPA_UPDATE_IDLE_TIME", "0");
+
+    // DashboardShell 內的 WaylandCompositor 會開 socket：放在私有目錄，不和正在執行的儀表衝突
+    QTemporaryDir runtimeDir;
+    if (runtimeDir.isValid())
+        qputenv("XDG_RUNTIME_DIR", runtimeDir.path().toUtf8());
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("dashboard_bench"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Headless DashboardShell frame-time benchmark"));
+    parser.addHelpOption();
+    const QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Measured frames."),
+                                          QStringLiteral("n"), QStringLiteral("600"));
+    const QCommandLineOption warmupOption(QStringLiteral("warmup"), QStringLiteral("Frames before measuring."),
+                                          QStringLiteral("n"), QStringLiteral("120"));
+    const QCommandLineOption fpsOption(QStringLiteral("fps"), QStringLiteral("Fixed frame rate, 0 = as fast as possible."),
+                                       QStringLiteral("hz"), QStringLiteral("0"));
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Samples per second per signal."),
+                                        QStringLiteral("hz"), QStringLiteral("200"));
+    const QCommandLineOption qmlOption(QStringLiteral("qml"), QStringLiteral("QML file to load."),
+                                       QStringLiteral("url"), QStringLiteral("qrc:/qt/qml/SmartDashboard/qml/DashboardShell.qml"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"), QStringLiteral("Write results as JSON."),
+                                        QStringLiteral("file"));
+    const QCommandLineOption maxP95Option(QStringLiteral("max-frame-p95"), QStringLiteral("Fail (exit 2) above this frame p95."),
+                                          QStringLiteral("ms"));
+    const QCommandLineOption clientsOption(QStringLiteral("clients"), QStringLiteral("Stub Wayland surfaces (0 = none)."),
+                                           QStringLiteral("n"), QStringLiteral("0"));
+    const QCommandLineOption clientRateOption(QStringLiteral("client-rate"),
+                                              QStringLiteral("Stub commits per second, 0 = frame callback driven."),
+                                              QStringLiteral("hz"), QStringLiteral("60"));
+    const QCommandLineOption clientSizeOption(QStringLiteral("client-size"),
+                                              QStringLiteral("Stub buffer size, default = configured size."),
+                                              QStringLiteral("WxH"));
+    const QCommandLineOption clientDamageOption(QStringLiteral("client-damage"),
+                                                QStringLiteral("Percent of each stub frame that changes."),
+                                                QStringLiteral("percent"), QStringLiteral("100"));
+    const QCommandLineOption clientBinOption(QStringLiteral("client-bin"), QStringLiteral("Stub client executable."),
+                                             QStringLiteral("path"));
+    parser.addOptions({framesOption, warmupOption, fpsOption, rateOption, qmlOption, jsonOption, maxP95Option,
+                       clientsOption, clientRateOption, clientSizeOption, clientDamageOption, clientBinOption});
+    parser.process(app);
+
+    const quint64 measuredFrames = qMax(1, parser.value(framesOption).toInt());
+    const quint64 warmupFrames = qMax(0, parser.value(warmupOption).toInt());
+    const double fps = parser.value(fpsOption).toDouble();
+    const double rateHz = parser.value(rateOption).toDouble();
+    const int clients = qMax(0, parser.value(clientsOption).toInt());
+
+    AppConfig config;
+    if (!config.loadFromFile(QStringLiteral(":/assets/config.json")))
+        qWarning() << "dashboard_bench: config.json not found, running without signal policies";
+
+    VehicleSignalHub vehicleSignals;
+    DashboardQml::applySignalPolicies(config, &vehicleSignals);
+
+    FrameStats frameStats;
+    FrameStats centerFrameStats;
+    centerFrameStats.setOutputName(QStringLiteral("center"));
+
+    // 與 main.cpp 相同的 context property 與型別（DashboardQml）。Waydroid 為 null：
+    // 主機上快取的 app 清單會改變版面（顯示 dock、隱藏 ODO），量測結果就不能互相比較
+    QQmlApplicationEngine engine;
+    DashboardQml::Context qmlContext;
+    qmlContext.config = &config;
+    qmlContext.vehicleSignals = &vehicleSignals;
+    qmlContext.frameStats = &frameStats;
+    qmlContext.centerFrameStats = &centerFrameStats;
+    // 有 stub client 時才需要 compositor 模式（appArea 顯示 surface）
+    qmlContext.compositorMode = clients > 0;
+    DashboardQml::setContextProperties(engine.rootContext(), qmlContext);
+    DashboardQml::registerTypes();
+
+    engine.load(QUrl(parser.value(qmlOption)));
+    QQuickWindow *window = engine.rootObjects().isEmpty()
+        ? nullptr : qobject_cast<QQuickWindow *>(engine.rootObjects().first());
+    if (!window) {
+        std::fprintf(stderr, "dashboard_bench: cannot load %s as a window\n", qPrintable(parser.value(qmlOption)));
+        return 1;
+    }
+    vehicleSignals.attachWindow(window);
+    frameStats.attachWindow(window);
+
+    SyntheticLoad load(&vehicleSignals, rateHz);
+
+    // stub client 連到 DashboardShell 的 socket（XDG_RUNTIME_DIR 已是上面的私有目錄）
+    XdgShellHelper *shellHelper = window->findChild<XdgShellHelper *>();
+    QProcess stub;
+    const QString stubJsonPath = runtimeDir.filePath(QStringLiteral("stub.json"));
+    if (clients > 0) {
+        if (!shellHelper) {
+            std::fprintf(stderr, "dashboard_bench: %s has no XdgShellHelper, --clients needs DashboardShell\n",
+                         qPrintable(parser.value(qmlOption)));
+            return 1;
+        }
+        QString program = parser.value(clientBinOption);
+        if (program.isEmpty())
+            program = QCoreApplication::applicationDirPath() + QStringLiteral("/smartdashboard-wayland-stub");
+        QStringList arguments = {QStringLiteral("--display"), QStringLiteral("wayland-smartdashboard-0"),
+                                 QStringLiteral("--surfaces"), QString::number(clients),
+                                 QStringLiteral("--rate"), parser.value(clientRateOption),
+                                 QStringLiteral("--damage"), parser.value(clientDamageOption),
+                                 QStringLiteral("--duration"), QStringLiteral("0"),
+                                 QStringLiteral("--json"), stubJsonPath};
+        const QStringList size = parser.value(clientSizeOption).split(QLatin1Char('x'));
+        if (size.size() == 2)
+            arguments << QStringLiteral("--width") << size.at(0) << QStringLiteral("--height") << size.at(1);
+        stub.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        stub.setStandardOutputFile(QProcess::nullDevice());
+        stub.start(program, arguments);
+        if (!stub.waitForStarted()) {
+            std::fprintf(stderr, "dashboard_bench: cannot start %s\n", qPrintable(program));
+            return 1;
+        }
+    }
+
+    quint64 swapped = 0;
+    bool clientsReady = clients == 0;
+    qint64 startWallUs = 0;
+    qint64 startCpuUs = 0;
+    qint64 startThreadCpuUs = 0;
+    quint64 startAllocations = 0;
+    quint64 startPublished = 0;
+    QJsonObject results;
+
+    // warmup 結束（或不需要 warmup 時一開始）：歸零統計，從這裡開始量
+    auto startMeasuring = [&] {
+        frameStats.reset();
+        centerFrameStats.reset();
+        startWallUs = wallUs();
+        startCpuUs = processCpuUs();
+        startThreadCpuUs = threadCpuUs();
+        startAllocations = g_allocations.load();
+        startPublished = load.published();
+    };
+
+    auto finish = [&] {
+        const double frames = double(measuredFrames);
+        const double wallMs = double(wallUs() - startWallUs) / 1000.0;
+        const double cpuPerFrameUs = double(processCpuUs() - startCpuUs) / frames;
+        const double guiCpuPerFrameUs = double(threadCpuUs() - startThreadCpuUs) / frames;
+        const double allocationsPerFrame = double(g_allocations.load() - startAllocations) / frames;
+        const quint64 published = load.published() - startPublished;
+        load.stop();
+
+        results = frameStats.toJson();
+        results.insert(QStringLiteral("frames"), frames);
+        results.insert(QStringLiteral("wallMs"), wallMs);
+        results.insert(QStringLiteral("fps"), wallMs > 0.0 ? frames * 1000.0 / wallMs : 0.0);
+        results.insert(QStringLiteral("cpuPerFrameUs"), cpuPerFrameUs);
+        results.insert(QStringLiteral("guiThreadCpuPerFrameUs"), guiCpuPerFrameUs);
+        results.insert(QStringLiteral("allocationsPerFrame"), allocationsPerFrame);
+        results.insert(QStringLiteral("samplesPublished"), double(published));
+        const QString backend = qEnvironmentVariable("QT_QUICK_BACKEND");
+        results.insert(QStringLiteral("backend"), backend.isEmpty() ? QStringLiteral("rhi") : backend);
+        results.insert(QStringLiteral("platform"), QGuiApplication::platformName());
+        if (clients > 0) {
+            results.insert(QStringLiteral("clientStats"), shellHelper->clientStats()->toJson());
+            results.insert(QStringLiteral("center"), centerFrameStats.toJson());
+            // SIGTERM：stub 寫完 JSON 才結束
+            stub.terminate();
+            stub.waitForFinished(3000);
+            QFile stubJson(stubJsonPath);
+            if (stubJson.open(QIODevice::ReadOnly))
+                results.insert(QStringLiteral("stub"), QJsonDocument::fromJson(stubJson.readAll()).object());
+        }
+        QCoreApplication::quit();
+    };
+
+    // 已經 commit 過 buffer 的 toplevel 數（registry 的列在 toplevel 建立時就有了，還沒有內容）
+    auto mappedSurfaces = [&] {
+        SurfaceRegistry *registry = shellHelper->surfaces();
+        int mapped = 0;
+        for (int row = 0; row < registry->rowCount(); ++row) {
+            if (registry->data(registry->index(row), SurfaceRegistry::MappedRole).toBool())
+                ++mapped;
+        }
+        return mapped;
+    };
+
+    // 每次 swap 完才決定下一幀：warmup 結束時歸零統計，量滿 N 幀後結束
+    QObject::connect(window, &QQuickWindow::frameSwapped, &app, [&] {
+        // 等 stub 的 surface 都出現（toplevel + 第一個 buffer）才開始數
+        if (!clientsReady) {
+            clientsReady = mappedSurfaces() >= clients;
+            if (!clientsReady) {
+                if (fps <= 0.0)
+                    window->requestUpdate();
+                return;
+            }
+            if (warmupFrames == 0)
+                startMeasuring();
+        }
+        ++swapped;
+        if (swapped == warmupFrames) {
+            startMeasuring();
+        } else if (swapped == warmupFrames + measuredFrames) {
+            finish();
+            return;
+        }
+        if (fps <= 0.0)
+            window->requestUpdate();
+    }, Qt::QueuedConnection);
+
+    QTimer cadence;
+    if (fps > 0.0) {
+        cadence.setTimerType(Qt::PreciseTimer);
+        cadence.setInterval(qMax(1, int(std::lround(1000.0 / fps))));
+        QObject::connect(&cadence, &QTimer::timeout, window, &QQuickWindow::update);
+        cadence.start();
+    }
+
+    if (clients > 0) {
+        // stub 提早結束（連不上、protocol error）或 surface 一直沒出現時放棄
+        QObject::connect(&stub, &QProcess::finished, &app, [&] {
+            if (results.isEmpty()) {
+                std::fprintf(stderr, "dashboard_bench: stub client exited (%d)\n", stub.exitCode());
+                QCoreApplication::exit(1);
+            }
+        });
+        QTimer::singleShot(10000, &app, [&] {
+            if (!clientsReady) {
+                std::fprintf(stderr, "dashboard_bench: only %d of %d stub surfaces were mapped\n",
+                             mappedSurfaces(), clients);
+                QCoreApplication::exit(1);
+            }
+        });
+    }
+
+    if (warmupFrames == 0 && clientsReady)
+        startMeasuring();
+    load.start();
+    window->requestUpdate();
+    app.exec();
+    cadence.stop();
+    load.stop();
+
+    if (results.isEmpty()) {
+        std::fprintf(stderr, "dashboard_bench: stopped before %llu frames were rendered\n",
+                     (unsigned long long)measuredFrames);
+        return 1;
+    }
+
+    const QJsonObject frame = results.value("frame").toObject();
+    const QJsonObject sync = results.value("sync").toObject();
+    const QJsonObject render = results.value("render").toObject();
+    std::printf("dashboard_bench: %s / %s, %.0f frames in %.1f ms (%.1f fps)\n",
+                qPrintable(results.value("platform").toString()), qPrintable(results.value("backend").toString()),
+                results.value("frames").toDouble(), results.value("wallMs").toDouble(), results.value("fps").toDouble());
+    std::printf("  %-7s %8s %8s %8s %8s\n", "", "p50", "p95", "p99", "max");
+    for (const auto &[name, stage] : {std::pair{"sync", sync}, std::pair{"render", render}, std::pair{"frame", frame}}) {
+        std::printf("  %-7s %8.2f %8.2f %8.2f %8.2f ms\n", name, stage.value("p50Ms").toDouble(),
+                    stage.value("p95Ms").toDouble(), stage.value("p99Ms").toDouble(), stage.value("maxMs").toDouble());
+    }
+    std::printf("  cpu/frame %.0f us (gui thread %.0f us), allocations/frame %.1f, missed %.0f, samples %.0f\n",
+                results.value("cpuPerFrameUs").toDouble(), results.value("guiThreadCpuPerFrameUs").toDouble(),
+                results.value("allocationsPerFrame").toDouble(), results.value("missedDeadlines").toDouble(),
+                results.value("samplesPublished").toDouble());
+    const QJsonObject repaint = results.value("repaint").toObject();
+    if (!repaint.isEmpty()) {
+        std::printf("  repaint/frame %.1f%% of window (max %.1f%%, %.1f rects), full repaints %.0f\n",
+                    repaint.value("avgPercent").toDouble(), repaint.value("maxPercent").toDouble(),
+                    repaint.value("avgRects").toDouble(), repaint.value("fullRepaints").toDouble());
+    }
+
+    const QJsonArray stubSurfaces = results.value("stub").toObject().value("surfaces").toArray();
+    if (!stubSurfaces.isEmpty()) {
+        double commitRate = 0.0, callbackRate = 0.0, skipped = 0.0;
+        for (const QJsonValue &surface : stubSurfaces) {
+            commitRate += surface.toObject().value("commitRate").toDouble();
+            callbackRate += surface.toObject().value("callbackRate").toDouble();
+            skipped += surface.toObject().value("skipped").toDouble();
+        }
+        std::printf("  stub %lld surface(s): %.1f commits/s, %.1f frame callbacks/s, %.0f skipped (no free buffer)\n",
+                    (long long)stubSurfaces.size(), commitRate, callbackRate, skipped);
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QSaveFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(results).toJson()) < 0 || !file.commit()) {
+            std::fprintf(stderr, "dashboard_bench: cannot write %s\n", qPrintable(parser.value(jsonOption)));
+            return 1;
+        }
+    }
+
+    if (parser.isSet(maxP95Option)) {
+        const double limit = parser.value(maxP95Option).toDouble();
+        if (frame.value("p95Ms").toDouble() > limit) {
+            std::fprintf(stderr, "dashboard_bench: frame p95 %.2f ms exceeds %.2f ms\n",
+                         frame.value("p95Ms").toDouble(), limit);
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+// 訊號 datagram 測試送端（用來在本機驗證 DatagramIngestWorker）
+//
+// 以 src/signaldatagram.h 的格式送出模擬的行車資料（送端 id 0~3 = speed/rpm/fuelLevel/odometer），
+// 每個封包裝 --batch 個時間點 × 4 個訊號。可刻意丟包 / 亂序來檢查接收端的統計。
+//
+// 用法：
+//   smartdashboard-datagram-sender [--udp 127.0.0.1:47800 | --unix /tmp/smart_dashboard.sock]
+//                                  [--rate 200] [--batch 5] [--duration 0]
+//                                  [--drop-every 0] [--swap-every 0]
+//   SMART_DASHBOARD_UDP=127.0.0.1:47800 ./appSmartDashboard
+//
+// --rate 為每秒封包數；--drop-every N 每 N 個封包丟一個；--swap-every N 每 N 個封包對調一次送出順序。
+
+#include "signaldatagram.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t g_running = 1;
+
+void handleSignal(int)
+{
+    g_running = 0;
+}
+
+std::int64_t monotonicUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::int64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void usage(const char *argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--udp host:port | --unix path] [--rate <packets/s>] [--batch <n>]\n"
+                 "          [--duration <seconds>] [--drop-every <n>] [--swap-every <n>]\n",
+                 argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string udp = "127.0.0.1:" + std::to_string(SignalDatagram::DefaultPort);
+    std::string unixPath;
+    double rate = 200.0;
+    int batch = 5;
+    double durationSec = 0.0;
+    long dropEvery = 0;
+    long swapEvery = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--udp") == 0 && hasValue) {
+            udp = argv[++i];
+        } else if (std::strcmp(argv[i], "--unix") == 0 && hasValue) {
+            unixPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+            rate = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--batch") == 0 && hasValue) {
+            batch = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--duration") == 0 && hasValue) {
+            durationSec = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--drop-every") == 0 && hasValue) {
+            dropEvery = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--swap-every") == 0 && hasValue) {
+            swapEvery = std::atol(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    const int signalCount = 4;
+    if (rate <= 0.0 || batch <= 0 || std::size_t(batch * signalCount) > SignalDatagram::MaxEntries) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    int fd = -1;
+    sockaddr_storage target {};
+    socklen_t targetLength = 0;
+    if (!unixPath.empty()) {
+        auto *addr = reinterpret_cast<sockaddr_un *>(&target);
+        if (unixPath.size() >= sizeof(addr->sun_path)) {
+            std::fprintf(stderr, "socket path too long\n");
+            return 2;
+        }
+        addr->sun_family = AF_UNIX;
+        std::memcpy(addr->sun_path, unixPath.c_str(), unixPath.size());
+        targetLength = sizeof(sockaddr_un);
+        fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    } else {
+        const std::size_t colon = udp.rfind(':');
+        auto *addr = reinterpret_cast<sockaddr_in *>(&target);
+        addr->sin_family = AF_INET;
+        addr->sin_port = htons(std::uint16_t(std::atoi(udp.substr(colon + 1).c_str())));
+        if (colon == std::string::npos || inet_pton(AF_INET, udp.substr(0, colon).c_str(), &addr->sin_addr) != 1) {
+            std::fprintf(stderr, "invalid address %s\n", udp.c_str());
+            return 2;
+        }
+        targetLength = sizeof(sockaddr_in);
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+    }
+    if (fd < 0) {
+        std::fprintf(stderr, "socket() failed: %s\n", std::strerror(errno));
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::printf("datagram sender: %s, %.0f packets/s, %d samples per packet\n",
+                unixPath.empty() ? udp.c_str() : unixPath.c_str(), rate, batch * signalCount);
+
+    const std::int64_t periodUs = std::int64_t(1e6 / rate);
+    const std::int64_t sampleStepUs = periodUs / batch;
+    const std::int64_t startUs = monotonicUs();
+    timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    std::vector<char> packet(SignalDatagram::MaxPacketSize);
+    std::vector<char> held;     // --swap-every：暫存一個封包，晚一個週期送出
+    std::uint32_t sequence = 0;
+    std::uint64_t sent = 0, dropped = 0, swapped = 0;
+    double odometerKm = 12345.0;
+
+    while (g_running) {
+        const std::int64_t nowUs = monotonicUs();
+        const double t = double(nowUs - startUs) / 1e6;
+        if (durationSec > 0.0 && t >= durationSec)
+            break;
+
+        SignalDatagram::PacketHeader header {};
+        header.magic = SignalDatagram::Magic;
+        header.version = SignalDatagram::Version;
+        header.count = std::uint16_t(batch * signalCount);
+        header.sequence = sequence++;
+        header.sendTimeUs = nowUs;
+        std::memcpy(packet.data(), &header, sizeof(header));
+
+        // 這個封包涵蓋上一個週期內的 batch 個時間點
+        int n = 0;
+        for (int b = 0; b < batch; ++b) {
+            const std::int32_t offsetUs = -std::int32_t((batch - 1 - b) * sampleStepUs);
+            const double ts = t + offsetUs / 1e6;
+            const double phase = std::fmod(ts, 60.0) / 60.0;
+            const double speed = std::max(0.0, 120.0 * std::sin(phase * M_PI) + 2.0 * std::sin(ts * 7.0));
+            odometerKm += speed / 3600.0 / (rate * batch);
+            const double values[signalCount] = {speed, 900.0 + speed * 45.0, 80.0 - std::fmod(ts / 30.0, 60.0),
+                                                odometerKm};
+            for (int id = 0; id < signalCount; ++id, ++n) {
+                const SignalDatagram::Entry entry {std::uint16_t(id), 0, offsetUs, values[id]};
+                std::memcpy(packet.data() + sizeof(header) + n * sizeof(entry), &entry, sizeof(entry));
+            }
+        }
+        const std::size_t length = sizeof(header) + std::size_t(n) * sizeof(SignalDatagram::Entry);
+
+        if (dropEvery > 0 && header.sequence % dropEvery == dropEvery - 1) {
+            ++dropped;
+        } else if (swapEvery > 0 && held.empty() && header.sequence % swapEvery == swapEvery - 1) {
+            held.assign(packet.begin(), packet.begin() + long(length));
+        } else {
+            if (sendto(fd, packet.data(), length, 0, reinterpret_cast<sockaddr *>(&target), targetLength) >= 0)
+                ++sent;
+            if (!held.empty()) {
+                if (sendto(fd, held.data(), held.size(), 0, reinterpret_cast<sockaddr *>(&target), targetLength) >= 0)
+                    ++swapped;
+                held.clear();
+            }
+        }
+
+        next.tv_nsec += periodUs * 1000;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            ++next.tv_sec;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    }
+
+    close(fd);
+    std::printf("datagram sender: sent %llu packets (%llu reordered), dropped %llu on purpose\n",
+                (unsigned long long)(sent + swapped), (unsigned long long)swapped, (unsigned long long)dropped);
+    return 0;
+}
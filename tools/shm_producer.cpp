@@ -0,0 +1,156 @@
+// 共享記憶體訊號 producer（替代 gateway 行程，用來在任何 Linux 機器上測試 SharedSignalSource）
+//
+// 建立 POSIX shm 區段（格式見 src/sharedsignalformat.h），以固定頻率寫入模擬的行車資料：
+//   speed / rpm / fuelLevel / odometer
+//
+// 用法：
+//   smartdashboard-shm-producer [--name /smart_dashboard_signals] [--rate 500] [--duration 0]
+//   SMART_DASHBOARD_SHM=/smart_dashboard_signals ./appSmartDashboard
+//
+// --duration 0 表示一直執行到 Ctrl+C；結束時會 shm_unlink 區段。
+
+#include "sharedsignalformat.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t g_running = 1;
+
+void handleSignal(int)
+{
+    g_running = 0;
+}
+
+std::int64_t monotonicUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::int64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void usage(const char *argv0)
+{
+    std::fprintf(stderr, "usage: %s [--name <shm name>] [--rate <Hz>] [--duration <seconds>]\n", argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *name = SharedSignals::DefaultName;
+    double rateHz = 500.0;
+    double durationSec = 0.0;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--name") == 0 && hasValue) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+            rateHz = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--duration") == 0 && hasValue) {
+            durationSec = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (name[0] != '/' || rateHz <= 0.0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // 上一次沒有正常結束時可能留下舊區段：先移除再建新的，讀取端會在 2 秒內重新接上
+    shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::fprintf(stderr, "shm_open(%s) failed: %s\n", name, std::strerror(errno));
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(SharedSignals::Segment)) != 0) {
+        std::fprintf(stderr, "ftruncate failed: %s\n", std::strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return 1;
+    }
+    void *mapped = mmap(nullptr, sizeof(SharedSignals::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        std::fprintf(stderr, "mmap failed: %s\n", std::strerror(errno));
+        shm_unlink(name);
+        return 1;
+    }
+
+    // ftruncate 出來的區段已全部清零
+    auto *segment = static_cast<SharedSignals::Segment *>(mapped);
+    SharedSignals::initialize(segment, std::uint32_t(getpid()));
+    const int speedIndex = SharedSignals::registerSignal(segment, "speed");
+    const int rpmIndex = SharedSignals::registerSignal(segment, "rpm");
+    const int fuelIndex = SharedSignals::registerSignal(segment, "fuelLevel");
+    const int odometerIndex = SharedSignals::registerSignal(segment, "odometer");
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::printf("shm producer: %s, %zu bytes, %.0f Hz per signal\n", name, sizeof(SharedSignals::Segment), rateHz);
+
+    const std::int64_t periodNs = std::int64_t(1e9 / rateHz);
+    const std::int64_t startUs = monotonicUs();
+    timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    double odometerKm = 12345.0;
+    std::uint64_t writes = 0;
+    std::int64_t lastReportUs = startUs;
+
+    while (g_running) {
+        const std::int64_t nowUs = monotonicUs();
+        const double t = double(nowUs - startUs) / 1e6;
+        if (durationSec > 0.0 && t >= durationSec)
+            break;
+
+        // 60 秒一個循環的起步 / 巡航 / 減速
+        const double phase = std::fmod(t, 60.0) / 60.0;
+        const double speed = 120.0 * std::sin(phase * M_PI) + 2.0 * std::sin(t * 7.0);
+        const double rpm = 900.0 + speed * 45.0 + 150.0 * std::sin(t * 13.0);
+        const double fuel = 80.0 - std::fmod(t / 30.0, 60.0);
+        odometerKm += std::max(0.0, speed) / 3600.0 / rateHz;
+
+        SharedSignals::write(segment, speedIndex, std::max(0.0, speed), nowUs);
+        SharedSignals::write(segment, rpmIndex, rpm, nowUs);
+        SharedSignals::write(segment, fuelIndex, fuel, nowUs);
+        SharedSignals::write(segment, odometerIndex, odometerKm, nowUs);
+        writes += 4;
+
+        if (nowUs - lastReportUs >= 5000000) {
+            std::printf("shm producer: %llu writes, speed %.1f km/h\n", (unsigned long long)writes, speed);
+            std::fflush(stdout);
+            lastReportUs = nowUs;
+        }
+
+        // 以絕對時間睡眠，避免誤差累積
+        next.tv_nsec += periodNs;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            ++next.tv_sec;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    }
+
+    munmap(mapped, sizeof(SharedSignals::Segment));
+    shm_unlink(name);
+    std::printf("shm producer: stopped after %llu writes\n", (unsigned long long)writes);
+    return 0;
+}
@@ -0,0 +1,569 @@
+// 合成的 Wayland client（替代 Waydroid，用來在任何 Linux 機器 / CI 上測試 compositor 路徑）
+//
+// 連到儀表的 compositor socket，建立 N 個 xdg_toplevel，以 wl_shm buffer 固定頻率（或跟著 frame callback）
+// commit 畫面，結束時印出每個 surface 的 commit / frame callback 統計。
+//
+// 用法：
+//   smartdashboard-wayland-stub [--display wayland-smartdashboard-0] [--surfaces 1] [--rate 60]
+//                               [--width 0] [--height 0] [--damage 100] [--duration 10]
+//                               [--app-id waydroid.com.smartdashboard.stub] [--json <檔案>]
+//
+// --rate 0 表示收到 frame callback 才畫下一幀（一般 app 的行為）；否則以固定頻率 commit，
+//   兩個 buffer 都還被 compositor 拿著時那一幀算 skipped（compositor 跟不上的指標）。
+// --width / --height 0 表示用 compositor configure 的大小（ToplevelConfigurator），沒給時 640x360。
+// --damage 每幀更新的高度百分比（一條往下移動的色帶，其餘不動），測 SurfaceItem 的部分上傳。
+// --app-id 在多個 surface 時後面會加上 .<序號>，surface 依包名分配到 output（見 config.json 的 outputs）。
+// --duration 0 表示一直執行到 Ctrl+C。
+
+#include "xdg-shell-client-protocol.h"
+
+#include <wayland-client.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t g_running = 1;
+
+void handleSignal(int)
+{
+    g_running = 0;
+}
+
+std::int64_t monotonicUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::int64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void usage(const char *argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--display <socket>] [--surfaces <n>] [--rate <Hz, 0 = frame callback>]\n"
+                 "          [--width <px>] [--height <px>] [--damage <percent>] [--duration <seconds>]\n"
+                 "          [--app-id <prefix>] [--json <file>]\n",
+                 argv0);
+}
+
+struct Options {
+    const char *display = "wayland-smartdashboard-0";
+    int surfaces = 1;
+    double rateHz = 60.0;
+    int width = 0;
+    int height = 0;
+    int damagePercent = 100;
+    double durationSec = 10.0;
+    const char *appId = "waydroid.com.smartdashboard.stub";
+    const char *jsonPath = nullptr;
+};
+
+constexpr int DefaultWidth = 640;
+constexpr int DefaultHeight = 360;
+constexpr int BufferCount = 2;
+
+struct Globals {
+    wl_compositor *compositor = nullptr;
+    wl_shm *shm = nullptr;
+    xdg_wm_base *wmBase = nullptr;
+    std::uint32_t compositorVersion = 0;
+};
+
+struct StubSurface;
+
+struct Buffer {
+    StubSurface *owner = nullptr;
+    wl_buffer *buffer = nullptr;
+    std::uint32_t *pixels = nullptr;
+    bool busy = false;
+};
+
+struct StubSurface {
+    const Options *options = nullptr;
+    const Globals *globals = nullptr;
+    int index = 0;
+
+    wl_surface *surface = nullptr;
+    xdg_surface *xdgSurface = nullptr;
+    xdg_toplevel *toplevel = nullptr;
+    wl_callback *frameCallback = nullptr;
+
+    // 兩個 buffer 共用一個 memfd
+    Buffer buffers[BufferCount];
+    void *mapped = nullptr;
+    std::size_t mappedSize = 0;
+    int width = 0;
+    int height = 0;
+    int configuredWidth = 0;
+    int configuredHeight = 0;
+    bool configured = false;
+    bool closed = false;
+    bool waitingForBuffer = false;   // 跟著 frame callback 畫時，下一幀等 buffer release
+
+    std::uint32_t frameNumber = 0;
+    std::uint64_t commits = 0;
+    std::uint64_t skipped = 0;
+    std::uint64_t callbacks = 0;
+    std::uint64_t resizes = 0;
+    std::int64_t lastCallbackUs = 0;
+    std::vector<std::int64_t> callbackIntervalsUs;
+};
+
+void commitFrame(StubSurface *s);
+
+// ---- wl_buffer / wl_callback ----
+
+void handleBufferRelease(void *data, wl_buffer *)
+{
+    auto *b = static_cast<Buffer *>(data);
+    b->busy = false;
+    StubSurface *s = b->owner;
+    if (s && s->waitingForBuffer) {
+        s->waitingForBuffer = false;
+        commitFrame(s);
+    }
+}
+
+const wl_buffer_listener bufferListener = {handleBufferRelease};
+
+void handleFrameDone(void *data, wl_callback *callback, std::uint32_t)
+{
+    auto *s = static_cast<StubSurface *>(data);
+    wl_callback_destroy(callback);
+    s->frameCallback = nullptr;
+    ++s->callbacks;
+    const std::int64_t nowUs = monotonicUs();
+    if (s->lastCallbackUs > 0)
+        s->callbackIntervalsUs.push_back(nowUs - s->lastCallbackUs);
+    s->lastCallbackUs = nowUs;
+
+    // 跟著 frame callback 畫的模式：compositor 要下一幀了
+    if (s->options->rateHz <= 0.0 && g_running)
+        commitFrame(s);
+}
+
+const wl_callback_listener frameListener = {handleFrameDone};
+
+// ---- buffer 配置與繪製 ----
+
+void releaseBuffers(StubSurface *s)
+{
+    for (Buffer &b : s->buffers) {
+        if (b.buffer)
+            wl_buffer_destroy(b.buffer);
+        b = Buffer();
+    }
+    if (s->mapped)
+        munmap(s->mapped, s->mappedSize);
+    s->mapped = nullptr;
+    s->mappedSize = 0;
+}
+
+bool allocateBuffers(StubSurface *s, int width, int height)
+{
+    releaseBuffers(s);
+    const int stride = width * 4;
+    const std::size_t bufferSize = std::size_t(stride) * std::size_t(height);
+    const std::size_t totalSize = bufferSize * BufferCount;
+
+    const int fd = memfd_create("smartdashboard-wayland-stub", MFD_CLOEXEC);
+    if (fd < 0) {
+        std::fprintf(stderr, "memfd_create failed: %s\n", std::strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, off_t(totalSize)) != 0) {
+        std::fprintf(stderr, "ftruncate failed: %s\n", std::strerror(errno));
+        close(fd);
+        return false;
+    }
+    void *mapped = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::fprintf(stderr, "mmap failed: %s\n", std::strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    wl_shm_pool *pool = wl_shm_create_pool(s->globals->shm, fd, std::int32_t(totalSize));
+    for (int i = 0; i < BufferCount; ++i) {
+        Buffer &b = s->buffers[i];
+        b.owner = s;
+        b.buffer = wl_shm_pool_create_buffer(pool, std::int32_t(bufferSize * i), width, height, stride,
+                                             WL_SHM_FORMAT_XRGB8888);
+        b.pixels = reinterpret_cast<std::uint32_t *>(static_cast<char *>(mapped) + bufferSize * i);
+        wl_buffer_add_listener(b.buffer, &bufferListener, &b);
+    }
+    // pool 銷毀後 buffer 仍有效；fd 也交給 compositor 了
+    wl_shm_pool_destroy(pool);
+    close(fd);
+
+    s->mapped = mapped;
+    s->mappedSize = totalSize;
+    s->width = width;
+    s->height = height;
+    ++s->resizes;
+
+    // 新 buffer 先整張填上底色，之後只畫色帶
+    for (Buffer &b : s->buffers)
+        std::fill(b.pixels, b.pixels + std::size_t(width) * height, 0xff202530u);
+    return true;
+}
+
+Buffer *freeBuffer(StubSurface *s)
+{
+    for (Buffer &b : s->buffers) {
+        if (!b.busy)
+            return &b;
+    }
+    return nullptr;
+}
+
+void commitFrame(StubSurface *s)
+{
+    if (!s->configured || s->closed)
+        return;
+    Buffer *b = freeBuffer(s);
+    if (!b) {
+        ++s->skipped;
+        // 沒有 frame callback 在等時，要靠 buffer release 接著畫，否則這個 surface 就停了
+        s->waitingForBuffer = s->options->rateHz <= 0.0;
+        return;
+    }
+
+    // 一條往下移動的色帶。兩個 buffer 交替使用：這個 buffer 裡還是前兩幀的色帶，
+    // 畫面上是前一幀的，所以重畫（也是 damage）的範圍涵蓋這三個位置
+    const int bandHeight = std::max(1, s->height * s->options->damagePercent / 100);
+    const std::uint32_t travel = std::uint32_t(std::max(1, s->height - bandHeight + 1));
+    const auto bandY = [&](std::uint32_t frame) { return int((frame * 7u) % travel); };
+    const int y = bandY(s->frameNumber);
+    int top = y;
+    int bandBottom = y;
+    for (std::uint32_t back = 1; back <= 2 && back <= s->frameNumber; ++back) {
+        top = std::min(top, bandY(s->frameNumber - back));
+        bandBottom = std::max(bandBottom, bandY(s->frameNumber - back));
+    }
+    const int bottom = std::min(s->height, bandBottom + bandHeight);
+    const std::uint32_t hue = (s->frameNumber * 5u + std::uint32_t(s->index) * 60u) & 0xffu;
+    const std::uint32_t bandColor = 0xff000000u | (hue << 16) | ((255u - hue) << 8) | 0x80u;
+
+    for (int row = top; row < bottom; ++row) {
+        std::uint32_t *line = b->pixels + std::size_t(row) * s->width;
+        const bool inBand = row >= y && row < y + bandHeight;
+        std::fill(line, line + s->width, inBand ? bandColor : 0xff202530u);
+    }
+
+    wl_surface_attach(s->surface, b->buffer, 0, 0);
+    if (s->globals->compositorVersion >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION)
+        wl_surface_damage_buffer(s->surface, 0, top, s->width, bottom - top);
+    else
+        wl_surface_damage(s->surface, 0, top, s->width, bottom - top);
+    if (!s->frameCallback) {
+        s->frameCallback = wl_surface_frame(s->surface);
+        wl_callback_add_listener(s->frameCallback, &frameListener, s);
+    }
+    wl_surface_commit(s->surface);
+    b->busy = true;
+    ++s->frameNumber;
+    ++s->commits;
+}
+
+// ---- xdg-shell ----
+
+void handleWmBasePing(void *, xdg_wm_base *wmBase, std::uint32_t serial)
+{
+    xdg_wm_base_pong(wmBase, serial);
+}
+
+const xdg_wm_base_listener wmBaseListener = {handleWmBasePing};
+
+void handleXdgSurfaceConfigure(void *data, xdg_surface *xdgSurface, std::uint32_t serial)
+{
+    auto *s = static_cast<StubSurface *>(data);
+    xdg_surface_ack_configure(xdgSurface, serial);
+
+    // 命令列指定的大小優先，其次是 compositor 要求的大小
+    int width = s->options->width > 0 ? s->options->width : s->configuredWidth;
+    int height = s->options->height > 0 ? s->options->height : s->configuredHeight;
+    if (width <= 0)
+        width = DefaultWidth;
+    if (height <= 0)
+        height = DefaultHeight;
+
+    const bool firstConfigure = !s->configured;
+    const bool resized = width != s->width || height != s->height;
+    if (resized) {
+        if (!allocateBuffers(s, width, height)) {
+            s->closed = true;
+            return;
+        }
+    }
+    s->configured = true;
+    // 第一幀（以及改大小後）一定要 commit，之後才會有 frame callback
+    if (firstConfigure || resized)
+        commitFrame(s);
+}
+
+const xdg_surface_listener xdgSurfaceListener = {handleXdgSurfaceConfigure};
+
+void handleToplevelConfigure(void *data, xdg_toplevel *, std::int32_t width, std::int32_t height, wl_array *)
+{
+    auto *s = static_cast<StubSurface *>(data);
+    s->configuredWidth = width;
+    s->configuredHeight = height;
+}
+
+void handleToplevelClose(void *data, xdg_toplevel *)
+{
+    static_cast<StubSurface *>(data)->closed = true;
+}
+
+// 以 xdg_wm_base 第 1 版綁定，不會收到 configure_bounds / wm_capabilities
+const xdg_toplevel_listener toplevelListener = {handleToplevelConfigure, handleToplevelClose};
+
+void createSurface(StubSurface *s)
+{
+    s->surface = wl_compositor_create_surface(s->globals->compositor);
+    s->xdgSurface = xdg_wm_base_get_xdg_surface(s->globals->wmBase, s->surface);
+    xdg_surface_add_listener(s->xdgSurface, &xdgSurfaceListener, s);
+    s->toplevel = xdg_surface_get_toplevel(s->xdgSurface);
+    xdg_toplevel_add_listener(s->toplevel, &toplevelListener, s);
+
+    // 只有一個 surface 時 app_id 照原樣（scripts/fake-waydroid.sh 以 waydroid.<包名> 開假 app）
+    std::string appId = s->options->appId;
+    if (s->options->surfaces > 1)
+        appId += "." + std::to_string(s->index);
+    const std::string title = "stub " + std::to_string(s->index);
+    xdg_toplevel_set_app_id(s->toplevel, appId.c_str());
+    xdg_toplevel_set_title(s->toplevel, title.c_str());
+    // 沒有 buffer 的 commit：向 compositor 要第一個 configure
+    wl_surface_commit(s->surface);
+}
+
+void destroySurface(StubSurface *s)
+{
+    if (s->frameCallback)
+        wl_callback_destroy(s->frameCallback);
+    if (s->toplevel)
+        xdg_toplevel_destroy(s->toplevel);
+    if (s->xdgSurface)
+        xdg_surface_destroy(s->xdgSurface);
+    if (s->surface)
+        wl_surface_destroy(s->surface);
+    releaseBuffers(s);
+}
+
+// ---- registry ----
+
+void handleGlobal(void *data, wl_registry *registry, std::uint32_t name, const char *interface,
+                  std::uint32_t version)
+{
+    auto *globals = static_cast<Globals *>(data);
+    if (std::strcmp(interface, wl_compositor_interface.name) == 0) {
+        globals->compositorVersion = std::min<std::uint32_t>(version, 4);
+        globals->compositor = static_cast<wl_compositor *>(
+            wl_registry_bind(registry, name, &wl_compositor_interface, globals->compositorVersion));
+    } else if (std::strcmp(interface, wl_shm_interface.name) == 0) {
+        globals->shm = static_cast<wl_shm *>(wl_registry_bind(registry, name, &wl_shm_interface, 1));
+    } else if (std::strcmp(interface, xdg_wm_base_interface.name) == 0) {
+        globals->wmBase = static_cast<xdg_wm_base *>(wl_registry_bind(registry, name, &xdg_wm_base_interface, 1));
+        xdg_wm_base_add_listener(globals->wmBase, &wmBaseListener, globals);
+    }
+}
+
+void handleGlobalRemove(void *, wl_registry *, std::uint32_t)
+{
+}
+
+const wl_registry_listener registryListener = {handleGlobal, handleGlobalRemove};
+
+// ---- 統計 ----
+
+std::int64_t percentileUs(std::vector<std::int64_t> values, double p)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    const std::size_t index = std::min(values.size() - 1, std::size_t(p * double(values.size() - 1) + 0.5));
+    return values[index];
+}
+
+bool writeJson(const char *path, const std::vector<StubSurface> &surfaces, const Options &options, double seconds)
+{
+    std::FILE *file = std::fopen(path, "w");
+    if (!file)
+        return false;
+    std::fprintf(file, "{\n  \"seconds\": %.3f,\n  \"rateHz\": %.1f,\n  \"damagePercent\": %d,\n  \"surfaces\": [\n",
+                 seconds, options.rateHz, options.damagePercent);
+    for (std::size_t i = 0; i < surfaces.size(); ++i) {
+        const StubSurface &s = surfaces[i];
+        std::fprintf(file,
+                     "    {\"index\": %d, \"width\": %d, \"height\": %d, \"commits\": %llu, \"skipped\": %llu, "
+                     "\"callbacks\": %llu, \"resizes\": %llu, \"commitRate\": %.2f, \"callbackRate\": %.2f, "
+                     "\"callbackP50Ms\": %.2f, \"callbackP95Ms\": %.2f, \"callbackMaxMs\": %.2f}%s\n",
+                     s.index, s.width, s.height, (unsigned long long)s.commits, (unsigned long long)s.skipped,
+                     (unsigned long long)s.callbacks, (unsigned long long)s.resizes, double(s.commits) / seconds,
+                     double(s.callbacks) / seconds, percentileUs(s.callbackIntervalsUs, 0.50) / 1000.0,
+                     percentileUs(s.callbackIntervalsUs, 0.95) / 1000.0,
+                     percentileUs(s.callbackIntervalsUs, 1.0) / 1000.0, i + 1 < surfaces.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--display") == 0 && hasValue) {
+            options.display = argv[++i];
+        } else if (std::strcmp(argv[i], "--surfaces") == 0 && hasValue) {
+            options.surfaces = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rateHz = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--width") == 0 && hasValue) {
+            options.width = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--height") == 0 && hasValue) {
+            options.height = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--damage") == 0 && hasValue) {
+            options.damagePercent = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--duration") == 0 && hasValue) {
+            options.durationSec = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--app-id") == 0 && hasValue) {
+            options.appId = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (options.surfaces <= 0 || options.rateHz < 0.0 || options.width < 0 || options.height < 0
+        || options.damagePercent <= 0 || options.damagePercent > 100) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    wl_display *display = wl_display_connect(options.display);
+    if (!display) {
+        std::fprintf(stderr, "cannot connect to %s: %s\n", options.display, std::strerror(errno));
+        return 1;
+    }
+
+    Globals globals;
+    wl_registry *registry = wl_display_get_registry(display);
+    wl_registry_add_listener(registry, &registryListener, &globals);
+    wl_display_roundtrip(display);
+    if (!globals.compositor || !globals.shm || !globals.wmBase) {
+        std::fprintf(stderr, "%s does not provide wl_compositor / wl_shm / xdg_wm_base\n", options.display);
+        wl_display_disconnect(display);
+        return 1;
+    }
+
+    // 建立後位址不能再變（listener 的 data 指向這裡）
+    std::vector<StubSurface> surfaces(std::size_t(options.surfaces));
+    for (int i = 0; i < options.surfaces; ++i) {
+        StubSurface &s = surfaces[std::size_t(i)];
+        s.options = &options;
+        s.globals = &globals;
+        s.index = i;
+        createSurface(&s);
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::printf("wayland stub: %s, %d surface(s), %s, damage %d%%\n", options.display, options.surfaces,
+                options.rateHz > 0.0 ? (std::to_string(int(options.rateHz)) + " Hz").c_str() : "frame callback",
+                options.damagePercent);
+    std::fflush(stdout);
+
+    const std::int64_t startUs = monotonicUs();
+    const std::int64_t periodUs = options.rateHz > 0.0 ? std::int64_t(1e6 / options.rateHz) : 0;
+    std::int64_t nextTickUs = startUs + periodUs;
+    int exitCode = 0;
+
+    while (g_running) {
+        const std::int64_t nowUs = monotonicUs();
+        if (options.durationSec > 0.0 && double(nowUs - startUs) / 1e6 >= options.durationSec)
+            break;
+        if (std::all_of(surfaces.begin(), surfaces.end(), [](const StubSurface &s) { return s.closed; }))
+            break;
+
+        // 固定頻率：所有 surface 同一個節拍 commit（與多個 app 同時畫的情況相同）
+        if (periodUs > 0 && nowUs >= nextTickUs) {
+            for (StubSurface &s : surfaces)
+                commitFrame(&s);
+            nextTickUs += periodUs;
+            if (nextTickUs < nowUs)
+                nextTickUs = nowUs + periodUs;
+        }
+
+        while (wl_display_prepare_read(display) != 0)
+            wl_display_dispatch_pending(display);
+        if (wl_display_flush(display) < 0 && errno != EAGAIN) {
+            wl_display_cancel_read(display);
+            std::fprintf(stderr, "wayland stub: connection lost: %s\n", std::strerror(errno));
+            exitCode = 1;
+            break;
+        }
+
+        int timeoutMs = 100;
+        if (periodUs > 0)
+            timeoutMs = int(std::max<std::int64_t>(0, (nextTickUs - monotonicUs() + 999) / 1000));
+        pollfd pfd = {wl_display_get_fd(display), POLLIN, 0};
+        if (poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN)) {
+            if (wl_display_read_events(display) < 0) {
+                std::fprintf(stderr, "wayland stub: connection lost: %s\n", std::strerror(errno));
+                exitCode = 1;
+                break;
+            }
+        } else {
+            wl_display_cancel_read(display);
+        }
+        if (wl_display_dispatch_pending(display) < 0) {
+            std::fprintf(stderr, "wayland stub: protocol error %d\n", wl_display_get_error(display));
+            exitCode = 1;
+            break;
+        }
+    }
+
+    const double seconds = std::max(1e-3, double(monotonicUs() - startUs) / 1e6);
+    std::printf("wayland stub: %.1f s\n", seconds);
+    std::printf("  %5s %11s %8s %8s %9s %9s %9s\n", "surf", "size", "commit/s", "skipped", "frame/s", "cb p95", "cb max");
+    for (const StubSurface &s : surfaces) {
+        const std::string size = std::to_string(s.width) + "x" + std::to_string(s.height);
+        std::printf("  %5d %11s %8.1f %8llu %9.1f %7.2fms %7.2fms\n", s.index, size.c_str(),
+                    double(s.commits) / seconds, (unsigned long long)s.skipped, double(s.callbacks) / seconds,
+                    percentileUs(s.callbackIntervalsUs, 0.95) / 1000.0,
+                    percentileUs(s.callbackIntervalsUs, 1.0) / 1000.0);
+    }
+    if (options.jsonPath && !writeJson(options.jsonPath, surfaces, options, seconds)) {
+        std::fprintf(stderr, "wayland stub: cannot write %s\n", options.jsonPath);
+        exitCode = 1;
+    }
+
+    for (StubSurface &s : surfaces)
+        destroySurface(&s);
+    xdg_wm_base_destroy(globals.wmBase);
+    wl_shm_destroy(globals.shm);
+    wl_compositor_destroy(globals.compositor);
+    wl_registry_destroy(registry);
+    wl_display_disconnect(display);
+    return exitCode;
+}